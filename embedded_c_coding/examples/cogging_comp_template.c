@@ -0,0 +1,397 @@
+/**
+ * @file cogging_comp_template.c
+ * @brief 齿槽转矩补偿模板文件
+ * @description 以机械角度为索引的i_q前馈表：标定时电机在速度环下低速匀速运行，
+ *              按角度分格累加速度环输出的i_q并求平均，去掉均值（摩擦与负载）后即为齿槽转矩对应的电流；
+ *              运行时电流环每周期一次查表加线性插值，叠加到i_q给定上；
+ *              支持带补偿重复标定以迭代修正残差；定义COGGING_SIM_POSIX后提供主机仿真，对比补偿前后的速度波动
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* ==================== 宏定义 ==================== */
+
+#define COGGING_ANGLE_BITS         14      // 机械角度位数（与ENCODER_RESOLUTION一致）
+#define COGGING_MAP_BITS           10      // 补偿表点数为2^10（每机械转）
+#define COGGING_MAP_SIZE           (1U << COGGING_MAP_BITS)
+#define COGGING_SHIFT              (COGGING_ANGLE_BITS - COGGING_MAP_BITS)
+
+// 快速RAM放置：定义USE_FAST_RAM并在链接脚本中包含fast_ram_sections.ld后，
+// 每周期调用的查表函数放入ITCM/CCM（段宏与fast_ram_template.c一致，启动拷贝见该文件）
+#ifndef FAST_RAM_CODE
+#ifdef USE_FAST_RAM
+#define FAST_RAM_CODE              __attribute__((section(".fast_text")))
+#else
+#define FAST_RAM_CODE
+#endif
+#endif
+
+/*
+ * 表点数须覆盖齿槽周期：每转齿槽周期数为槽数与极数的最小公倍数（12槽14极为84），
+ * 每个齿槽周期不少于8~12个点，线性插值误差约1%
+ */
+
+/* ==================== 类型定义 ==================== */
+
+/**
+ * @brief 齿槽补偿错误码枚举
+ */
+typedef enum {
+    COGGING_OK = 0,                /**< 成功 */
+    COGGING_ERROR_NULL_PTR,        /**< 空指针错误 */
+    COGGING_ERROR_INVALID_PARAM,   /**< 无效参数 */
+    COGGING_ERROR_INCOMPLETE       /**< 标定数据未覆盖整转或样本不足 */
+} cogging_error_t;
+
+/**
+ * @brief 补偿表结构体
+ */
+typedef struct {
+    float map[COGGING_MAP_SIZE + 1];   /**< i_q前馈（A），最后一点等于第一点用于插值回绕 */
+    float gain;                        /**< 补偿增益（0~1，用于渐入或关闭） */
+    bool is_valid;                     /**< 补偿表有效 */
+} cogging_comp_t;
+
+/**
+ * @brief 标定累加器结构体
+ */
+typedef struct {
+    float sum[COGGING_MAP_SIZE];       /**< 各角度点i_q累加 */
+    uint32_t count[COGGING_MAP_SIZE];  /**< 各角度点样本数 */
+    uint32_t samples;                  /**< 总样本数 */
+} cogging_learn_t;
+
+/* ==================== 公共函数实现 ==================== */
+
+/**
+ * @brief 补偿表初始化函数
+ * @param comp 补偿表指针
+ * @return 错误码
+ * @note   初始化后补偿量为0，标定完成后生效
+ */
+cogging_error_t cogging_comp_init(cogging_comp_t *comp) {
+    uint32_t i;
+
+    if (comp == NULL) {
+        return COGGING_ERROR_NULL_PTR;
+    }
+
+    for (i = 0; i <= COGGING_MAP_SIZE; i++) {
+        comp->map[i] = 0.0f;
+    }
+    comp->gain = 1.0f;
+    comp->is_valid = false;
+
+    return COGGING_OK;
+}
+
+/**
+ * @brief 查询i_q前馈（电流环中断中调用）
+ * @param comp 补偿表指针
+ * @param raw  机械角度原始值（0~2^COGGING_ANGLE_BITS-1）
+ * @return i_q前馈（A）
+ * @note   一次查表加线性插值，无分支循环；补偿表无效时返回0
+ */
+FAST_RAM_CODE
+float cogging_comp_lookup(const cogging_comp_t *comp, uint16_t raw) {
+    uint32_t idx;
+    float frac;
+
+    if (!comp->is_valid) {
+        return 0.0f;
+    }
+
+    raw &= (1U << COGGING_ANGLE_BITS) - 1U;
+    idx = (uint32_t)raw >> COGGING_SHIFT;
+    frac = (float)(raw & ((1U << COGGING_SHIFT) - 1U)) * (1.0f / (1U << COGGING_SHIFT));
+
+    return comp->gain * (comp->map[idx] + (comp->map[idx + 1] - comp->map[idx]) * frac);
+}
+
+/**
+ * @brief 清空标定累加器
+ * @param learn 标定累加器指针
+ * @return 错误码
+ */
+cogging_error_t cogging_learn_reset(cogging_learn_t *learn) {
+    uint32_t i;
+
+    if (learn == NULL) {
+        return COGGING_ERROR_NULL_PTR;
+    }
+
+    for (i = 0; i < COGGING_MAP_SIZE; i++) {
+        learn->sum[i] = 0.0f;
+        learn->count[i] = 0;
+    }
+    learn->samples = 0;
+
+    return COGGING_OK;
+}
+
+/**
+ * @brief 记录一个标定样本
+ * @param learn 标定累加器指针
+ * @param raw   机械角度原始值
+ * @param i_q   速度环输出的i_q给定（不含补偿前馈）
+ * @note   在速度环周期中调用；样本计入最近的表点
+ */
+void cogging_learn_sample(cogging_learn_t *learn, uint16_t raw, float i_q) {
+    uint32_t idx;
+
+    idx = (((uint32_t)raw + (1U << (COGGING_SHIFT - 1))) >> COGGING_SHIFT) & (COGGING_MAP_SIZE - 1U);
+    learn->sum[idx] += i_q;
+    learn->count[idx]++;
+    learn->samples++;
+}
+
+/**
+ * @brief 结束标定并更新补偿表
+ * @param learn     标定累加器指针
+ * @param comp      补偿表指针
+ * @param min_count 每个表点要求的最少样本数
+ * @param gain      更新增益（首次标定取1；带补偿重复标定时取0.5~1逐步修正残差）
+ * @return 错误码
+ * @note   各点平均值减去整转均值后累加到补偿表：均值对应摩擦与负载，不属于齿槽转矩；
+ *         补偿已生效时速度环输出只剩残差，累加即迭代修正。
+ *         正反转各标定一次可抵消与方向有关的摩擦波动
+ */
+cogging_error_t cogging_learn_finish(cogging_learn_t *learn, cogging_comp_t *comp,
+                                     uint32_t min_count, float gain) {
+    float mean = 0.0f;
+    float avg;
+    uint32_t i;
+
+    if (learn == NULL || comp == NULL) {
+        return COGGING_ERROR_NULL_PTR;
+    }
+    if (min_count == 0 || gain <= 0.0f || gain > 1.0f) {
+        return COGGING_ERROR_INVALID_PARAM;
+    }
+
+    for (i = 0; i < COGGING_MAP_SIZE; i++) {
+        if (learn->count[i] < min_count) {
+            return COGGING_ERROR_INCOMPLETE;
+        }
+        mean += learn->sum[i] / (float)learn->count[i];
+    }
+    mean /= (float)COGGING_MAP_SIZE;
+
+    for (i = 0; i < COGGING_MAP_SIZE; i++) {
+        avg = learn->sum[i] / (float)learn->count[i];
+        comp->map[i] += gain * (avg - mean);
+    }
+    comp->map[COGGING_MAP_SIZE] = comp->map[0];
+    comp->is_valid = true;
+
+    return COGGING_OK;
+}
+
+/* ==================== 主机仿真 ==================== */
+
+#ifdef COGGING_SIM_POSIX
+
+#include <math.h>
+
+#define COGGING_SIM_DT             50e-6f      // 控制周期（20kHz）
+#define COGGING_SIM_J              1.0e-4f     // 转动惯量（kg·m²）
+#define COGGING_SIM_B              1.0e-4f     // 粘滞摩擦（N·m·s/rad）
+#define COGGING_SIM_COULOMB        0.005f      // 库仑摩擦（N·m）
+#define COGGING_SIM_KT             0.1f        // 转矩常数（N·m/A）
+#define COGGING_SIM_PERIODS        84          // 每转齿槽周期数（12槽14极）
+#define COGGING_SIM_TC1            0.02f       // 齿槽转矩基波幅值（N·m）
+#define COGGING_SIM_TC2            0.006f      // 齿槽转矩二次谐波幅值（N·m）
+#define COGGING_SIM_BW_HZ          30.0f       // 速度环带宽（Hz）
+
+/**
+ * @brief 仿真结果结构体
+ */
+typedef struct {
+    float ripple_off;              /**< 无补偿时速度波动（峰峰值/平均值） */
+    float ripple_on;               /**< 补偿后速度波动（峰峰值/平均值） */
+    float map_error;               /**< 补偿表与真实齿槽电流的最大偏差（A） */
+} cogging_sim_result_t;
+
+/**
+ * @brief 仿真轴状态结构体
+ */
+typedef struct {
+    float theta;                   /**< 机械角度（rad） */
+    float omega;                   /**< 角速度（rad/s） */
+    float integral;                /**< 速度环积分 */
+} cogging_sim_axis_t;
+
+/**
+ * @brief 真实齿槽转矩
+ */
+static float cogging_sim_torque(float theta) {
+    return COGGING_SIM_TC1 * sinf(COGGING_SIM_PERIODS * theta) +
+           COGGING_SIM_TC2 * sinf(2.0f * COGGING_SIM_PERIODS * theta + 0.7f);
+}
+
+/**
+ * @brief 仿真一个控制周期：速度环PI + 理想电流环 + 机械模型
+ * @return 速度环输出的i_q（不含前馈）
+ */
+static float cogging_sim_step(cogging_sim_axis_t *axis, const cogging_comp_t *comp, float omega_ref,
+                              uint16_t *raw_out) {
+    const float kp = COGGING_SIM_J * 6.2831853f * COGGING_SIM_BW_HZ / COGGING_SIM_KT;
+    const float ki = kp * 6.2831853f * (COGGING_SIM_BW_HZ / 5.0f);
+    float theta_wrapped = fmodf(axis->theta, 6.2831853f);
+    uint16_t raw;
+    float err, i_q, torque;
+
+    if (theta_wrapped < 0.0f) {
+        theta_wrapped += 6.2831853f;
+    }
+    raw = (uint16_t)(theta_wrapped * ((1U << COGGING_ANGLE_BITS) / 6.2831853f)) &
+          ((1U << COGGING_ANGLE_BITS) - 1U);
+
+    err = omega_ref - axis->omega;
+    axis->integral += ki * err * COGGING_SIM_DT;
+    i_q = kp * err + axis->integral;
+
+    torque = COGGING_SIM_KT * (i_q + cogging_comp_lookup(comp, raw)) - cogging_sim_torque(axis->theta) -
+             COGGING_SIM_B * axis->omega - ((axis->omega >= 0.0f) ? COGGING_SIM_COULOMB : -COGGING_SIM_COULOMB);
+    axis->omega += torque / COGGING_SIM_J * COGGING_SIM_DT;
+    axis->theta += axis->omega * COGGING_SIM_DT;
+
+    *raw_out = raw;
+    return i_q;
+}
+
+/**
+ * @brief 以给定转速运行并测量速度波动
+ * @return 峰峰值/平均值
+ */
+static float cogging_sim_ripple(const cogging_comp_t *comp, float rps) {
+    cogging_sim_axis_t axis = { 0.0f, 6.2831853f * rps, 0.0f };
+    float omega_ref = 6.2831853f * rps;
+    float w_min = 1e9f, w_max = -1e9f, w_sum = 0.0f;
+    uint32_t settle = (uint32_t)(1.0f / COGGING_SIM_DT);
+    uint32_t n = (uint32_t)(2.0f / COGGING_SIM_DT);
+    uint32_t k;
+    uint16_t raw;
+
+    for (k = 0; k < settle + n; k++) {
+        cogging_sim_step(&axis, comp, omega_ref, &raw);
+        if (k >= settle) {
+            w_min = (axis.omega < w_min) ? axis.omega : w_min;
+            w_max = (axis.omega > w_max) ? axis.omega : w_max;
+            w_sum += axis.omega;
+        }
+    }
+    return (w_max - w_min) / (w_sum / (float)n);
+}
+
+/**
+ * @brief 低速匀速运行一整转并标定
+ * @param direction 1为正转，-1为反转
+ */
+static cogging_error_t cogging_sim_learn(cogging_comp_t *comp, cogging_learn_t *learn, float rps,
+                                         float direction, float gain) {
+    cogging_sim_axis_t axis = { 0.0f, 0.0f, 0.0f };
+    float omega_ref = direction * 6.2831853f * rps;
+    uint32_t settle = (uint32_t)(0.5f / COGGING_SIM_DT);
+    uint32_t n = (uint32_t)(1.0f / rps / COGGING_SIM_DT);
+    uint32_t k;
+    uint16_t raw;
+    float i_q;
+
+    cogging_learn_reset(learn);
+    for (k = 0; k < settle + n; k++) {
+        i_q = cogging_sim_step(&axis, comp, omega_ref, &raw);
+        if (k >= settle) {
+            cogging_learn_sample(learn, raw, i_q);
+        }
+    }
+    return cogging_learn_finish(learn, comp, 1, gain);
+}
+
+/**
+ * @brief 齿槽补偿仿真
+ * @param result 结果输出指针
+ * @return 错误码
+ * @note   1rps（齿槽频率84Hz，高于速度环带宽）下比较补偿前后的速度波动；
+ *         标定在0.05rps下正反转各一次，再带补偿迭代一次
+ */
+cogging_error_t cogging_sim_run(cogging_sim_result_t *result) {
+    static cogging_comp_t comp;
+    static cogging_learn_t learn;
+    cogging_error_t ret;
+    float err, truth;
+    uint32_t i;
+
+    if (result == NULL) {
+        return COGGING_ERROR_NULL_PTR;
+    }
+
+    cogging_comp_init(&comp);
+    result->ripple_off = cogging_sim_ripple(&comp, 1.0f);
+
+    ret = cogging_sim_learn(&comp, &learn, 0.05f, 1.0f, 0.5f);
+    if (ret == COGGING_OK) {
+        ret = cogging_sim_learn(&comp, &learn, 0.05f, -1.0f, 0.5f);
+    }
+    if (ret == COGGING_OK) {
+        ret = cogging_sim_learn(&comp, &learn, 0.05f, 1.0f, 1.0f);
+    }
+    if (ret != COGGING_OK) {
+        return ret;
+    }
+    result->ripple_on = cogging_sim_ripple(&comp, 1.0f);
+
+    result->map_error = 0.0f;
+    for (i = 0; i < COGGING_MAP_SIZE; i++) {
+        truth = cogging_sim_torque(6.2831853f * (float)i / COGGING_MAP_SIZE) / COGGING_SIM_KT;
+        err = fabsf(comp.map[i] - truth);
+        result->map_error = (err > result->map_error) ? err : result->map_error;
+    }
+
+    return COGGING_OK;
+}
+
+#endif /* COGGING_SIM_POSIX */
+
+/* ==================== 使用示例 ==================== */
+
+/*
+ * 使用示例：
+ *
+ * static cogging_comp_t cogging;
+ * static cogging_learn_t cogging_learn;
+ *
+ * // 电流环每周期调用：一次查表加插值
+ * static float cogging_feedforward(uint16_t raw) {
+ *     return cogging_comp_lookup(&cogging, raw);
+ * }
+ *
+ * int main(void) {
+ *     motor_init(&foc_motor);
+ *     cogging_comp_init(&cogging);
+ *     foc_motor.get_iq_feedforward = cogging_feedforward;
+ * }
+ *
+ * // 标定任务：速度模式低速匀速运行（齿槽频率远低于速度环带宽），每个速度环周期采样
+ * void cogging_calib_task(void) {
+ *     motor_cmd_t cmd = { .type = MOTOR_CMD_SET_MODE, .mode = MOTOR_MODE_SPEED };
+ *     cogging_learn_reset(&cogging_learn);
+ *     motor_cmd_post(&foc_motor, APP_TASK_LANE, &cmd);
+ *     cmd = (motor_cmd_t){ .type = MOTOR_CMD_SET_SPEED, .arg0 = 3.0f };   // 约0.05rps
+ *     motor_cmd_post(&foc_motor, APP_TASK_LANE, &cmd);
+ *     while (!one_revolution_done()) {
+ *         // 速度环输出即i_q给定
+ *         cogging_learn_sample(&cogging_learn, foc_motor.encoder.raw, foc_motor.i_q_ref);
+ *         wait_speed_loop_period();
+ *     }
+ *     cogging_learn_finish(&cogging_learn, &cogging, 100, 0.5f);
+ *     // 反转重复一次；再以增益1.0带补偿重复一次修正残差
+ * }
+ *
+ * 主机仿真（Linux）：
+ *   gcc -std=c11 -O2 -DCOGGING_SIM_POSIX cogging_comp_template.c test_main.c -lm
+ *   cogging_sim_result_t r;
+ *   cogging_sim_run(&r);      // r.ripple_off / r.ripple_on 为补偿前后速度峰峰波动
+ */
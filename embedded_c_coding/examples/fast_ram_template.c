@@ -0,0 +1,145 @@
+/**
+ * @file fast_ram_template.c
+ * @brief 快速RAM段启动拷贝模板文件
+ * @description 配合fast_ram_sections.ld使用：在复位处理函数中、调用main之前，
+ *              把.fast_text与.fast_data从FLASH拷贝到ITCM/CCM/DTCM，并清零.fast_bss；
+ *              各驱动通过FAST_RAM_CODE/FAST_RAM_DATA/FAST_RAM_BSS宏把热点代码与数据放入这些段
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* ==================== 宏定义 ==================== */
+
+// 段放置属性：全部驱动共用同一组宏与同一个开关USE_FAST_RAM，未定义时展开为空；
+// 各驱动文件内带有相同的#ifndef保护定义，单独编译时无需本文件，与本文件同编译单元时不重复定义
+#ifndef FAST_RAM_CODE
+#ifdef USE_FAST_RAM
+#define FAST_RAM_CODE              __attribute__((section(".fast_text")))
+#else
+#define FAST_RAM_CODE
+#endif
+#endif
+#ifndef FAST_RAM_DATA
+#ifdef USE_FAST_RAM
+#define FAST_RAM_DATA              __attribute__((section(".fast_data")))
+#else
+#define FAST_RAM_DATA
+#endif
+#endif
+#ifndef FAST_RAM_BSS
+#ifdef USE_FAST_RAM
+#define FAST_RAM_BSS               __attribute__((section(".fast_bss")))
+#else
+#define FAST_RAM_BSS
+#endif
+#endif
+
+/* ==================== 类型定义 ==================== */
+
+/**
+ * @brief 快速RAM段布局结构体
+ */
+typedef struct {
+    uint32_t code_bytes;           /**< .fast_text字节数 */
+    uint32_t data_bytes;           /**< .fast_data字节数 */
+    uint32_t bss_bytes;            /**< .fast_bss字节数 */
+    uintptr_t code_start;          /**< .fast_text运行地址 */
+} fast_ram_layout_t;
+
+/* ==================== 外部符号 ==================== */
+
+// 由fast_ram_sections.ld定义
+extern uint32_t _sfast_text[], _efast_text[], _sifast_text[];
+extern uint32_t _sfast_data[], _efast_data[], _sifast_data[];
+extern uint32_t _sfast_bss[], _efast_bss[];
+
+/* ==================== 静态函数声明 ==================== */
+
+static void fast_ram_copy(volatile uint32_t *dst, uint32_t *end, const uint32_t *src);
+
+/* ==================== 静态函数实现 ==================== */
+
+/**
+ * @brief 按字拷贝一个段
+ * @param dst 运行地址起点
+ * @param end 运行地址终点
+ * @param src 加载地址起点
+ * @note   链接脚本保证段起止按4字节对齐；运行于C库初始化之前，
+ *         目标按volatile访问，防止编译器把循环替换为memcpy调用
+ */
+static void fast_ram_copy(volatile uint32_t *dst, uint32_t *end, const uint32_t *src) {
+    while (dst < (volatile uint32_t *)end) {
+        *dst++ = *src++;
+    }
+}
+
+/* ==================== 公共函数实现 ==================== */
+
+/**
+ * @brief 快速RAM段初始化（启动拷贝）
+ * @note   须在复位处理函数中、.data/.bss初始化之后、main之前调用；
+ *         H7等需先使能ITCM/DTCM时钟（默认已使能），拷贝后执行指令同步屏障
+ */
+void fast_ram_init(void) {
+    volatile uint32_t *p;
+
+    fast_ram_copy(_sfast_text, _efast_text, _sifast_text);
+    fast_ram_copy(_sfast_data, _efast_data, _sifast_data);
+    for (p = _sfast_bss; p < (volatile uint32_t *)_efast_bss; p++) {
+        *p = 0;
+    }
+
+    // 代码被写入RAM后，确保取指看到新内容
+#if defined(__arm__)
+    __asm volatile ("dsb 0xF" ::: "memory");
+    __asm volatile ("isb 0xF" ::: "memory");
+#endif
+}
+
+/**
+ * @brief 获取快速RAM段布局
+ * @param layout 布局输出指针
+ * @return 获取状态，0表示成功，非0表示失败
+ * @note   可在启动日志中打印，确认热点代码确实被放入快速RAM
+ */
+uint8_t fast_ram_get_layout(fast_ram_layout_t *layout) {
+    if (layout == NULL) {
+        return 1;
+    }
+
+    layout->code_bytes = (uint32_t)((uintptr_t)_efast_text - (uintptr_t)_sfast_text);
+    layout->data_bytes = (uint32_t)((uintptr_t)_efast_data - (uintptr_t)_sfast_data);
+    layout->bss_bytes = (uint32_t)((uintptr_t)_efast_bss - (uintptr_t)_sfast_bss);
+    layout->code_start = (uintptr_t)_sfast_text;
+
+    return 0;
+}
+
+/* ==================== 使用示例 ==================== */
+
+/*
+ * 使用示例：
+ *
+ * // startup_stm32xxxx.s 的 Reset_Handler 中，在拷贝.data、清零.bss之后：
+ * //     bl  SystemInit
+ * //     bl  fast_ram_init
+ * //     bl  __libc_init_array
+ * //     bl  main
+ *
+ * // 编译选项：-DUSE_FAST_RAM（电机驱动与电流环中调用的钩子模块同时生效），
+ * // 链接脚本 INCLUDE fast_ram_sections.ld，并生成map文件：-Wl,-Map=build/firmware.map
+ *
+ * int main(void) {
+ *     fast_ram_layout_t layout;
+ *     fast_ram_get_layout(&layout);
+ *     // layout.code_start 应位于ITCM/CCM地址范围内
+ *
+ *     // 分别以定义/不定义USE_FAST_RAM构建，比较 foc_motor.isr_stats.cycles_max
+ * }
+ *
+ * 构建后检查放置（主机）：
+ *   python3 embedded_c_coding/scripts/check_fast_ram_map.py build/firmware.map \
+ *       --code-region ITCMRAM --data-region DTCMRAM
+ */
@@ -7,16 +7,50 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
 #include <math.h>
 
+#ifdef MOTOR_SIM_POSIX
+#include <time.h>
+#endif
+
 /* ==================== 宏定义 ==================== */
 
 #define PWM_FREQUENCY          20000   // PWM频率（Hz）
 #define PWM_RESOLUTION         1000    // PWM分辨率
 #define MAX_CURRENT            10.0    // 最大电流（A）
+#define MOTOR_OC_TRIP_CURRENT  15.0f   // 功率级硬件过流额定（A），高于MAX_CURRENT留出纹波与超调余量
 #define MAX_SPEED              10000   // 最大速度（RPM）
 #define I2C_TIMEOUT_MS         100     // I2C超时时间（毫秒）
 #define SPI_TIMEOUT_MS         50      // SPI超时时间（毫秒）
+#define ENCODER_RESOLUTION     16384   // 磁编码器分辨率（14位）
+#define MOTOR_TWO_PI           6.2831853f  // 2π
+#define MOTOR_SQRT3_INV        0.5773503f  // 1/√3
+#define MOTOR_CMD_LANES        4       // 命令通道数（每个生产者上下文独占一个通道）
+#define MOTOR_CMD_DEPTH        8       // 每个通道的命令深度（2的幂）
+#define MOTOR_CMD_DRAIN_MAX    4       // 电流环每个周期最多处理的命令数
+#define MOTOR_OUTER_LOOP_DIV   10      // 速度/位置环分频（电流环每10个周期执行一次，即2kHz）
+#define MOTOR_BUS_VOLTAGE      24.0f   // 额定母线电压（V）
+#define MOTOR_SIN_TABLE_BITS   8       // 正弦表点数为2^8（每电周期）
+#define MOTOR_SIN_TABLE_SIZE   (1U << MOTOR_SIN_TABLE_BITS)
+
+// 快速RAM放置：定义USE_FAST_RAM并在链接脚本中包含fast_ram_sections.ld后，
+// 电流环路径的代码放入ITCM/CCM，查找表放入DTCM/CCM（段宏与fast_ram_template.c一致，启动拷贝见该文件）
+#ifndef FAST_RAM_CODE
+#ifdef USE_FAST_RAM
+#define FAST_RAM_CODE              __attribute__((section(".fast_text")))
+#else
+#define FAST_RAM_CODE
+#endif
+#endif
+#ifndef FAST_RAM_BSS
+#ifdef USE_FAST_RAM
+#define FAST_RAM_BSS               __attribute__((section(".fast_bss")))
+#else
+#define FAST_RAM_BSS
+#endif
+#endif
 
 /* ==================== 类型定义 ==================== */
 
@@ -61,6 +95,40 @@ typedef struct {
     motor_mode_t control_mode; // 控制模式
 } motor_config_t;
 
+/**
+ * @brief 标定参数结构体
+ * @note  上电标定或参数辨识得到，经参数存储保存后，下次上电直接恢复
+ */
+typedef struct {
+    float adc_offset[3];       // 三相电流采样零偏（ADC计数）
+    uint16_t encoder_offset;   // 编码器零位偏移（原始值）
+    float phase_resistance;    // 相电阻（Ω）
+    float phase_inductance;    // 相电感（H）
+} motor_calib_t;
+
+/**
+ * @brief 参数存储键枚举
+ * @note  值的长度即结构体大小，结构体布局变化后旧记录因长度不符被忽略，回退为默认值
+ */
+typedef enum {
+    MOTOR_PARAM_KEY_CONFIG = 0x10,  // motor_config_t
+    MOTOR_PARAM_KEY_PID_D,          // D轴pid_param_t
+    MOTOR_PARAM_KEY_PID_Q,          // Q轴pid_param_t
+    MOTOR_PARAM_KEY_CALIB           // motor_calib_t
+} motor_param_key_t;
+
+/**
+ * @brief 参数读取函数指针类型
+ * @note  长度与len一致时成功返回0，可由kv_store_t.get包装得到
+ */
+typedef uint8_t (*motor_param_load_fn)(uint16_t key, void *buf, uint16_t len);
+
+/**
+ * @brief 参数保存函数指针类型
+ * @note  成功返回0，可由kv_store_t.set包装得到
+ */
+typedef uint8_t (*motor_param_save_fn)(uint16_t key, const void *data, uint16_t len);
+
 /**
  * @brief 三相电流结构体
  */
@@ -71,43 +139,266 @@ typedef struct {
 } three_phase_current_t;
 
 /**
- * @brief 电机结构体（面向对象封装）
+ * @brief 编码器读取函数指针类型
+ * @note  阻塞读取，可由sensor_t.get_data包装得到，成功返回0
+ */
+typedef uint8_t (*motor_encoder_read_fn)(uint16_t *raw);
+
+/**
+ * @brief 编码器异步启动函数指针类型
+ * @note  启动SPI/I2C DMA传输后立即返回，完成后调用motor_encoder_complete_isr
+ */
+typedef void (*motor_encoder_start_fn)(void);
+
+/**
+ * @brief 编码器结构体
+ * @note  预取模式下由PWM事件启动传输，与电流采样转换并行进行，
+ *        电流环在Park变换前取用结果
+ */
+typedef struct {
+    motor_encoder_read_fn read_blocking;   // 阻塞读取（对比与降级路径）
+    motor_encoder_start_fn start_async;    // 异步启动（预取路径）
+    volatile uint16_t raw;                 // 最近一次原始角度
+    volatile bool is_ready;                // 本周期预取结果已就绪
+    bool is_prefetch;                      // 是否使用预取模式
+    uint16_t offset;                       // 零位偏移（原始值）
+    float angle_elec;                      // 电角度（弧度）
+    uint32_t miss_count;                   // 预取未及时完成次数
+} motor_encoder_t;
+
+/**
+ * @brief 电流环中断统计结构体
+ */
+typedef struct {
+    uint32_t cycles_last;      // 最近一次中断耗时（CPU周期）
+    uint32_t cycles_max;       // 最大中断耗时（CPU周期）
+    uint32_t count;            // 中断执行次数
+} motor_isr_stats_t;
+
+/**
+ * @brief 电机命令类型枚举
+ */
+typedef enum {
+    MOTOR_CMD_SET_CURRENT = 0, // 设置DQ轴电流给定（arg0=i_d，arg1=i_q）
+    MOTOR_CMD_SET_SPEED,       // 设置速度给定（arg0=RPM）
+    MOTOR_CMD_SET_POSITION,    // 设置位置给定（arg0=角度）
+    MOTOR_CMD_SET_MODE         // 切换控制模式（mode）
+} motor_cmd_type_t;
+
+/**
+ * @brief 电机命令结构体
+ */
+typedef struct {
+    motor_cmd_type_t type;     // 命令类型
+    motor_mode_t mode;         // 控制模式（SET_MODE使用）
+    float arg0;                // 参数0
+    float arg1;                // 参数1
+    uint32_t ticket;           // 全局入队序号，由队列填写
+} motor_cmd_t;
+
+/**
+ * @brief 单生产者命令通道结构体
+ */
+typedef struct {
+    motor_cmd_t slots[MOTOR_CMD_DEPTH];    // 命令槽
+    atomic_uint_least32_t head;            // 写位置（生产者更新）
+    atomic_uint_least32_t tail;            // 读位置（控制中断更新）
+} motor_cmd_lane_t;
+
+/**
+ * @brief 命令队列统计结构体
+ */
+typedef struct {
+    atomic_uint_least32_t posted;          // 入队成功次数
+    atomic_uint_least32_t overflows;       // 通道已满被拒绝次数
+    uint32_t applied;                      // 控制中断已执行命令数
+    uint32_t backlog_max;                  // 单周期处理后剩余命令数峰值
+} motor_cmd_stats_t;
+
+/**
+ * @brief 电机命令队列结构体
+ * @note  每个生产者上下文（任务或中断优先级）使用独立的单生产者通道，入队为无等待操作；
+ *        全局序号保证控制中断按入队先后顺序执行跨通道的命令
  */
 typedef struct {
+    motor_cmd_lane_t lanes[MOTOR_CMD_LANES];  // 命令通道
+    atomic_uint_least32_t ticket;             // 全局入队序号
+    motor_cmd_stats_t stats;                  // 统计
+} motor_cmd_queue_t;
+
+/**
+ * @brief 故障类型枚举
+ */
+typedef enum {
+    MOTOR_FAULT_OVERCURRENT = 0,   // 相电流过流
+    MOTOR_FAULT_OVERVOLTAGE,       // 母线过压
+    MOTOR_FAULT_UNDERVOLTAGE,      // 母线欠压
+    MOTOR_FAULT_OVERTEMP,          // 功率级过温
+    MOTOR_FAULT_ANGLE_LOSS,        // 角度丢失（编码器连续读取失败）
+    MOTOR_FAULT_NUM
+} motor_fault_id_t;
+
+/**
+ * @brief 故障等级枚举
+ */
+typedef enum {
+    MOTOR_FAULT_LEVEL_NONE = 0,    // 正常
+    MOTOR_FAULT_LEVEL_WARN,        // 告警，仅上报
+    MOTOR_FAULT_LEVEL_DERATE,      // 降额运行
+    MOTOR_FAULT_LEVEL_TRIP         // 跳闸，关断输出并锁存
+} motor_fault_level_t;
+
+/**
+ * @brief 单项故障配置结构体
+ */
+typedef struct {
+    float threshold[3];        // 告警/降额/跳闸阈值
+    float hysteresis;          // 降级回差
+    float derate_scale;        // 降额时电流上限比例（0.0-1.0）
+    uint16_t filter_count;     // 连续超限周期数达到后升级
+    uint16_t clear_count;      // 连续恢复周期数达到后降级或允许清除锁存
+    bool is_low;               // true表示低于阈值为异常（如欠压）
+} motor_fault_cfg_t;
+
+/**
+ * @brief 单项故障运行状态结构体
+ */
+typedef struct {
+    motor_fault_level_t level; // 当前等级
+    uint16_t up_count;         // 连续超限计数
+    uint16_t down_count;       // 连续恢复计数
+    uint16_t ok_count;         // 连续无异常计数（跳闸后用于判断能否清除）
+    float value;               // 最近一次输入值
+    uint32_t trip_count;       // 跳闸次数
+} motor_fault_state_t;
+
+/**
+ * @brief 故障管理器结构体
+ * @note  评估在电流环中断内完成，每周期固定遍历全部故障项，耗时恒定；
+ *        锁存位与清除请求位为任务与中断共享的原子位图
+ */
+typedef struct {
+    motor_fault_cfg_t cfg[MOTOR_FAULT_NUM];      // 各故障配置
+    motor_fault_state_t state[MOTOR_FAULT_NUM];  // 各故障状态
+    atomic_uint_least32_t latched;               // 已锁存的跳闸故障位图
+    atomic_uint_least32_t clear_request;         // 应用层请求清除的位图
+    uint32_t warn_mask;                          // 处于告警及以上等级的位图
+    uint32_t derate_mask;                        // 处于降额等级的位图
+    float derate_scale;                          // 当前生效的电流上限比例
+    uint16_t angle_miss_streak;                  // 连续角度获取失败次数
+} motor_fault_mgr_t;
+
+/**
+ * @brief 故障状态快照结构体
+ */
+typedef struct {
+    uint32_t latched;                            // 已锁存的跳闸故障位图
+    uint32_t warn_mask;                          // 告警位图
+    uint32_t derate_mask;                        // 降额位图
+    float derate_scale;                          // 电流上限比例
+    motor_fault_level_t level[MOTOR_FAULT_NUM];  // 各故障等级
+    float value[MOTOR_FAULT_NUM];                // 各故障最近输入值
+    uint32_t trip_count[MOTOR_FAULT_NUM];        // 各故障跳闸次数
+} motor_fault_snapshot_t;
+
+typedef struct motor_t motor_t;
+
+/**
+ * @brief 电机结构体（面向对象封装）
+ */
+struct motor_t {
     uint8_t slv_addr;          // 从设备地址（如驱动芯片I2C地址）
     
     // 函数指针成员
     void (*reset)(void);
-    void (*enable)(bool enable);
+    void (*enable)(motor_t *motor, bool enable);
     void (*set_pwm)(float duty_a, float duty_b, float duty_c);
     void (*set_voltage)(float v_alpha, float v_beta);
     void (*set_current)(float i_d, float i_q);
     void (*set_speed)(float speed);
     void (*set_position)(float position);
-    motor_status_t (*get_status)(void);
+    motor_status_t (*get_status)(motor_t *motor);
     three_phase_current_t (*get_current)(void);
+    float (*get_bus_voltage)(void);
+    float (*get_temperature)(void);
     void (*update_pid)(pid_param_t *pid_d, pid_param_t *pid_q);
+    float (*get_iq_feedforward)(uint16_t raw);  // i_q前馈（按机械角度原始值，如齿槽补偿，可为NULL）
+    bool (*limit_dq_ref)(float v_bus, float speed, float *i_d_ref, float *i_q_ref);  // 给定限制（输入本周期母线电压与实测转速，如母线过压限制，返回true表示限制生效，可为NULL）
+    float (*get_current_limit)(float i_d, float i_q);  // 动态电流上限（输入本周期实测DQ电流，如热模型降额，可为NULL）
     
     // 私有成员
     motor_config_t config;    // 电机配置
     pid_param_t pid_d;         // D轴PID参数
     pid_param_t pid_q;         // Q轴PID参数
+    pid_param_t pid_speed;     // 速度环PI参数（输出为i_q给定，A）
+    pid_param_t pid_position;  // 位置环PI参数（输出为速度给定，RPM）
     motor_status_t status;     // 电机状态
-    bool is_initialized;      // 初始化标志
-} motor_t;
+    motor_encoder_t encoder;   // 角度编码器
+    float i_d_ref;             // D轴电流给定
+    float i_q_ref;             // Q轴电流给定（速度/位置模式下由速度环写入）
+    float i_d_integral;        // D轴积分项
+    float i_q_integral;        // Q轴积分项
+    float speed_ref;           // 速度给定（RPM）
+    float position_ref;        // 位置给定（机械角度，度，多圈累计）
+    float speed_meas;          // 实测速度（RPM，每个外环周期更新）
+    float v_bus;               // 本周期母线电压采样（V，故障评估时读取一次）
+    float speed_integral;      // 速度环积分项
+    float position_integral;   // 位置环积分项
+    int32_t position_counts;   // 多圈位置（编码器计数）
+    int32_t outer_delta;       // 本外环周期累计的编码器增量
+    uint16_t outer_raw_prev;   // 上一电流环周期的编码器原始值
+    uint8_t outer_div;         // 外环分频计数
+    bool is_outer_synced;      // 已记录编码器初值，可计算增量
+    bool is_iq_limited;        // 本外环周期内i_q给定曾被限制（钩子或矢量限幅），速度环暂停积分
+    motor_cmd_queue_t cmd_queue;  // 应用到控制中断的命令队列
+    motor_isr_stats_t isr_stats;  // 电流环中断统计
+    motor_fault_mgr_t fault;   // 故障管理器
+    motor_calib_t calib;       // 标定参数
+    bool is_calibrated;        // 标定参数有效（已从存储恢复或已完成标定）
+    atomic_bool is_enabled;    // 输出已使能（任务写、电流环中断读写，跳闸时清除）
+    atomic_bool is_initialized;  // 初始化标志（任务写、电流环中断读）
+};
 
 /* ==================== 静态函数声明 ==================== */
 
 static void motor_reset(void);
-static void motor_enable(bool enable);
+static void motor_enable(motor_t *motor, bool enable);
 static void motor_set_pwm(float duty_a, float duty_b, float duty_c);
 static void motor_set_voltage(float v_alpha, float v_beta);
 static void motor_set_current(float i_d, float i_q);
 static void motor_set_speed(float speed);
 static void motor_set_position(float position);
-static motor_status_t motor_get_status(void);
+static motor_status_t motor_get_status(motor_t *motor);
 static three_phase_current_t motor_get_current(void);
+static float motor_get_bus_voltage(void);
+static float motor_get_temperature(void);
 static void motor_update_pid(pid_param_t *pid_d, pid_param_t *pid_q);
+static uint32_t motor_get_cycles(void);
+static float motor_pi_update(const pid_param_t *pid, float *integral, float error, bool is_hold);
+static void motor_cmd_apply(motor_t *motor, const motor_cmd_t *cmd);
+static void motor_cmd_drain(motor_t *motor);
+static void motor_outer_loop(motor_t *motor, uint16_t raw, bool is_angle_ok, bool is_active);
+static bool motor_fault_exceeds(const motor_fault_cfg_t *cfg, float value, uint8_t level,
+                                float margin);
+static void motor_fault_update(motor_t *motor, motor_fault_id_t id, float value);
+static bool motor_fault_evaluate(motor_t *motor, const three_phase_current_t *i_abc,
+                                 bool is_angle_ok);
+static void motor_sincos_init(void);
+static void motor_sincos(uint16_t angle, float *sin_out, float *cos_out);
+static bool motor_pid_param_valid(const pid_param_t *pid);
+static bool motor_config_valid(const motor_config_t *config);
+static bool motor_calib_valid(const motor_calib_t *calib);
+static void motor_param_restore(motor_t *motor);
+
+/* ==================== 静态变量 ==================== */
+
+// 正弦表，多出四分之一周期用于直接查余弦，最后一点用于插值
+FAST_RAM_BSS
+static float motor_sin_table[MOTOR_SIN_TABLE_SIZE + MOTOR_SIN_TABLE_SIZE / 4 + 1];
+
+// 参数存储钩子，未设置时每次上电使用默认值
+static motor_param_load_fn motor_param_load = NULL;
+static motor_param_save_fn motor_param_save_hook = NULL;
 
 /* ==================== 静态函数实现 ==================== */
 
@@ -123,11 +414,23 @@ static void motor_reset(void) {
 
 /**
  * @brief 电机使能函数
+ * @param motor  电机结构体指针
  * @param enable true使能，false失能
+ * @note   使能后状态为RUNNING，失能后为IDLE；跳闸锁存期间拒绝使能，状态保持FAULT，
+ *         须先经motor_fault_clear清除锁存
  */
-static void motor_enable(bool enable) {
+static void motor_enable(motor_t *motor, bool enable) {
+    if (motor == NULL) {
+        return;
+    }
+    if (enable && atomic_load_explicit(&motor->fault.latched, memory_order_relaxed) != 0) {
+        return;
+    }
+
     // 设置驱动芯片使能引脚
     // 配置PWM输出
+    atomic_store(&motor->is_enabled, enable);
+    motor->status = enable ? MOTOR_STATUS_RUNNING : MOTOR_STATUS_IDLE;
 }
 
 /**
@@ -136,6 +439,7 @@ static void motor_enable(bool enable) {
  * @param duty_b B相占空比（0.0-1.0）
  * @param duty_c C相占空比（0.0-1.0）
  */
+FAST_RAM_CODE
 static void motor_set_pwm(float duty_a, float duty_b, float duty_c) {
     // 限制占空比范围
     if (duty_a < 0.0f) duty_a = 0.0f;
@@ -154,6 +458,7 @@ static void motor_set_pwm(float duty_a, float duty_b, float duty_c) {
  * @param v_alpha Alpha轴电压
  * @param v_beta Beta轴电压
  */
+FAST_RAM_CODE
 static void motor_set_voltage(float v_alpha, float v_beta) {
     // Clarke逆变换
     float duty_a = v_alpha;
@@ -210,18 +515,21 @@ static void motor_set_position(float position) {
 
 /**
  * @brief 获取电机状态
- * @return 电机状态
+ * @param motor 电机结构体指针
+ * @return 电机状态（由电流环中断内的故障评估维护：FAULT为跳闸锁存，ERROR为降额运行）
  */
-static motor_status_t motor_get_status(void) {
-    // 读取驱动芯片状态寄存器
-    // 检查故障标志
-    return MOTOR_STATUS_IDLE;
+static motor_status_t motor_get_status(motor_t *motor) {
+    if (motor == NULL) {
+        return MOTOR_STATUS_ERROR;
+    }
+    return motor->status;
 }
 
 /**
  * @brief 获取三相电流
  * @return 三相电流结构体
  */
+FAST_RAM_CODE
 static three_phase_current_t motor_get_current(void) {
     three_phase_current_t current;
     
@@ -234,6 +542,26 @@ static three_phase_current_t motor_get_current(void) {
     return current;
 }
 
+/**
+ * @brief 获取母线电压
+ * @return 母线电压（V）
+ */
+FAST_RAM_CODE
+static float motor_get_bus_voltage(void) {
+    // 读取母线电压ADC注入通道并换算
+    return MOTOR_BUS_VOLTAGE;
+}
+
+/**
+ * @brief 获取功率级温度
+ * @return 温度（摄氏度）
+ */
+FAST_RAM_CODE
+static float motor_get_temperature(void) {
+    // 读取NTC采样值并查表换算
+    return 25.0f;
+}
+
 /**
  * @brief 更新PID参数
  * @param pid_d D轴PID参数指针
@@ -244,8 +572,726 @@ static void motor_update_pid(pid_param_t *pid_d, pid_param_t *pid_q) {
     // 这里省略具体实现
 }
 
+/**
+ * @brief 读取CPU周期计数器
+ * @return 当前周期计数
+ * @note   Cortex-M可使用DWT->CYCCNT；主机仿真下以纳秒计
+ */
+FAST_RAM_CODE
+static uint32_t motor_get_cycles(void) {
+#ifdef MOTOR_SIM_POSIX
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
+#else
+    // 这里省略具体的周期计数器读取代码
+    return 0;
+#endif
+}
+
+/**
+ * @brief PI调节器单步计算
+ * @param pid      PID参数指针
+ * @param integral 积分项指针
+ * @param error    误差
+ * @param is_hold  true表示下游限幅生效，本次保持积分不变（抗积分饱和）
+ * @return 调节器输出（已限幅）
+ */
+FAST_RAM_CODE
+static float motor_pi_update(const pid_param_t *pid, float *integral, float error, bool is_hold) {
+    float out;
+
+    if (!is_hold) {
+        *integral += pid->ki * error;
+    }
+    if (*integral > pid->integral_limit) *integral = pid->integral_limit;
+    if (*integral < -pid->integral_limit) *integral = -pid->integral_limit;
+
+    out = pid->kp * error + *integral;
+    if (out > pid->output_limit) out = pid->output_limit;
+    if (out < -pid->output_limit) out = -pid->output_limit;
+
+    return out;
+}
+
+/**
+ * @brief 速度/位置外环（在电流环中断中每周期调用）
+ * @param motor       电机结构体指针
+ * @param raw         本周期编码器原始值
+ * @param is_angle_ok 本周期角度是否有效
+ * @param is_active   输出已使能且未跳闸，false时只跟踪位置与速度，不执行调节
+ * @note   每周期累计编码器增量（按分辨率取模处理过零），每MOTOR_OUTER_LOOP_DIV个周期
+ *         由累计增量求速度并执行一次外环：位置模式下位置环输出速度给定，
+ *         速度模式下直接使用speed_ref；速度环输出写入i_q_ref，电流模式下不执行；
+ *         输出关断期间不调节，避免外环积分在无输出时累积
+ */
+FAST_RAM_CODE
+static void motor_outer_loop(motor_t *motor, uint16_t raw, bool is_angle_ok, bool is_active) {
+    const float rpm_per_count = 60.0f * PWM_FREQUENCY / MOTOR_OUTER_LOOP_DIV / ENCODER_RESOLUTION;
+    float speed_cmd, position_deg;
+    int32_t delta;
+    bool is_hold;
+
+    if (!is_angle_ok) {
+        return;
+    }
+    if (!motor->is_outer_synced) {
+        motor->outer_raw_prev = raw;
+        motor->is_outer_synced = true;
+        return;
+    }
+
+    delta = (int32_t)((uint16_t)(raw - motor->outer_raw_prev) & (ENCODER_RESOLUTION - 1U));
+    if (delta >= (int32_t)(ENCODER_RESOLUTION / 2U)) {
+        delta -= (int32_t)ENCODER_RESOLUTION;
+    }
+    motor->outer_raw_prev = raw;
+    motor->outer_delta += delta;
+    motor->position_counts += delta;
+
+    if (++motor->outer_div < MOTOR_OUTER_LOOP_DIV) {
+        return;
+    }
+    motor->outer_div = 0;
+    motor->speed_meas = (float)motor->outer_delta * rpm_per_count;
+    motor->outer_delta = 0;
+    is_hold = motor->is_iq_limited;
+    motor->is_iq_limited = false;
+
+    if (!is_active) {
+        return;
+    }
+    if (motor->config.control_mode == MOTOR_MODE_POSITION) {
+        position_deg = (float)motor->position_counts * (360.0f / ENCODER_RESOLUTION);
+        speed_cmd = motor_pi_update(&motor->pid_position, &motor->position_integral,
+                                    motor->position_ref - position_deg, false);
+    } else if (motor->config.control_mode == MOTOR_MODE_SPEED) {
+        speed_cmd = motor->speed_ref;
+    } else {
+        return;
+    }
+
+    if (speed_cmd > motor->config.max_speed) speed_cmd = motor->config.max_speed;
+    if (speed_cmd < -motor->config.max_speed) speed_cmd = -motor->config.max_speed;
+    // i_q给定在电流环中被限制时速度环暂停积分，避免限制解除后超调
+    motor->i_q_ref = motor_pi_update(&motor->pid_speed, &motor->speed_integral,
+                                     speed_cmd - motor->speed_meas, is_hold);
+}
+
+/**
+ * @brief 在控制中断中执行一条命令
+ * @param motor 电机结构体指针
+ * @param cmd   命令指针
+ */
+FAST_RAM_CODE
+static void motor_cmd_apply(motor_t *motor, const motor_cmd_t *cmd) {
+    switch (cmd->type) {
+    case MOTOR_CMD_SET_CURRENT:
+        motor->i_d_ref = cmd->arg0;
+        motor->i_q_ref = cmd->arg1;
+        break;
+    case MOTOR_CMD_SET_SPEED:
+        motor->speed_ref = cmd->arg0;
+        break;
+    case MOTOR_CMD_SET_POSITION:
+        motor->position_ref = cmd->arg0;
+        break;
+    case MOTOR_CMD_SET_MODE:
+        // 切换模式时清外环积分，新模式从当前状态无扰启动
+        motor->config.control_mode = cmd->mode;
+        motor->speed_integral = 0.0f;
+        motor->position_integral = 0.0f;
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief 处理命令队列
+ * @param motor 电机结构体指针
+ * @note   每周期最多处理MOTOR_CMD_DRAIN_MAX条命令，耗时有界；
+ *         同一通道严格先进先出，跨通道时每次选取队首序号最小的命令，
+ *         即按入队先后执行本周期可见的全部命令
+ */
+FAST_RAM_CODE
+static void motor_cmd_drain(motor_t *motor) {
+    motor_cmd_queue_t *q = &motor->cmd_queue;
+    motor_cmd_lane_t *lane;
+    motor_cmd_lane_t *best;
+    uint32_t head[MOTOR_CMD_LANES];
+    uint32_t tail;
+    uint32_t best_tail;
+    uint32_t backlog;
+    uint8_t n;
+    uint8_t i;
+
+    for (i = 0; i < MOTOR_CMD_LANES; i++) {
+        head[i] = atomic_load_explicit(&q->lanes[i].head, memory_order_acquire);
+    }
+
+    for (n = 0; n < MOTOR_CMD_DRAIN_MAX; n++) {
+        best = NULL;
+        best_tail = 0;
+        for (i = 0; i < MOTOR_CMD_LANES; i++) {
+            lane = &q->lanes[i];
+            tail = atomic_load_explicit(&lane->tail, memory_order_relaxed);
+            if (tail == head[i]) {
+                continue;
+            }
+            if (best == NULL ||
+                (int32_t)(lane->slots[tail & (MOTOR_CMD_DEPTH - 1)].ticket -
+                          best->slots[best_tail & (MOTOR_CMD_DEPTH - 1)].ticket) < 0) {
+                best = lane;
+                best_tail = tail;
+            }
+        }
+        if (best == NULL) {
+            break;
+        }
+
+        motor_cmd_apply(motor, &best->slots[best_tail & (MOTOR_CMD_DEPTH - 1)]);
+        atomic_store_explicit(&best->tail, best_tail + 1U, memory_order_release);
+        q->stats.applied++;
+    }
+
+    // 记录未处理完的积压数量
+    backlog = 0;
+    for (i = 0; i < MOTOR_CMD_LANES; i++) {
+        backlog += head[i] - atomic_load_explicit(&q->lanes[i].tail, memory_order_relaxed);
+    }
+    if (backlog > q->stats.backlog_max) {
+        q->stats.backlog_max = backlog;
+    }
+}
+
+/**
+ * @brief 生成正弦查找表
+ * @note   电机初始化时调用一次，表放在快速RAM中，无需启动拷贝
+ */
+static void motor_sincos_init(void) {
+    uint16_t i;
+
+    for (i = 0; i < sizeof(motor_sin_table) / sizeof(motor_sin_table[0]); i++) {
+        motor_sin_table[i] = sinf((float)i * (MOTOR_TWO_PI / MOTOR_SIN_TABLE_SIZE));
+    }
+}
+
+/**
+ * @brief 查表计算正余弦
+ * @param angle   电角度（编码器计数，0~ENCODER_RESOLUTION-1对应一个电周期）
+ * @param sin_out 正弦输出指针
+ * @param cos_out 余弦输出指针
+ * @note   线性插值，256点时最大误差约1e-4；余弦为正弦表偏移四分之一周期
+ */
+FAST_RAM_CODE
+static void motor_sincos(uint16_t angle, float *sin_out, float *cos_out) {
+    const uint8_t shift = 14 - MOTOR_SIN_TABLE_BITS;   // ENCODER_RESOLUTION为2^14
+    uint16_t idx = (uint16_t)(angle >> shift);
+    float frac = (float)(angle & ((1U << shift) - 1U)) * (1.0f / (float)(1U << shift));
+    const float *s = &motor_sin_table[idx];
+    const float *c = &motor_sin_table[idx + MOTOR_SIN_TABLE_SIZE / 4];
+
+    *sin_out = s[0] + (s[1] - s[0]) * frac;
+    *cos_out = c[0] + (c[1] - c[0]) * frac;
+}
+
+/**
+ * @brief 判断输入值是否达到指定等级
+ * @param cfg    故障配置指针
+ * @param value  输入值
+ * @param level  等级（WARN~TRIP）
+ * @param margin 回差，保持当前等级时使用
+ * @return true表示达到该等级
+ */
+FAST_RAM_CODE
+static bool motor_fault_exceeds(const motor_fault_cfg_t *cfg, float value, uint8_t level,
+                                float margin) {
+    float th = cfg->threshold[level - MOTOR_FAULT_LEVEL_WARN];
+
+    return cfg->is_low ? (value < th + margin) : (value > th - margin);
+}
+
+/**
+ * @brief 单项故障等级更新
+ * @param motor 电机结构体指针
+ * @param id    故障类型
+ * @param value 本周期输入值
+ * @note   升级需连续filter_count个周期超限，降级需连续clear_count个周期恢复，
+ *         且不低于当前等级阈值减回差；跳闸等级只能由清除请求解除
+ */
+FAST_RAM_CODE
+static void motor_fault_update(motor_t *motor, motor_fault_id_t id, float value) {
+    const motor_fault_cfg_t *cfg = &motor->fault.cfg[id];
+    motor_fault_state_t *st = &motor->fault.state[id];
+    uint8_t target = MOTOR_FAULT_LEVEL_NONE;
+    uint8_t lv;
+
+    st->value = value;
+    for (lv = MOTOR_FAULT_LEVEL_WARN; lv <= MOTOR_FAULT_LEVEL_TRIP; lv++) {
+        if (motor_fault_exceeds(cfg, value, lv, (lv <= st->level) ? cfg->hysteresis : 0.0f)) {
+            target = lv;
+        }
+    }
+
+    if (target == MOTOR_FAULT_LEVEL_NONE) {
+        if (st->ok_count < UINT16_MAX) {
+            st->ok_count++;
+        }
+    } else {
+        st->ok_count = 0;
+    }
+
+    if (target > st->level) {
+        st->down_count = 0;
+        if (++st->up_count >= cfg->filter_count) {
+            st->up_count = 0;
+            st->level = (motor_fault_level_t)target;
+            if (target == MOTOR_FAULT_LEVEL_TRIP) {
+                st->trip_count++;
+                atomic_fetch_or_explicit(&motor->fault.latched, 1UL << id, memory_order_relaxed);
+            }
+        }
+    } else if (target < st->level && st->level != MOTOR_FAULT_LEVEL_TRIP) {
+        st->up_count = 0;
+        if (++st->down_count >= cfg->clear_count) {
+            st->down_count = 0;
+            st->level = (motor_fault_level_t)target;
+        }
+    } else {
+        st->up_count = 0;
+        st->down_count = 0;
+    }
+}
+
+/**
+ * @brief 故障评估（电流环中断内调用）
+ * @param motor       电机结构体指针
+ * @param i_abc       本周期相电流
+ * @param is_angle_ok 本周期是否获得有效角度
+ * @return true表示存在锁存的跳闸故障，本周期不得输出
+ * @note   固定评估全部故障项并处理清除请求，无分支提前退出，耗时恒定
+ */
+FAST_RAM_CODE
+static bool motor_fault_evaluate(motor_t *motor, const three_phase_current_t *i_abc,
+                                 bool is_angle_ok) {
+    motor_fault_mgr_t *fm = &motor->fault;
+    uint32_t latched_before = atomic_load_explicit(&fm->latched, memory_order_relaxed);
+    uint32_t request;
+    uint32_t latched;
+    float i_peak = fabsf(i_abc->ia);
+    float v_bus = motor->get_bus_voltage();
+    uint8_t i;
+
+    motor->v_bus = v_bus;
+
+    if (fabsf(i_abc->ib) > i_peak) i_peak = fabsf(i_abc->ib);
+    if (fabsf(i_abc->ic) > i_peak) i_peak = fabsf(i_abc->ic);
+
+    if (is_angle_ok) {
+        fm->angle_miss_streak = 0;
+    } else if (fm->angle_miss_streak < UINT16_MAX) {
+        fm->angle_miss_streak++;
+    }
+
+    motor_fault_update(motor, MOTOR_FAULT_OVERCURRENT, i_peak);
+    motor_fault_update(motor, MOTOR_FAULT_OVERVOLTAGE, v_bus);
+    motor_fault_update(motor, MOTOR_FAULT_UNDERVOLTAGE, v_bus);
+    motor_fault_update(motor, MOTOR_FAULT_OVERTEMP, motor->get_temperature());
+    motor_fault_update(motor, MOTOR_FAULT_ANGLE_LOSS, (float)fm->angle_miss_streak);
+
+    // 处理清除请求：仅当故障条件已持续消失clear_count个周期才解除锁存
+    request = atomic_exchange_explicit(&fm->clear_request, 0, memory_order_acquire);
+    for (i = 0; i < MOTOR_FAULT_NUM; i++) {
+        if ((request & (1UL << i)) != 0 && fm->state[i].level == MOTOR_FAULT_LEVEL_TRIP &&
+            fm->state[i].ok_count >= fm->cfg[i].clear_count) {
+            fm->state[i].level = MOTOR_FAULT_LEVEL_NONE;
+            fm->state[i].up_count = 0;
+            fm->state[i].down_count = 0;
+            atomic_fetch_and_explicit(&fm->latched, ~(1UL << i), memory_order_relaxed);
+        }
+    }
+
+    // 汇总告警与降额
+    fm->warn_mask = 0;
+    fm->derate_mask = 0;
+    fm->derate_scale = 1.0f;
+    for (i = 0; i < MOTOR_FAULT_NUM; i++) {
+        if (fm->state[i].level >= MOTOR_FAULT_LEVEL_WARN) {
+            fm->warn_mask |= 1UL << i;
+        }
+        if (fm->state[i].level == MOTOR_FAULT_LEVEL_DERATE) {
+            fm->derate_mask |= 1UL << i;
+            if (fm->cfg[i].derate_scale < fm->derate_scale) {
+                fm->derate_scale = fm->cfg[i].derate_scale;
+            }
+        }
+    }
+
+    latched = atomic_load_explicit(&fm->latched, memory_order_relaxed);
+    if (latched != 0) {
+        if (latched_before == 0) {
+            // 新发生跳闸：关断输出并清除调节器状态，电机对象保持有效
+            motor->enable(motor, false);
+            motor->i_d_integral = 0.0f;
+            motor->i_q_integral = 0.0f;
+            motor->speed_integral = 0.0f;
+            motor->position_integral = 0.0f;
+        }
+        motor->status = MOTOR_STATUS_FAULT;
+        return true;
+    }
+
+    if (latched_before != 0) {
+        // 锁存刚被清除：外环积分从零开始，重新使能后无扰启动
+        motor->speed_integral = 0.0f;
+        motor->position_integral = 0.0f;
+    }
+
+    // 降额结束后回到降额前的状态；锁存刚被清除时输出仍为失能，回到IDLE等待应用层重新使能
+    if (fm->derate_mask != 0) {
+        motor->status = MOTOR_STATUS_ERROR;
+    } else {
+        motor->status = atomic_load(&motor->is_enabled) ? MOTOR_STATUS_RUNNING : MOTOR_STATUS_IDLE;
+    }
+
+    return false;
+}
+
+/**
+ * @brief 检查从存储读出的PID参数是否可用
+ * @param pid PID参数指针
+ * @return true表示增益非负且有限、限幅为正
+ */
+static bool motor_pid_param_valid(const pid_param_t *pid) {
+    return isfinite(pid->kp) && isfinite(pid->ki) && isfinite(pid->kd) &&
+           isfinite(pid->integral_limit) && isfinite(pid->output_limit) &&
+           pid->kp >= 0.0f && pid->ki >= 0.0f && pid->kd >= 0.0f &&
+           pid->integral_limit > 0.0f && pid->output_limit > 0.0f;
+}
+
+/**
+ * @brief 检查从存储读出的电机配置是否可用
+ * @param config 电机配置指针
+ * @return true表示极对数非零、电流与速度上限有限且为正、控制模式在枚举范围内
+ */
+static bool motor_config_valid(const motor_config_t *config) {
+    return config->pole_pairs != 0 &&
+           isfinite(config->max_current) && isfinite(config->max_speed) &&
+           config->max_current > 0.0f && config->max_speed > 0.0f &&
+           (uint32_t)config->control_mode <= (uint32_t)MOTOR_MODE_POSITION;
+}
+
+/**
+ * @brief 检查从存储读出的标定参数是否可用
+ * @param calib 标定参数指针
+ * @return true表示编码器零位在分辨率范围内、电流采样零偏有限、相电阻与相电感有限且非负
+ */
+static bool motor_calib_valid(const motor_calib_t *calib) {
+    return calib->encoder_offset < ENCODER_RESOLUTION &&
+           isfinite(calib->adc_offset[0]) && isfinite(calib->adc_offset[1]) &&
+           isfinite(calib->adc_offset[2]) &&
+           isfinite(calib->phase_resistance) && isfinite(calib->phase_inductance) &&
+           calib->phase_resistance >= 0.0f && calib->phase_inductance >= 0.0f;
+}
+
+/**
+ * @brief 从参数存储恢复配置、PID增益与标定参数
+ * @param motor 电机结构体指针
+ * @note   逐项读取并校验，读取失败或校验不通过的项保留默认值；标定参数恢复成功时置位is_calibrated，
+ *         应用层据此跳过上电标定
+ */
+static void motor_param_restore(motor_t *motor) {
+    motor_config_t config;
+    pid_param_t pid;
+    motor_calib_t calib;
+
+    if (motor_param_load == NULL) {
+        return;
+    }
+
+    if (motor_param_load(MOTOR_PARAM_KEY_CONFIG, &config, sizeof(config)) == 0 &&
+        motor_config_valid(&config)) {
+        motor->config = config;
+    }
+    // PID增益先读入局部变量，校验通过后才替换当前值，读取失败或数据异常时保留默认增益
+    if (motor_param_load(MOTOR_PARAM_KEY_PID_D, &pid, sizeof(pid)) == 0 &&
+        motor_pid_param_valid(&pid)) {
+        motor->pid_d = pid;
+    }
+    if (motor_param_load(MOTOR_PARAM_KEY_PID_Q, &pid, sizeof(pid)) == 0 &&
+        motor_pid_param_valid(&pid)) {
+        motor->pid_q = pid;
+    }
+
+    if (motor_param_load(MOTOR_PARAM_KEY_CALIB, &calib, sizeof(calib)) == 0 &&
+        motor_calib_valid(&calib)) {
+        motor->calib = calib;
+        motor->encoder.offset = calib.encoder_offset;
+        motor->is_calibrated = true;
+    }
+}
+
 /* ==================== 公共函数实现 ==================== */
 
+/**
+ * @brief 设置参数存储钩子
+ * @param load 读取钩子
+ * @param save 保存钩子
+ * @note   须在motor_init之前调用，motor_init在加载默认值后从存储恢复
+ */
+void motor_set_param_store(motor_param_load_fn load, motor_param_save_fn save) {
+    motor_param_load = load;
+    motor_param_save_hook = save;
+}
+
+/**
+ * @brief 保存配置、PID增益与标定参数
+ * @param motor 电机结构体指针
+ * @return 保存状态，0表示成功，非0表示失败
+ * @note   在标定完成或整定结束后于任务上下文调用（涉及Flash编程，不可在中断中调用）；
+ *         编码器零位取自encoder.offset，未标定时不保存标定参数
+ */
+uint8_t motor_param_save(motor_t *motor) {
+    uint8_t ret = 0;
+
+    if (motor == NULL || motor_param_save_hook == NULL) {
+        return 1;
+    }
+
+    ret |= motor_param_save_hook(MOTOR_PARAM_KEY_CONFIG, &motor->config, sizeof(motor->config));
+    ret |= motor_param_save_hook(MOTOR_PARAM_KEY_PID_D, &motor->pid_d, sizeof(motor->pid_d));
+    ret |= motor_param_save_hook(MOTOR_PARAM_KEY_PID_Q, &motor->pid_q, sizeof(motor->pid_q));
+
+    if (motor->is_calibrated) {
+        motor->calib.encoder_offset = motor->encoder.offset;
+        ret |= motor_param_save_hook(MOTOR_PARAM_KEY_CALIB, &motor->calib, sizeof(motor->calib));
+    }
+
+    return ret;
+}
+
+/**
+ * @brief 向控制中断投递命令
+ * @param motor 电机结构体指针
+ * @param lane  通道编号，每个生产者上下文固定使用一个通道
+ * @param cmd   命令指针
+ * @return 投递状态，0表示成功，1表示参数错误，2表示通道已满
+ * @note   无等待：一次原子取号加一次单生产者入队，不关中断、不自旋；
+ *         命令在下一个电流环周期开始时生效
+ */
+uint8_t motor_cmd_post(motor_t *motor, uint8_t lane, const motor_cmd_t *cmd) {
+    motor_cmd_queue_t *q;
+    motor_cmd_lane_t *l;
+    uint32_t head;
+
+    if (motor == NULL || cmd == NULL || lane >= MOTOR_CMD_LANES) {
+        return 1;
+    }
+
+    q = &motor->cmd_queue;
+    l = &q->lanes[lane];
+    head = atomic_load_explicit(&l->head, memory_order_relaxed);
+    if (head - atomic_load_explicit(&l->tail, memory_order_acquire) >= MOTOR_CMD_DEPTH) {
+        atomic_fetch_add_explicit(&q->stats.overflows, 1, memory_order_relaxed);
+        return 2;
+    }
+
+    l->slots[head & (MOTOR_CMD_DEPTH - 1)] = *cmd;
+    l->slots[head & (MOTOR_CMD_DEPTH - 1)].ticket =
+        atomic_fetch_add_explicit(&q->ticket, 1, memory_order_relaxed);
+    atomic_store_explicit(&l->head, head + 1U, memory_order_release);
+    atomic_fetch_add_explicit(&q->stats.posted, 1, memory_order_relaxed);
+
+    return 0;
+}
+
+/**
+ * @brief PWM周期事件中断处理函数
+ * @param motor 电机结构体指针
+ * @note   在PWM计数器下溢（电流采样触发）时调用，预取模式下启动编码器DMA传输，
+ *         传输与ADC转换并行进行，不在中断内等待
+ */
+FAST_RAM_CODE
+void motor_pwm_event_isr(motor_t *motor) {
+    if (motor == NULL || !motor->encoder.is_prefetch || motor->encoder.start_async == NULL) {
+        return;
+    }
+
+    motor->encoder.is_ready = false;
+    motor->encoder.start_async();
+}
+
+/**
+ * @brief 编码器传输完成中断处理函数
+ * @param motor 电机结构体指针
+ * @param raw   原始角度值
+ */
+FAST_RAM_CODE
+void motor_encoder_complete_isr(motor_t *motor, uint16_t raw) {
+    if (motor == NULL) {
+        return;
+    }
+
+    motor->encoder.raw = raw;
+    motor->encoder.is_ready = true;
+}
+
+/**
+ * @brief 电流环中断处理函数（ADC注入转换完成中断）
+ * @param motor 电机结构体指针
+ * @note   执行Clarke/Park变换、DQ轴PI调节与反变换；
+ *         预取模式下直接取用已就绪的编码器结果，阻塞模式下在此读取编码器
+ */
+FAST_RAM_CODE
+void motor_current_loop_isr(motor_t *motor) {
+    motor_encoder_t *enc;
+    three_phase_current_t i_abc;
+    uint32_t start = motor_get_cycles();
+    uint32_t cycles;
+    uint16_t raw;
+    bool is_angle_ok = true;
+    bool is_tripped;
+    float i_alpha, i_beta, i_d, i_q;
+    float i_d_ref, i_q_ref, i_limit, i_dyn, i_q_max;
+    float v_d, v_q, sin_t, cos_t;
+    uint16_t elec;
+
+    if (motor == NULL || !motor->is_initialized) {
+        return;
+    }
+    enc = &motor->encoder;
+
+    // 周期起点统一处理应用层命令，给定值在本周期内保持不变
+    motor_cmd_drain(motor);
+
+    // 读取相电流并执行Clarke变换
+    i_abc = motor->get_current();
+    i_alpha = i_abc.ia;
+    i_beta = (i_abc.ia + 2.0f * i_abc.ib) * MOTOR_SQRT3_INV;
+
+    // 获取转子角度：预取结果未就绪时沿用上一周期角度并计数
+    if (enc->is_prefetch) {
+        if (!enc->is_ready) {
+            enc->miss_count++;
+            is_angle_ok = false;
+        }
+        raw = enc->raw;
+    } else if (enc->read_blocking == NULL || enc->read_blocking(&raw) != 0) {
+        raw = enc->raw;
+        is_angle_ok = false;
+    } else {
+        enc->raw = raw;
+    }
+
+    // 故障评估：跳闸锁存期间不输出，跳过后续调节
+    is_tripped = motor_fault_evaluate(motor, &i_abc, is_angle_ok);
+
+    // 速度/位置外环：分频执行，结果作为本周期的i_q给定；跳闸或未使能时只跟踪位置
+    motor_outer_loop(motor, raw, is_angle_ok, !is_tripped && atomic_load(&motor->is_enabled));
+    if (!is_tripped) {
+        // 编码器分辨率为2的幂，电角度取模用掩码完成，不调用libm
+        elec = (uint16_t)(((uint32_t)(uint16_t)(raw - enc->offset) * motor->config.pole_pairs) &
+                          (ENCODER_RESOLUTION - 1U));
+        enc->angle_elec = (float)elec * (MOTOR_TWO_PI / ENCODER_RESOLUTION);
+
+        // Park变换（查表正余弦）
+        motor_sincos(elec, &sin_t, &cos_t);
+        i_d = i_alpha * cos_t + i_beta * sin_t;
+        i_q = -i_alpha * sin_t + i_beta * cos_t;
+
+        // 降额时按比例收紧电流给定上限，max_current为峰值能力，动态上限只会进一步收紧
+        i_limit = motor->config.max_current * motor->fault.derate_scale;
+        if (motor->get_current_limit != NULL) {
+            i_dyn = motor->get_current_limit(i_d, i_q);
+            if (i_dyn < i_limit) i_limit = i_dyn;
+        }
+        i_d_ref = motor->i_d_ref;
+        i_q_ref = motor->i_q_ref;
+        if (motor->get_iq_feedforward != NULL) {
+            i_q_ref += motor->get_iq_feedforward(raw);
+        }
+        if (motor->limit_dq_ref != NULL) {
+            // 母线电压取故障评估本周期的采样，不重复读取ADC；转速用于判断回馈方向
+            if (motor->limit_dq_ref(motor->v_bus, motor->speed_meas, &i_d_ref, &i_q_ref)) {
+                motor->is_iq_limited = true;
+            }
+        }
+
+        // 电流矢量限幅：D轴（弱磁、母线注入）优先，Q轴只使用剩余幅值，|I|不超过i_limit；
+        // Q轴被截断时通知速度环暂停积分
+        if (i_d_ref > i_limit) i_d_ref = i_limit;
+        if (i_d_ref < -i_limit) i_d_ref = -i_limit;
+        i_q_max = sqrtf(i_limit * i_limit - i_d_ref * i_d_ref);
+        if (i_q_ref > i_q_max || i_q_ref < -i_q_max) {
+            i_q_ref = (i_q_ref > 0.0f) ? i_q_max : -i_q_max;
+            motor->is_iq_limited = true;
+        }
+
+        // DQ轴PI调节
+        v_d = motor_pi_update(&motor->pid_d, &motor->i_d_integral, i_d_ref - i_d, false);
+        v_q = motor_pi_update(&motor->pid_q, &motor->i_q_integral, i_q_ref - i_q, false);
+
+        // Park逆变换并输出
+        motor->set_voltage(v_d * cos_t - v_q * sin_t, v_d * sin_t + v_q * cos_t);
+    }
+
+    // 统计中断耗时，用于对比预取与阻塞两种路径
+    cycles = motor_get_cycles() - start;
+    motor->isr_stats.cycles_last = cycles;
+    if (cycles > motor->isr_stats.cycles_max) {
+        motor->isr_stats.cycles_max = cycles;
+    }
+    motor->isr_stats.count++;
+}
+
+/**
+ * @brief 请求清除跳闸锁存
+ * @param motor 电机结构体指针
+ * @param mask  待清除的故障位图（1 << motor_fault_id_t）
+ * @return 请求状态，0表示成功，非0表示失败
+ * @note   清除在下一个电流环周期执行，故障条件尚未持续消失的项保持锁存；
+ *         清除后状态为IDLE，由应用层重新使能输出，无需重新初始化
+ */
+uint8_t motor_fault_clear(motor_t *motor, uint32_t mask) {
+    if (motor == NULL) {
+        return 1;
+    }
+
+    atomic_fetch_or_explicit(&motor->fault.clear_request, mask, memory_order_release);
+    return 0;
+}
+
+/**
+ * @brief 获取故障状态快照
+ * @param motor    电机结构体指针
+ * @param snapshot 快照输出指针
+ * @return 获取状态，0表示成功，非0表示失败
+ * @note   锁存位图原子读取；其余字段由中断逐周期更新，快照内各字段之间不保证严格一致
+ */
+uint8_t motor_fault_get(motor_t *motor, motor_fault_snapshot_t *snapshot) {
+    motor_fault_mgr_t *fm;
+    uint8_t i;
+
+    if (motor == NULL || snapshot == NULL) {
+        return 1;
+    }
+
+    fm = &motor->fault;
+    snapshot->latched = atomic_load_explicit(&fm->latched, memory_order_relaxed);
+    snapshot->warn_mask = fm->warn_mask;
+    snapshot->derate_mask = fm->derate_mask;
+    snapshot->derate_scale = fm->derate_scale;
+    for (i = 0; i < MOTOR_FAULT_NUM; i++) {
+        snapshot->level[i] = fm->state[i].level;
+        snapshot->value[i] = fm->state[i].value;
+        snapshot->trip_count[i] = fm->state[i].trip_count;
+    }
+
+    return 0;
+}
+
 /**
  * @brief 电机初始化函数
  * @param motor 电机结构体指针
@@ -270,7 +1316,12 @@ uint8_t motor_init(motor_t *motor) {
     motor->set_position = motor_set_position;
     motor->get_status = motor_get_status;
     motor->get_current = motor_get_current;
+    motor->get_bus_voltage = motor_get_bus_voltage;
+    motor->get_temperature = motor_get_temperature;
     motor->update_pid = motor_update_pid;
+    motor->get_iq_feedforward = NULL;
+    motor->limit_dq_ref = NULL;
+    motor->get_current_limit = NULL;
     
     // 初始化默认配置
     motor->config.pole_pairs = 7;
@@ -291,8 +1342,56 @@ uint8_t motor_init(motor_t *motor) {
     motor->pid_q.integral_limit = 10.0f;
     motor->pid_q.output_limit = 1.0f;
     
+    // 外环PI参数：速度环输出限幅为最大电流，位置环输出限幅为最大速度（外环周期计）
+    motor->pid_speed = (pid_param_t){ .kp = 0.002f, .ki = 0.0001f, .kd = 0.0f,
+                                      .integral_limit = MAX_CURRENT, .output_limit = MAX_CURRENT };
+    motor->pid_position = (pid_param_t){ .kp = 20.0f, .ki = 0.0f, .kd = 0.0f,
+                                         .integral_limit = MAX_SPEED, .output_limit = MAX_SPEED };
+    
     // 初始化状态
     motor->status = MOTOR_STATUS_IDLE;
+    motor->is_enabled = false;
+    motor->i_d_ref = 0.0f;
+    motor->i_q_ref = 0.0f;
+    motor->i_d_integral = 0.0f;
+    motor->i_q_integral = 0.0f;
+    motor->speed_ref = 0.0f;
+    motor->position_ref = 0.0f;
+    motor->speed_meas = 0.0f;
+    motor->v_bus = 0.0f;
+    motor->speed_integral = 0.0f;
+    motor->position_integral = 0.0f;
+    motor->position_counts = 0;
+    motor->outer_delta = 0;
+    motor->outer_raw_prev = 0;
+    motor->outer_div = 0;
+    motor->is_outer_synced = false;
+    motor->is_iq_limited = false;
+    motor->isr_stats = (motor_isr_stats_t){0};
+    motor->cmd_queue = (motor_cmd_queue_t){0};
+    
+    // 初始化编码器（默认阻塞模式，绑定异步接口后切换为预取模式）
+    motor->encoder = (motor_encoder_t){0};
+    motor_sincos_init();
+    
+    // 初始化故障管理器（阈值：告警/降额/跳闸；滤波周期按20kHz电流环计）
+    motor->fault = (motor_fault_mgr_t){
+        .cfg = {
+            // 过流阈值按硬件额定设置：电流给定限幅在max_current以内，满额运行不会进入告警或降额
+            [MOTOR_FAULT_OVERCURRENT]  = { { 0.8f * MOTOR_OC_TRIP_CURRENT, 0.9f * MOTOR_OC_TRIP_CURRENT,
+                                             MOTOR_OC_TRIP_CURRENT }, 0.5f, 0.7f, 2, 2000, false },
+            [MOTOR_FAULT_OVERVOLTAGE]  = { { 26.0f, 28.0f, 30.0f }, 0.5f, 0.5f, 20, 2000, false },
+            [MOTOR_FAULT_UNDERVOLTAGE] = { { 20.0f, 19.0f, 18.0f }, 0.5f, 0.5f, 20, 2000, true },
+            [MOTOR_FAULT_OVERTEMP]     = { { 80.0f, 95.0f, 110.0f }, 5.0f, 0.5f, 200, 20000, false },
+            [MOTOR_FAULT_ANGLE_LOSS]   = { { 1.0f, 3.0f, 8.0f }, 0.0f, 0.5f, 1, 200, false },
+        },
+        .derate_scale = 1.0f,
+    };
+    
+    // 从参数存储恢复（覆盖上面的默认值）
+    motor->calib = (motor_calib_t){0};
+    motor->is_calibrated = false;
+    motor_param_restore(motor);
     
     // 执行复位
     motor->reset();
@@ -315,7 +1414,7 @@ uint8_t motor_deinit(motor_t *motor) {
     }
     
     // 失能电机
-    motor->enable(false);
+    motor->enable(motor, false);
     
     // 清除初始化标志
     motor->is_initialized = false;
@@ -330,11 +1429,150 @@ uint8_t motor_deinit(motor_t *motor) {
     motor->set_position = NULL;
     motor->get_status = NULL;
     motor->get_current = NULL;
+    motor->get_bus_voltage = NULL;
+    motor->get_temperature = NULL;
     motor->update_pid = NULL;
+    motor->get_iq_feedforward = NULL;
+    motor->limit_dq_ref = NULL;
+    motor->get_current_limit = NULL;
     
     return 0;
 }
 
+/* ==================== 主机仿真 ==================== */
+
+#ifdef MOTOR_SIM_POSIX
+
+#define MOTOR_SIM_CYCLES           20000       // 每种模式仿真的电流环周期数
+#define MOTOR_SIM_ADC_NS           3000U       // PWM事件到电流环中断的时间（采样保持+注入转换，纳秒）
+#define MOTOR_SIM_SPI_XFER_NS      2600U       // SPI编码器一帧（16位@10MHz+片选建立，纳秒）
+#define MOTOR_SIM_I2C_XFER_NS      45000U      // I2C编码器一次读取（2字节@1MHz，纳秒）
+
+/**
+ * @brief 仿真结果结构体
+ * @note  中断耗时为主机上motor_current_loop_isr的实测平均值；阻塞读取以忙等待
+ *        占满传输时间，预取传输是否赶上电流环由传输时间与ADC窗口的时间线决定
+ */
+typedef struct {
+    uint32_t isr_ns_base;          /**< 角度无需读取时的中断耗时（纳秒，基准） */
+    uint32_t isr_ns_blocking;      /**< 中断内阻塞读取SPI编码器的中断耗时（纳秒） */
+    uint32_t isr_ns_prefetch;      /**< 预取SPI编码器的中断耗时（纳秒） */
+    uint32_t prefetch_misses;      /**< SPI预取未赶上电流环的周期数 */
+    uint32_t i2c_prefetch_misses;  /**< I2C编码器传输超出ADC窗口时的未赶上周期数 */
+} motor_sim_result_t;
+
+/**
+ * @brief 仿真编码器状态
+ */
+static struct {
+    uint16_t raw;                  /**< 模拟转子角度 */
+    uint32_t xfer_ns;              /**< 编码器传输时间 */
+    bool is_pending;               /**< 预取传输进行中 */
+} motor_sim_enc;
+
+/**
+ * @brief 忙等待指定纳秒（模拟阻塞传输占用CPU）
+ */
+static void motor_sim_spin_ns(uint32_t ns) {
+    uint32_t start = motor_get_cycles();
+
+    while ((uint32_t)(motor_get_cycles() - start) < ns) {
+    }
+}
+
+/**
+ * @brief 阻塞读取：CPU在中断内等待整个传输完成
+ */
+static uint8_t motor_sim_enc_read_blocking(uint16_t *raw) {
+    motor_sim_spin_ns(motor_sim_enc.xfer_ns);
+    *raw = motor_sim_enc.raw;
+    return 0;
+}
+
+/**
+ * @brief 异步启动：只登记传输，由时间线决定完成时刻
+ */
+static void motor_sim_enc_start_async(void) {
+    motor_sim_enc.is_pending = true;
+}
+
+/**
+ * @brief 按指定编码器模式运行若干电流环周期
+ * @param motor      电机结构体指针
+ * @param mode       0：角度无需读取（基准）；1：阻塞读取；2：预取
+ * @param xfer_ns    编码器传输时间
+ * @return 平均中断耗时（纳秒）
+ */
+static uint32_t motor_sim_run_mode(motor_t *motor, uint8_t mode, uint32_t xfer_ns) {
+    uint64_t sum = 0;
+    uint32_t k;
+
+    motor_sim_enc.xfer_ns = xfer_ns;
+    motor->encoder.read_blocking = (mode == 1) ? motor_sim_enc_read_blocking : NULL;
+    motor->encoder.start_async = (mode == 2) ? motor_sim_enc_start_async : NULL;
+    motor->encoder.is_prefetch = (mode != 1);
+    motor->encoder.is_ready = true;
+    motor->encoder.miss_count = 0;
+
+    for (k = 0; k < MOTOR_SIM_CYCLES; k++) {
+        motor_sim_enc.raw = (uint16_t)((motor_sim_enc.raw + 7U) & (ENCODER_RESOLUTION - 1U));
+        if (mode == 0) {
+            motor->encoder.raw = motor_sim_enc.raw;
+        }
+
+        // PWM事件：预取模式下启动传输，随后ADC采样转换与传输并行进行
+        motor_pwm_event_isr(motor);
+        if (motor_sim_enc.is_pending && xfer_ns <= MOTOR_SIM_ADC_NS) {
+            motor_sim_enc.is_pending = false;
+            motor_encoder_complete_isr(motor, motor_sim_enc.raw);
+        }
+
+        motor_current_loop_isr(motor);
+        sum += motor->isr_stats.cycles_last;
+
+        // 传输晚于电流环时在中断之后完成，本周期已计为未赶上
+        if (motor_sim_enc.is_pending) {
+            motor_sim_enc.is_pending = false;
+            motor_encoder_complete_isr(motor, motor_sim_enc.raw);
+        }
+    }
+    return (uint32_t)(sum / MOTOR_SIM_CYCLES);
+}
+
+/**
+ * @brief 编码器预取仿真
+ * @param result 结果输出指针
+ * @return 状态，0表示成功，非0表示失败
+ * @note   对比同一电流环在三种角度来源下的实测中断耗时：预取与基准之差即预取带来的
+ *         附加中断延迟，阻塞与基准之差约为一次传输时间；另以I2C编码器验证传输超出
+ *         ADC窗口时按周期计数未赶上并沿用上一周期角度
+ */
+uint8_t motor_sim_run(motor_sim_result_t *result) {
+    static motor_t motor;
+
+    if (result == NULL) {
+        return 1;
+    }
+    *result = (motor_sim_result_t){0};
+    if (motor_init(&motor) != 0) {
+        return 1;
+    }
+
+    // 预热缓存与分支预测后再计时
+    motor_sim_run_mode(&motor, 0, 0);
+
+    result->isr_ns_base = motor_sim_run_mode(&motor, 0, 0);
+    result->isr_ns_blocking = motor_sim_run_mode(&motor, 1, MOTOR_SIM_SPI_XFER_NS);
+    result->isr_ns_prefetch = motor_sim_run_mode(&motor, 2, MOTOR_SIM_SPI_XFER_NS);
+    result->prefetch_misses = motor.encoder.miss_count;
+    motor_sim_run_mode(&motor, 2, MOTOR_SIM_I2C_XFER_NS);
+    result->i2c_prefetch_misses = motor.encoder.miss_count;
+
+    return 0;
+}
+
+#endif /* MOTOR_SIM_POSIX */
+
 /* ==================== 使用示例 ==================== */
 
 /*
@@ -344,38 +1582,81 @@ uint8_t motor_deinit(motor_t *motor) {
  *     motor_t foc_motor;
  *     three_phase_current_t current;
  *     
+ *     // 绑定参数存储（见kv_store_template.c），初始化时恢复标定与增益
+ *     motor_set_param_store(param_load, param_save);
+ *     
  *     // 初始化电机
  *     if (motor_init(&foc_motor) != 0) {
  *         // 初始化失败处理
  *         return -1;
  *     }
  *     
- *     // 使能电机
- *     foc_motor.enable(true);
+ *     // 存储中没有标定参数时执行上电标定并保存，之后上电跳过标定
+ *     if (!foc_motor.is_calibrated) {
+ *         // 采样零偏、对齐转子得到 foc_motor.calib 与 foc_motor.encoder.offset
+ *         foc_motor.is_calibrated = true;
+ *         motor_param_save(&foc_motor);
+ *     }
  *     
- *     // 设置速度控制模式
- *     foc_motor.config.control_mode = MOTOR_MODE_SPEED;
+ *     // 使能电机：状态变为RUNNING
+ *     foc_motor.enable(&foc_motor, true);
  *     
- *     // 设置目标速度
- *     foc_motor.set_speed(3000.0f);  // 3000 RPM
+ *     // 设置速度控制模式与目标速度：经命令队列投递，由电流环中断按顺序生效
+ *     motor_cmd_t cmd = { .type = MOTOR_CMD_SET_MODE, .mode = MOTOR_MODE_SPEED };
+ *     motor_cmd_post(&foc_motor, APP_TASK_LANE, &cmd);
+ *     cmd = (motor_cmd_t){ .type = MOTOR_CMD_SET_SPEED, .arg0 = 3000.0f };  // 3000 RPM
+ *     motor_cmd_post(&foc_motor, APP_TASK_LANE, &cmd);
  *     
  *     // 读取电流
  *     current = foc_motor.get_current();
  *     
  *     // 获取状态
- *     if (foc_motor.get_status() == MOTOR_STATUS_RUNNING) {
+ *     if (foc_motor.get_status(&foc_motor) == MOTOR_STATUS_RUNNING) {
  *         // 电机正常运行
  *     }
  *     
+ *     // 绑定编码器：预取模式下由PWM事件启动传输
+ *     foc_motor.encoder.read_blocking = encoder_read_blocking;
+ *     foc_motor.encoder.start_async = encoder_start_dma;
+ *     foc_motor.encoder.is_prefetch = true;
+ *     // TIMx更新中断中调用 motor_pwm_event_isr(&foc_motor);
+ *     // ADC注入完成中断中调用 motor_current_loop_isr(&foc_motor);
+ *     // SPI DMA完成中断中调用 motor_encoder_complete_isr(&foc_motor, raw);
+ *     // 分别在两种模式下运行，比较 foc_motor.isr_stats.cycles_max
+ *     
+ *     // 在任意任务或中断中投递给定值，由电流环中断统一生效；外环速度见 foc_motor.speed_meas
+ *     cmd = (motor_cmd_t){ .type = MOTOR_CMD_SET_SPEED, .arg0 = 1500.0f };
+ *     motor_cmd_post(&foc_motor, APP_TASK_LANE, &cmd);
+ *     
+ *     // 故障处理：电流环中断内分级评估，跳闸后锁存并关断输出
+ *     motor_fault_snapshot_t fault;
+ *     motor_fault_get(&foc_motor, &fault);
+ *     if (fault.latched != 0) {
+ *         // 条件消失后请求清除，电机对象保持有效，无需重新初始化
+ *         motor_fault_clear(&foc_motor, fault.latched);
+ *         // 清除在下一个电流环周期执行，条件未消失的项保持锁存；
+ *         // 状态离开MOTOR_STATUS_FAULT（回到IDLE）后才能重新使能，不能在请求后立即使能
+ *         while (foc_motor.get_status(&foc_motor) == MOTOR_STATUS_FAULT) {
+ *             // 任务延时，超时仍未清除则放弃并上报
+ *         }
+ *         foc_motor.enable(&foc_motor, true);
+ *     }
+ *     
  *     // 停止电机
- *     foc_motor.set_speed(0.0f);
+ *     cmd = (motor_cmd_t){ .type = MOTOR_CMD_SET_SPEED, .arg0 = 0.0f };
+ *     motor_cmd_post(&foc_motor, APP_TASK_LANE, &cmd);
  *     
  *     // 失能电机
- *     foc_motor.enable(false);
+ *     foc_motor.enable(&foc_motor, false);
  *     
  *     // 去初始化
  *     motor_deinit(&foc_motor);
  *     
  *     return 0;
  * }
+ *
+ * 主机仿真（Linux）：
+ *   gcc -std=c11 -O2 -D_DEFAULT_SOURCE -DMOTOR_SIM_POSIX foc_motor_driver_template.c test_main.c -lm
+ *   motor_sim_result_t r;
+ *   motor_sim_run(&r);        // r.isr_ns_base / r.isr_ns_blocking / r.isr_ns_prefetch / r.prefetch_misses
  */
@@ -0,0 +1,557 @@
+/**
+ * @file i2c_bus_engine_template.c
+ * @brief 多路I2C总线并行事务引擎模板文件
+ * @description 引擎同时管理多个I2C控制器，每路总线拥有独立的事务队列，
+ *              由DMA完成中断驱动下一笔事务，使所有总线保持忙碌；
+ *              设备按负载分配到各总线，并统计每路总线的利用率与吞吐量；
+ *              定义I2C_ENGINE_SIM_POSIX后提供事件驱动的多总线仿真，验证聚合吞吐量
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* ==================== 宏定义 ==================== */
+
+#define I2C_BUS_NUM                3       // I2C控制器数量
+#define I2C_BUS_QUEUE_DEPTH        16      // 每路总线事务队列深度（2的幂）
+#define I2C_BUS_QUEUE_MASK         (I2C_BUS_QUEUE_DEPTH - 1)
+
+// 临界区保护（提交与完成中断共享队列），目标平台替换为关/开中断
+#ifndef I2C_ENGINE_ENTER_CRITICAL
+#define I2C_ENGINE_ENTER_CRITICAL()  ((void)0)
+#define I2C_ENGINE_EXIT_CRITICAL()   ((void)0)
+#endif
+
+/* ==================== 类型定义 ==================== */
+
+/**
+ * @brief 引擎错误码枚举
+ */
+typedef enum {
+    I2C_ENGINE_OK = 0,             /**< 成功 */
+    I2C_ENGINE_ERROR_NULL_PTR,     /**< 空指针错误 */
+    I2C_ENGINE_ERROR_INVALID_BUS,  /**< 总线编号无效 */
+    I2C_ENGINE_ERROR_QUEUE_FULL,   /**< 事务队列已满 */
+    I2C_ENGINE_ERROR_HW            /**< 硬件启动失败 */
+} i2c_engine_error_t;
+
+/**
+ * @brief 事务方向枚举
+ */
+typedef enum {
+    I2C_XFER_READ = 0,             /**< 读寄存器 */
+    I2C_XFER_WRITE                 /**< 写寄存器 */
+} i2c_xfer_dir_t;
+
+/* === 前向声明 === */
+
+typedef struct i2c_xfer_t i2c_xfer_t;
+typedef struct i2c_bus_t i2c_bus_t;
+typedef struct i2c_engine_t i2c_engine_t;
+
+/* === 函数指针类型定义 === */
+
+/**
+ * @brief 事务完成回调函数指针类型（在中断上下文中调用）
+ */
+typedef void (*i2c_xfer_done_fn)(i2c_xfer_t *xfer, bool is_ok);
+
+/**
+ * @brief 启动硬件事务函数指针类型（非阻塞，启动DMA后立即返回）
+ */
+typedef bool (*i2c_bus_hw_start_fn)(i2c_bus_t *bus, const i2c_xfer_t *xfer);
+
+/**
+ * @brief 提交事务函数指针类型
+ */
+typedef i2c_engine_error_t (*i2c_engine_submit_fn)(i2c_engine_t *engine, uint8_t bus_id,
+                                                   i2c_xfer_t *xfer);
+
+/**
+ * @brief 分配总线函数指针类型
+ */
+typedef uint8_t (*i2c_engine_assign_fn)(i2c_engine_t *engine, uint32_t load_bytes_per_s);
+
+/**
+ * @brief I2C事务结构体
+ * @note  事务对象由调用方持有，提交后在完成回调前不得修改
+ */
+struct i2c_xfer_t {
+    uint8_t slv_addr;              /**< 从设备地址 */
+    uint8_t reg;                   /**< 寄存器地址 */
+    i2c_xfer_dir_t dir;            /**< 事务方向 */
+    uint8_t *buf;                  /**< 数据缓冲区 */
+    uint16_t len;                  /**< 数据长度 */
+    i2c_xfer_done_fn done;         /**< 完成回调 */
+    void *ctx;                     /**< 回调上下文 */
+};
+
+/**
+ * @brief 总线统计结构体
+ */
+typedef struct {
+    uint32_t xfer_count;           /**< 完成事务数 */
+    uint32_t error_count;          /**< 失败事务数 */
+    uint32_t bytes;                /**< 传输字节数 */
+    uint32_t busy_us;              /**< 统计窗口内忙碌时间（微秒） */
+    uint16_t utilization_permille; /**< 利用率（千分比） */
+    uint8_t queue_peak;            /**< 队列深度峰值 */
+} i2c_bus_stats_t;
+
+/**
+ * @brief 单路总线结构体
+ */
+struct i2c_bus_t {
+    /* 硬件配置 */
+    uint8_t bus_id;                        /**< 总线编号 */
+    void *hw;                              /**< 控制器句柄（如I2C_HandleTypeDef） */
+    i2c_bus_hw_start_fn hw_start;          /**< 启动硬件事务 */
+
+    /* 运行状态 */
+    i2c_xfer_t *queue[I2C_BUS_QUEUE_DEPTH];  /**< 事务队列 */
+    uint8_t head;                          /**< 队列写位置 */
+    uint8_t tail;                          /**< 队列读位置 */
+    i2c_xfer_t *active;                    /**< 正在传输的事务 */
+    uint32_t active_start_us;              /**< 当前事务启动时刻 */
+    uint32_t assigned_load;                /**< 已分配负载（字节/秒） */
+    i2c_bus_stats_t stats;                 /**< 统计 */
+};
+
+/**
+ * @brief 多总线事务引擎结构体
+ */
+struct i2c_engine_t {
+    /* 运行状态 */
+    i2c_bus_t bus[I2C_BUS_NUM];            /**< 总线数组 */
+    uint32_t window_start_us;              /**< 统计窗口起点 */
+
+    /* 函数指针 - 操作方法 */
+    i2c_engine_submit_fn submit;           /**< 提交事务 */
+    i2c_engine_assign_fn assign;           /**< 为设备分配总线 */
+};
+
+/* ==================== 静态函数声明 ==================== */
+
+static i2c_engine_error_t i2c_engine_impl_submit(i2c_engine_t *engine, uint8_t bus_id,
+                                                 i2c_xfer_t *xfer);
+static uint8_t i2c_engine_impl_assign(i2c_engine_t *engine, uint32_t load_bytes_per_s);
+static void i2c_bus_kick(i2c_bus_t *bus);
+static uint32_t i2c_engine_get_time_us(void);
+
+/* ==================== 静态变量 ==================== */
+
+#ifdef I2C_ENGINE_SIM_POSIX
+static uint32_t i2c_sim_now_us;    // 仿真虚拟时间（微秒）
+#endif
+
+/* ==================== 静态函数实现 ==================== */
+
+/**
+ * @brief 获取微秒时间戳
+ * @return 当前时间（微秒）
+ */
+static uint32_t i2c_engine_get_time_us(void) {
+#ifdef I2C_ENGINE_SIM_POSIX
+    return i2c_sim_now_us;
+#else
+    // 由硬件定时器或DWT->CYCCNT换算
+    // 这里省略具体的计时器读取代码
+    return 0;
+#endif
+}
+
+/**
+ * @brief 若总线空闲则启动队首事务
+ * @param bus 总线结构体指针
+ * @note   调用方需处于临界区或完成中断中
+ */
+static void i2c_bus_kick(i2c_bus_t *bus) {
+    i2c_xfer_t *xfer;
+
+    while (bus->active == NULL && bus->tail != bus->head) {
+        xfer = bus->queue[bus->tail];
+        bus->tail = (uint8_t)((bus->tail + 1U) & I2C_BUS_QUEUE_MASK);
+
+        bus->active = xfer;
+        bus->active_start_us = i2c_engine_get_time_us();
+        if (bus->hw_start(bus, xfer)) {
+            return;
+        }
+
+        // 硬件启动失败，立即回调并尝试下一笔事务
+        bus->active = NULL;
+        bus->stats.error_count++;
+        if (xfer->done != NULL) {
+            xfer->done(xfer, false);
+        }
+    }
+}
+
+/**
+ * @brief 提交事务实现函数
+ * @param engine 引擎结构体指针
+ * @param bus_id 目标总线编号
+ * @param xfer   事务指针
+ * @return 错误码
+ * @note   非阻塞，事务入队后若总线空闲立即启动
+ */
+static i2c_engine_error_t i2c_engine_impl_submit(i2c_engine_t *engine, uint8_t bus_id,
+                                                 i2c_xfer_t *xfer) {
+    i2c_bus_t *bus;
+    uint8_t next;
+    uint8_t depth;
+
+    if (engine == NULL || xfer == NULL) {
+        return I2C_ENGINE_ERROR_NULL_PTR;
+    }
+    if (bus_id >= I2C_BUS_NUM) {
+        return I2C_ENGINE_ERROR_INVALID_BUS;
+    }
+
+    bus = &engine->bus[bus_id];
+
+    I2C_ENGINE_ENTER_CRITICAL();
+    next = (uint8_t)((bus->head + 1U) & I2C_BUS_QUEUE_MASK);
+    if (next == bus->tail) {
+        I2C_ENGINE_EXIT_CRITICAL();
+        return I2C_ENGINE_ERROR_QUEUE_FULL;
+    }
+    bus->queue[bus->head] = xfer;
+    bus->head = next;
+
+    // 记录队列深度峰值
+    depth = (uint8_t)((bus->head - bus->tail) & I2C_BUS_QUEUE_MASK);
+    if (depth > bus->stats.queue_peak) {
+        bus->stats.queue_peak = depth;
+    }
+
+    i2c_bus_kick(bus);
+    I2C_ENGINE_EXIT_CRITICAL();
+
+    return I2C_ENGINE_OK;
+}
+
+/**
+ * @brief 分配总线实现函数
+ * @param engine           引擎结构体指针
+ * @param load_bytes_per_s 设备预计负载（字节/秒）
+ * @return 分配到的总线编号
+ * @note   选择已分配负载最小的总线，使各路总线负载均衡
+ */
+static uint8_t i2c_engine_impl_assign(i2c_engine_t *engine, uint32_t load_bytes_per_s) {
+    uint8_t best = 0;
+    uint8_t i;
+
+    for (i = 1; i < I2C_BUS_NUM; i++) {
+        if (engine->bus[i].assigned_load < engine->bus[best].assigned_load) {
+            best = i;
+        }
+    }
+    engine->bus[best].assigned_load += load_bytes_per_s;
+
+    return best;
+}
+
+/* ==================== 公共函数实现 ==================== */
+
+/**
+ * @brief 事务引擎初始化函数
+ * @param engine   引擎结构体指针
+ * @param hw       各路控制器句柄数组（I2C_BUS_NUM个）
+ * @param hw_start 启动硬件事务回调
+ * @return 错误码
+ */
+i2c_engine_error_t i2c_engine_init(i2c_engine_t *engine, void *const hw[I2C_BUS_NUM],
+                                   i2c_bus_hw_start_fn hw_start) {
+    uint8_t i;
+
+    // 检查指针有效性
+    if (engine == NULL || hw == NULL || hw_start == NULL) {
+        return I2C_ENGINE_ERROR_NULL_PTR;
+    }
+
+    // 初始化各路总线
+    for (i = 0; i < I2C_BUS_NUM; i++) {
+        engine->bus[i] = (i2c_bus_t){0};
+        engine->bus[i].bus_id = i;
+        engine->bus[i].hw = hw[i];
+        engine->bus[i].hw_start = hw_start;
+    }
+    engine->window_start_us = i2c_engine_get_time_us();
+
+    // 绑定函数指针（面向对象核心）
+    engine->submit = i2c_engine_impl_submit;
+    engine->assign = i2c_engine_impl_assign;
+
+    return I2C_ENGINE_OK;
+}
+
+/**
+ * @brief 事务完成中断处理函数
+ * @param engine 引擎结构体指针
+ * @param bus_id 完成事务的总线编号
+ * @param is_ok  事务是否成功
+ * @note   在各路I2C/DMA完成中断中调用，先启动下一笔事务再执行回调，
+ *         缩短总线空闲间隙
+ */
+void i2c_engine_complete_isr(i2c_engine_t *engine, uint8_t bus_id, bool is_ok) {
+    i2c_bus_t *bus;
+    i2c_xfer_t *done;
+
+    if (engine == NULL || bus_id >= I2C_BUS_NUM) {
+        return;
+    }
+
+    bus = &engine->bus[bus_id];
+    done = bus->active;
+    if (done == NULL) {
+        return;
+    }
+
+    // 累计忙碌时间和传输量
+    bus->stats.busy_us += i2c_engine_get_time_us() - bus->active_start_us;
+    if (is_ok) {
+        bus->stats.xfer_count++;
+        bus->stats.bytes += done->len;
+    } else {
+        bus->stats.error_count++;
+    }
+
+    // 立即启动下一笔事务，保持总线忙碌
+    bus->active = NULL;
+    i2c_bus_kick(bus);
+
+    if (done->done != NULL) {
+        done->done(done, is_ok);
+    }
+}
+
+/**
+ * @brief 获取各路总线统计并开启新的统计窗口
+ * @param engine 引擎结构体指针
+ * @param stats  统计输出数组（I2C_BUS_NUM个）
+ * @param aggregate_bytes_per_s 聚合吞吐量输出（字节/秒，可为NULL）
+ * @return 错误码
+ * @note   并行度良好时聚合吞吐量应接近单路吞吐量乘以总线数量
+ */
+i2c_engine_error_t i2c_engine_get_stats(i2c_engine_t *engine, i2c_bus_stats_t stats[I2C_BUS_NUM],
+                                        uint32_t *aggregate_bytes_per_s) {
+    uint32_t now_us;
+    uint32_t window_us;
+    uint32_t total_bytes = 0;
+    i2c_bus_t *bus;
+    uint8_t i;
+
+    if (engine == NULL || stats == NULL) {
+        return I2C_ENGINE_ERROR_NULL_PTR;
+    }
+
+    now_us = i2c_engine_get_time_us();
+    window_us = now_us - engine->window_start_us;
+
+    I2C_ENGINE_ENTER_CRITICAL();
+    for (i = 0; i < I2C_BUS_NUM; i++) {
+        bus = &engine->bus[i];
+        bus->stats.utilization_permille = (window_us == 0) ? 0 :
+            (uint16_t)(((uint64_t)bus->stats.busy_us * 1000U) / window_us);
+        total_bytes += bus->stats.bytes;
+        stats[i] = bus->stats;
+
+        // 开启新的统计窗口
+        bus->stats = (i2c_bus_stats_t){0};
+    }
+    engine->window_start_us = now_us;
+    I2C_ENGINE_EXIT_CRITICAL();
+
+    if (aggregate_bytes_per_s != NULL) {
+        *aggregate_bytes_per_s = (window_us == 0) ? 0 :
+            (uint32_t)(((uint64_t)total_bytes * 1000000U) / window_us);
+    }
+
+    return I2C_ENGINE_OK;
+}
+
+/* ==================== 主机仿真 ==================== */
+
+#ifdef I2C_ENGINE_SIM_POSIX
+
+#define I2C_SIM_BITRATE            400000U     // 总线速率（Hz，快速模式）
+#define I2C_SIM_ISR_US             3U          // 完成中断执行时间（微秒），各路中断共用一个CPU
+#define I2C_SIM_DEVICES            6U          // 设备数量
+#define I2C_SIM_XFER_LEN           12U         // 每次读取字节数（如IMU六轴数据）
+#define I2C_SIM_DURATION_US        1000000U    // 每轮仿真时长（微秒）
+
+/**
+ * @brief 仿真结果结构体
+ */
+typedef struct {
+    uint32_t single_bytes_per_s;               /**< 全部设备挂在一路总线上的聚合吞吐量 */
+    uint32_t multi_bytes_per_s;                /**< 设备分配到全部总线上的聚合吞吐量 */
+    float speedup;                             /**< 吞吐量之比（理想值为I2C_BUS_NUM） */
+    uint16_t utilization_permille[I2C_BUS_NUM];  /**< 多总线运行时各路利用率（千分比） */
+} i2c_sim_result_t;
+
+/**
+ * @brief 仿真设备结构体：完成回调中立即重新提交，使每个设备始终有一笔事务在排队
+ */
+typedef struct {
+    i2c_xfer_t xfer;               /**< 事务 */
+    uint8_t buf[I2C_SIM_XFER_LEN]; /**< 数据缓冲区 */
+    uint8_t bus_id;                /**< 分配到的总线 */
+} i2c_sim_dev_t;
+
+static i2c_engine_t i2c_sim_engine;
+static i2c_sim_dev_t i2c_sim_dev[I2C_SIM_DEVICES];
+static uint32_t i2c_sim_done_at[I2C_BUS_NUM];  // 各路当前事务完成时刻，UINT32_MAX表示空闲
+static uint32_t i2c_sim_cpu_free_at;           // CPU空闲时刻：同时完成的总线中断依次执行
+
+/**
+ * @brief 模拟启动DMA事务：按线上比特数计算完成时刻
+ * @note   读寄存器：起始+地址+寄存器+重复起始+地址+数据，每字节9位
+ */
+static bool i2c_sim_hw_start(i2c_bus_t *bus, const i2c_xfer_t *xfer) {
+    uint32_t bits = (3U + xfer->len) * 9U + 4U;
+
+    i2c_sim_done_at[bus->bus_id] = i2c_sim_now_us + I2C_SIM_ISR_US +
+                                   (bits * 1000000U + I2C_SIM_BITRATE - 1U) / I2C_SIM_BITRATE;
+    return true;
+}
+
+/**
+ * @brief 设备完成回调：重新提交同一事务
+ */
+static void i2c_sim_done(i2c_xfer_t *xfer, bool is_ok) {
+    i2c_sim_dev_t *dev = (i2c_sim_dev_t *)xfer->ctx;
+
+    (void)is_ok;
+    i2c_sim_engine.submit(&i2c_sim_engine, dev->bus_id, xfer);
+}
+
+/**
+ * @brief 运行一轮仿真
+ * @param is_multi 是否按负载把设备分配到全部总线（否则全部挂在总线0）
+ * @param stats    各路统计输出
+ * @return 聚合吞吐量（字节/秒）
+ */
+static uint32_t i2c_sim_once(bool is_multi, i2c_bus_stats_t stats[I2C_BUS_NUM]) {
+    static void *const hw[I2C_BUS_NUM];
+    uint32_t total_bps = 0;
+    uint8_t i, next;
+
+    i2c_sim_now_us = 0;
+    i2c_sim_cpu_free_at = 0;
+    for (i = 0; i < I2C_BUS_NUM; i++) {
+        i2c_sim_done_at[i] = UINT32_MAX;
+    }
+    i2c_engine_init(&i2c_sim_engine, hw, i2c_sim_hw_start);
+
+    for (i = 0; i < I2C_SIM_DEVICES; i++) {
+        i2c_sim_dev[i].bus_id = is_multi ?
+            i2c_sim_engine.assign(&i2c_sim_engine, 1000U * I2C_SIM_XFER_LEN) : 0;
+        i2c_sim_dev[i].xfer = (i2c_xfer_t){
+            .slv_addr = (uint8_t)(0x68U + i), .reg = 0x3B, .dir = I2C_XFER_READ,
+            .buf = i2c_sim_dev[i].buf, .len = I2C_SIM_XFER_LEN,
+            .done = i2c_sim_done, .ctx = &i2c_sim_dev[i],
+        };
+        i2c_sim_engine.submit(&i2c_sim_engine, i2c_sim_dev[i].bus_id, &i2c_sim_dev[i].xfer);
+    }
+
+    // 事件循环：推进到最早完成的总线，CPU被其他总线的中断占用时顺延，执行其完成中断
+    for (;;) {
+        next = 0;
+        for (i = 1; i < I2C_BUS_NUM; i++) {
+            if (i2c_sim_done_at[i] < i2c_sim_done_at[next]) {
+                next = i;
+            }
+        }
+        if (i2c_sim_done_at[next] > I2C_SIM_DURATION_US) {
+            break;
+        }
+        i2c_sim_now_us = (i2c_sim_done_at[next] > i2c_sim_cpu_free_at) ?
+                         i2c_sim_done_at[next] : i2c_sim_cpu_free_at;
+        i2c_sim_cpu_free_at = i2c_sim_now_us + I2C_SIM_ISR_US;
+        i2c_sim_done_at[next] = UINT32_MAX;
+        i2c_engine_complete_isr(&i2c_sim_engine, next, true);
+    }
+
+    i2c_sim_now_us = I2C_SIM_DURATION_US;
+    i2c_engine_get_stats(&i2c_sim_engine, stats, &total_bps);
+    return total_bps;
+}
+
+/**
+ * @brief 多总线并行仿真
+ * @param result 结果输出指针
+ * @return 错误码
+ * @note   同一组设备先全部挂在一路总线上运行，再按负载分配到全部总线运行，
+ *         比较聚合吞吐量；各路完成中断共用一个CPU，同时完成时依次执行，
+ *         各路总线均应接近满载，吞吐量之比接近总线数量
+ */
+i2c_engine_error_t i2c_sim_run(i2c_sim_result_t *result) {
+    i2c_bus_stats_t stats[I2C_BUS_NUM];
+    uint8_t i;
+
+    if (result == NULL) {
+        return I2C_ENGINE_ERROR_NULL_PTR;
+    }
+    *result = (i2c_sim_result_t){0};
+
+    result->single_bytes_per_s = i2c_sim_once(false, stats);
+    result->multi_bytes_per_s = i2c_sim_once(true, stats);
+    for (i = 0; i < I2C_BUS_NUM; i++) {
+        result->utilization_permille[i] = stats[i].utilization_permille;
+    }
+    result->speedup = (result->single_bytes_per_s == 0) ? 0.0f :
+                      (float)result->multi_bytes_per_s / (float)result->single_bytes_per_s;
+
+    return I2C_ENGINE_OK;
+}
+
+#endif /* I2C_ENGINE_SIM_POSIX */
+
+/* ==================== 使用示例 ==================== */
+
+/*
+ * 使用示例：
+ *
+ * static i2c_engine_t i2c_engine;
+ * static void *const i2c_hw[I2C_BUS_NUM] = { &hi2c1, &hi2c2, &hi2c3 };
+ *
+ * // 启动硬件DMA事务，非阻塞
+ * static bool board_i2c_start(i2c_bus_t *bus, const i2c_xfer_t *xfer) {
+ *     if (xfer->dir == I2C_XFER_READ) {
+ *         return HAL_I2C_Mem_Read_DMA(bus->hw, xfer->slv_addr << 1, xfer->reg,
+ *                                     I2C_MEMADD_SIZE_8BIT, xfer->buf, xfer->len) == HAL_OK;
+ *     }
+ *     return HAL_I2C_Mem_Write_DMA(bus->hw, xfer->slv_addr << 1, xfer->reg,
+ *                                  I2C_MEMADD_SIZE_8BIT, xfer->buf, xfer->len) == HAL_OK;
+ * }
+ *
+ * // 各路完成中断
+ * void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c) {
+ *     i2c_engine_complete_isr(&i2c_engine, board_i2c_index(hi2c), true);
+ * }
+ *
+ * int main(void) {
+ *     i2c_bus_stats_t stats[I2C_BUS_NUM];
+ *     uint32_t total_bps;
+ *
+ *     i2c_engine_init(&i2c_engine, i2c_hw, board_i2c_start);
+ *
+ *     // 按设备负载分配总线，结果写入sensor_t的bus_id
+ *     imu.bus_id = i2c_engine.assign(&i2c_engine, 200 * 12);
+ *     baro.bus_id = i2c_engine.assign(&i2c_engine, 50 * 6);
+ *
+ *     // 提交事务后立即返回，完成回调在中断中执行
+ *     i2c_engine.submit(&i2c_engine, imu.bus_id, &imu_xfer);
+ *
+ *     // 周期性读取利用率，三路满载时total_bps应接近单路的3倍
+ *     i2c_engine_get_stats(&i2c_engine, stats, &total_bps);
+ * }
+ *
+ * 主机仿真（Linux）：
+ *   gcc -std=c11 -O2 -DI2C_ENGINE_SIM_POSIX i2c_bus_engine_template.c test_main.c
+ *   i2c_sim_result_t r;
+ *   i2c_sim_run(&r);          // r.single_bytes_per_s / r.multi_bytes_per_s / r.speedup
+ */
@@ -0,0 +1,948 @@
+/**
+ * @file kv_store_template.c
+ * @brief 日志结构键值存储模板文件
+ * @description 在Flash抽象层上实现追加写入的键值存储，用于保存ADC零偏、编码器零位、
+ *              辨识得到的电机参数与整定后的PID增益：记录带CRC与提交标记，掉电不损坏已有数据；
+ *              扇区按环形轮转擦除实现磨损均衡；上电扫描一次建立按键直接索引的RAM表，
+ *              之后读取为O(1)；定义KV_FLASH_POSIX后提供Linux文件模拟Flash
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+/* ==================== 宏定义 ==================== */
+
+#define KV_KEY_MAX                 64          // 键数量上限（键为0~KV_KEY_MAX-1）
+#define KV_VALUE_MAX               128         // 单个值最大字节数
+#define KV_SECTOR_MAX              16          // 支持的最大扇区数
+#define KV_SECTOR_MAGIC            0x4B565331UL  // 扇区头标识 "KVS1"
+#define KV_RECORD_COMMIT           0x5AA5C33CUL  // 记录提交标记（擦除态为0xFFFFFFFF）
+#define KV_ERASED_WORD             0xFFFFFFFFUL  // 擦除态的字
+#define KV_ADDR_NONE               0xFFFFFFFFUL  // 索引中表示键不存在
+
+#define KV_ALIGN4(n)               (((n) + 3U) & ~3U)
+#define KV_RECORD_MAX              (sizeof(kv_record_hdr_t) + KV_VALUE_MAX)  // 单条记录最大字节数
+
+/* ==================== 类型定义 ==================== */
+
+/**
+ * @brief 存储错误码枚举
+ */
+typedef enum {
+    KV_OK = 0,                     /**< 成功 */
+    KV_ERROR_NULL_PTR,             /**< 空指针错误 */
+    KV_ERROR_INVALID_PARAM,        /**< 无效参数（键越界、长度超限） */
+    KV_ERROR_NOT_FOUND,            /**< 键不存在 */
+    KV_ERROR_NO_SPACE,             /**< 有效数据超过单扇区容量，无法回收 */
+    KV_ERROR_FLASH,                /**< Flash操作失败 */
+    KV_ERROR_CRC                   /**< 记录校验失败 */
+} kv_error_t;
+
+/**
+ * @brief Flash抽象结构体
+ * @note  program只能把位从1写为0，地址与长度按4字节对齐；erase把整个扇区恢复为0xFF
+ */
+typedef struct {
+    uint8_t (*read)(void *ctx, uint32_t addr, void *buf, uint32_t len);
+    uint8_t (*program)(void *ctx, uint32_t addr, const void *buf, uint32_t len);
+    uint8_t (*erase)(void *ctx, uint8_t sector);
+    uint32_t sector_size;          /**< 扇区大小（字节） */
+    uint8_t sector_num;            /**< 扇区数量（至少2个） */
+    void *ctx;                     /**< 平台上下文 */
+} kv_flash_t;
+
+/**
+ * @brief 扇区头结构体
+ * @note  seq按打开顺序递增，上电时据此确定扇区新旧；crc覆盖前三个字段
+ */
+typedef struct {
+    uint32_t magic;                /**< 扇区标识 */
+    uint32_t seq;                  /**< 扇区序号 */
+    uint32_t erase_count;          /**< 擦除次数 */
+    uint32_t crc;                  /**< 扇区头CRC */
+} kv_sector_hdr_t;
+
+/**
+ * @brief 记录头结构体
+ * @note  先写入键、长度、CRC与数据，最后单独写入提交标记；
+ *        提交标记未写入的记录视为掉电中断的残留记录
+ */
+typedef struct {
+    uint32_t commit;               /**< 提交标记 */
+    uint16_t key;                  /**< 键 */
+    uint16_t len;                  /**< 值长度 */
+    uint32_t crc;                  /**< 覆盖键、长度与值的CRC */
+} kv_record_hdr_t;
+
+/**
+ * @brief 索引项结构体
+ */
+typedef struct {
+    uint32_t addr;                 /**< 记录地址，KV_ADDR_NONE表示不存在 */
+    uint16_t len;                  /**< 值长度 */
+} kv_index_t;
+
+/**
+ * @brief 存储统计结构体
+ */
+typedef struct {
+    uint32_t records_scanned;      /**< 上电扫描的记录数 */
+    uint32_t records_torn;         /**< 扫描发现的未提交或校验失败记录数 */
+    uint32_t writes;               /**< 写入记录数 */
+    uint32_t writes_skipped;       /**< 值未变化而跳过的写入数 */
+    uint32_t gc_runs;              /**< 扇区回收次数 */
+    uint32_t erase_min;            /**< 各扇区擦除次数最小值 */
+    uint32_t erase_max;            /**< 各扇区擦除次数最大值 */
+} kv_stats_t;
+
+/* === 前向声明 === */
+
+typedef struct kv_store_t kv_store_t;
+
+/* === 函数指针类型定义 === */
+
+/**
+ * @brief 读取值函数指针类型
+ * @param len 输入为期望长度，须与存储的值长度一致；不一致时返回KV_ERROR_INVALID_PARAM并输出存储长度
+ */
+typedef kv_error_t (*kv_get_fn)(kv_store_t *store, uint16_t key, void *buf, uint16_t *len);
+
+/**
+ * @brief 写入值函数指针类型
+ */
+typedef kv_error_t (*kv_set_fn)(kv_store_t *store, uint16_t key, const void *data, uint16_t len);
+
+/**
+ * @brief 键值存储结构体
+ */
+struct kv_store_t {
+    /* 配置 */
+    const kv_flash_t *flash;                   /**< Flash抽象 */
+
+    /* 运行状态 */
+    kv_index_t index[KV_KEY_MAX];              /**< 按键直接索引 */
+    uint32_t sector_seq[KV_SECTOR_MAX];        /**< 各扇区序号，0表示空闲 */
+    uint32_t erase_count[KV_SECTOR_MAX];       /**< 各扇区擦除次数 */
+    uint8_t head;                              /**< 当前写入扇区 */
+    uint32_t head_offset;                      /**< 当前写入扇区内的写入位置 */
+    uint32_t next_seq;                         /**< 下一个扇区序号 */
+    kv_stats_t stats;                          /**< 统计 */
+
+    /* 函数指针 - 操作方法 */
+    kv_get_fn get;                             /**< 读取值 */
+    kv_set_fn set;                             /**< 写入值 */
+};
+
+/* ==================== 静态函数声明 ==================== */
+
+static kv_error_t kv_impl_get(kv_store_t *store, uint16_t key, void *buf, uint16_t *len);
+static kv_error_t kv_impl_set(kv_store_t *store, uint16_t key, const void *data, uint16_t len);
+static uint32_t kv_crc32(uint32_t crc, const uint8_t *data, uint32_t len);
+static uint32_t kv_record_crc(uint16_t key, uint16_t len, const uint8_t *data);
+static kv_error_t kv_append(kv_store_t *store, uint16_t key, const void *data, uint16_t len);
+static uint32_t kv_live_size(const kv_store_t *store, uint8_t sector);
+static kv_error_t kv_open_sector(kv_store_t *store, uint8_t sector);
+static kv_error_t kv_gc_sector(kv_store_t *store, uint8_t sector);
+static kv_error_t kv_advance(kv_store_t *store);
+static void kv_scan_sector(kv_store_t *store, uint8_t sector, uint32_t *free_offset);
+
+/* ==================== 静态函数实现 ==================== */
+
+/**
+ * @brief 计算CRC-32（多项式0xEDB88320，可分段累加）
+ * @param crc  初值（首段传0）
+ * @param data 数据指针
+ * @param len  数据长度
+ * @return CRC值
+ */
+static uint32_t kv_crc32(uint32_t crc, const uint8_t *data, uint32_t len) {
+    uint8_t bit;
+
+    crc = ~crc;
+    while (len--) {
+        crc ^= *data++;
+        for (bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0U - (crc & 1U)));
+        }
+    }
+    return ~crc;
+}
+
+/**
+ * @brief 计算记录CRC
+ * @param key  键
+ * @param len  值长度
+ * @param data 值
+ * @return CRC值
+ */
+static uint32_t kv_record_crc(uint16_t key, uint16_t len, const uint8_t *data) {
+    uint16_t hdr[2] = { key, len };
+
+    return kv_crc32(kv_crc32(0, (const uint8_t *)hdr, sizeof(hdr)), data, len);
+}
+
+/**
+ * @brief 统计扇区内仍有效（被索引引用）的记录占用的字节数
+ * @param store  存储结构体指针
+ * @param sector 扇区编号
+ * @return 搬运这些记录所需的字节数，0表示扇区内没有有效记录
+ */
+static uint32_t kv_live_size(const kv_store_t *store, uint8_t sector) {
+    uint32_t base = (uint32_t)sector * store->flash->sector_size;
+    uint32_t need = 0;
+    uint16_t key;
+
+    for (key = 0; key < KV_KEY_MAX; key++) {
+        if (store->index[key].addr != KV_ADDR_NONE &&
+            store->index[key].addr - base < store->flash->sector_size) {
+            need += sizeof(kv_record_hdr_t) + KV_ALIGN4(store->index[key].len);
+        }
+    }
+    return need;
+}
+
+/**
+ * @brief 擦除扇区并写入扇区头，使其成为写入扇区
+ * @param store  存储结构体指针
+ * @param sector 扇区编号
+ * @return 错误码
+ * @note   扇区内仍有有效记录时拒绝擦除，返回KV_ERROR_NO_SPACE
+ */
+static kv_error_t kv_open_sector(kv_store_t *store, uint8_t sector) {
+    const kv_flash_t *fl = store->flash;
+    kv_sector_hdr_t hdr;
+
+    if (kv_live_size(store, sector) != 0) {
+        return KV_ERROR_NO_SPACE;
+    }
+    if (fl->erase(fl->ctx, sector) != 0) {
+        return KV_ERROR_FLASH;
+    }
+    store->erase_count[sector]++;
+
+    hdr.magic = KV_SECTOR_MAGIC;
+    hdr.seq = store->next_seq++;
+    hdr.erase_count = store->erase_count[sector];
+    hdr.crc = kv_crc32(0, (const uint8_t *)&hdr, offsetof(kv_sector_hdr_t, crc));
+    if (fl->program(fl->ctx, (uint32_t)sector * fl->sector_size, &hdr, sizeof(hdr)) != 0) {
+        return KV_ERROR_FLASH;
+    }
+
+    store->sector_seq[sector] = hdr.seq;
+    store->head = sector;
+    store->head_offset = sizeof(kv_sector_hdr_t);
+    return KV_OK;
+}
+
+/**
+ * @brief 在写入扇区末尾追加一条记录
+ * @param store 存储结构体指针
+ * @param key   键
+ * @param data  值
+ * @param len   值长度
+ * @return 错误码
+ * @note   调用方保证写入扇区剩余空间足够；提交标记最后写入
+ */
+static kv_error_t kv_append(kv_store_t *store, uint16_t key, const void *data, uint16_t len) {
+    const kv_flash_t *fl = store->flash;
+    uint32_t buf[(sizeof(kv_record_hdr_t) + KV_VALUE_MAX) / 4];
+    kv_record_hdr_t *hdr = (kv_record_hdr_t *)buf;
+    uint32_t addr = (uint32_t)store->head * fl->sector_size + store->head_offset;
+    uint32_t size = sizeof(kv_record_hdr_t) + KV_ALIGN4(len);
+    uint32_t commit = KV_RECORD_COMMIT;
+
+    memset(buf, 0xFF, size);
+    hdr->commit = KV_ERASED_WORD;
+    hdr->key = key;
+    hdr->len = len;
+    hdr->crc = kv_record_crc(key, len, (const uint8_t *)data);
+    memcpy(hdr + 1, data, len);
+
+    // 写入位置先前移：即使本次写入失败，后续记录也不会覆盖半写区域
+    store->head_offset += size;
+    if (fl->program(fl->ctx, addr, buf, size) != 0 ||
+        fl->program(fl->ctx, addr, &commit, sizeof(commit)) != 0) {
+        return KV_ERROR_FLASH;
+    }
+
+    store->index[key].addr = addr;
+    store->index[key].len = len;
+    return KV_OK;
+}
+
+/**
+ * @brief 回收扇区：把其中仍有效的记录搬到写入扇区后擦除
+ * @param store  存储结构体指针
+ * @param sector 待回收扇区（最旧扇区）
+ * @return 错误码
+ * @note   先搬运后擦除，中途掉电时新旧扇区同时存在相同记录，上电按扇区序号取新者；
+ *         搬运失败时不擦除，扇区内仍被索引引用的记录保持可读
+ */
+static kv_error_t kv_gc_sector(kv_store_t *store, uint8_t sector) {
+    const kv_flash_t *fl = store->flash;
+    uint8_t value[KV_VALUE_MAX];
+    uint32_t base = (uint32_t)sector * fl->sector_size;
+    kv_error_t ret;
+    uint16_t key;
+
+    // 有效记录必须能放进写入扇区剩余空间
+    if (store->head_offset + kv_live_size(store, sector) > fl->sector_size) {
+        return KV_ERROR_NO_SPACE;
+    }
+
+    for (key = 0; key < KV_KEY_MAX; key++) {
+        if (store->index[key].addr == KV_ADDR_NONE || store->index[key].addr - base >= fl->sector_size) {
+            continue;
+        }
+        if (fl->read(fl->ctx, store->index[key].addr + sizeof(kv_record_hdr_t), value,
+                     store->index[key].len) != 0) {
+            return KV_ERROR_FLASH;
+        }
+        ret = kv_append(store, key, value, store->index[key].len);
+        if (ret != KV_OK) {
+            return ret;
+        }
+    }
+
+    // 全部有效记录已搬出（索引不再指向本扇区）后才擦除
+    if (kv_live_size(store, sector) != 0) {
+        return KV_ERROR_NO_SPACE;
+    }
+    if (fl->erase(fl->ctx, sector) != 0) {
+        return KV_ERROR_FLASH;
+    }
+    store->erase_count[sector]++;
+    store->sector_seq[sector] = 0;
+    store->stats.gc_runs++;
+    return KV_OK;
+}
+
+/**
+ * @brief 切换到下一个扇区
+ * @param store 存储结构体指针
+ * @return 错误码
+ * @note   扇区按环形顺序使用，每个扇区被擦除的次数相同（磨损均衡）；
+ *         切换后若再下一个扇区存有数据（最旧扇区），立即回收，始终保留一个空闲扇区。
+ *         切换前先确认新扇区放得下最旧扇区的有效记录，另留一条最大记录的余量
+ *         （不小于待写入记录；回收中掉电留下的残留记录上电后按最大记录跳过，余量保证
+ *         上电后仍能完成回收），放不下时返回KV_ERROR_NO_SPACE，写入扇区与所有扇区内容保持不变
+ */
+static kv_error_t kv_advance(kv_store_t *store) {
+    const kv_flash_t *fl = store->flash;
+    uint8_t n = fl->sector_num;
+    uint8_t next = (uint8_t)((store->head + 1U) % n);
+    uint8_t oldest = (uint8_t)((next + 1U) % n);
+    uint32_t need = 0;
+    kv_error_t ret;
+
+    // 上次回收未完成（写入扇区之后仍有有效记录）：先搬到当前写入扇区，失败则不切换
+    if (kv_live_size(store, next) != 0) {
+        ret = kv_gc_sector(store, next);
+        if (ret != KV_OK) {
+            return ret;
+        }
+    }
+
+    if (oldest != next && store->sector_seq[oldest] != 0) {
+        need = kv_live_size(store, oldest);
+    }
+    if (sizeof(kv_sector_hdr_t) + need + KV_RECORD_MAX > fl->sector_size) {
+        return KV_ERROR_NO_SPACE;
+    }
+
+    ret = kv_open_sector(store, next);
+    if (ret != KV_OK) {
+        return ret;
+    }
+    if (oldest != next && store->sector_seq[oldest] != 0) {
+        return kv_gc_sector(store, oldest);
+    }
+    return KV_OK;
+}
+
+/**
+ * @brief 扫描扇区内的记录并更新索引
+ * @param store       存储结构体指针
+ * @param sector      扇区编号
+ * @param free_offset 输出扇区内第一个空闲位置
+ * @note   提交标记缺失或CRC错误的记录跳过；长度字段未写完整（掉电发生在写长度之前）时
+ *         无法得知实际长度，该记录必为当时最后一次写入且不超过KV_RECORD_MAX，
+ *         按最大记录跳过：上电后在其后继续追加，下次扫描按同一规则越过它
+ */
+static void kv_scan_sector(kv_store_t *store, uint8_t sector, uint32_t *free_offset) {
+    const kv_flash_t *fl = store->flash;
+    uint8_t value[KV_VALUE_MAX];
+    uint32_t base = (uint32_t)sector * fl->sector_size;
+    uint32_t off = sizeof(kv_sector_hdr_t);
+    kv_record_hdr_t hdr;
+
+    while (off + sizeof(kv_record_hdr_t) <= fl->sector_size) {
+        if (fl->read(fl->ctx, base + off, &hdr, sizeof(hdr)) != 0) {
+            break;
+        }
+        if (hdr.commit == KV_ERASED_WORD && hdr.key == 0xFFFFU && hdr.len == 0xFFFFU &&
+            hdr.crc == KV_ERASED_WORD) {
+            *free_offset = off;
+            return;
+        }
+        if (hdr.len > KV_VALUE_MAX ||
+            off + sizeof(kv_record_hdr_t) + KV_ALIGN4(hdr.len) > fl->sector_size) {
+            store->stats.records_torn++;
+            off += KV_RECORD_MAX;
+            continue;
+        }
+
+        store->stats.records_scanned++;
+        if (hdr.commit != KV_RECORD_COMMIT || hdr.key >= KV_KEY_MAX ||
+            fl->read(fl->ctx, base + off + sizeof(hdr), value, hdr.len) != 0 ||
+            kv_record_crc(hdr.key, hdr.len, value) != hdr.crc) {
+            store->stats.records_torn++;
+        } else {
+            store->index[hdr.key].addr = base + off;
+            store->index[hdr.key].len = hdr.len;
+        }
+        off += sizeof(kv_record_hdr_t) + KV_ALIGN4(hdr.len);
+    }
+
+    *free_offset = fl->sector_size;
+}
+
+/**
+ * @brief 读取值实现函数
+ * @param store 存储结构体指针
+ * @param key   键
+ * @param buf   输出缓冲区
+ * @param len   输入为期望长度，输出为存储的值长度
+ * @return 错误码
+ * @note   索引直接定位记录，一次Flash读取；长度不一致（结构体版本变化等）时不读取，
+ *         返回KV_ERROR_INVALID_PARAM，调用方不会拿到只填了一部分的缓冲区
+ */
+static kv_error_t kv_impl_get(kv_store_t *store, uint16_t key, void *buf, uint16_t *len) {
+    const kv_index_t *idx;
+
+    if (store == NULL || buf == NULL || len == NULL) {
+        return KV_ERROR_NULL_PTR;
+    }
+    if (key >= KV_KEY_MAX) {
+        return KV_ERROR_INVALID_PARAM;
+    }
+
+    idx = &store->index[key];
+    if (idx->addr == KV_ADDR_NONE) {
+        return KV_ERROR_NOT_FOUND;
+    }
+    if (idx->len != *len) {
+        *len = idx->len;
+        return KV_ERROR_INVALID_PARAM;
+    }
+
+    if (store->flash->read(store->flash->ctx, idx->addr + sizeof(kv_record_hdr_t), buf,
+                           idx->len) != 0) {
+        return KV_ERROR_FLASH;
+    }
+    *len = idx->len;
+    return KV_OK;
+}
+
+/**
+ * @brief 写入值实现函数
+ * @param store 存储结构体指针
+ * @param key   键
+ * @param data  值
+ * @param len   值长度
+ * @return 错误码
+ * @note   值与当前记录相同时不写入，减少擦写
+ */
+static kv_error_t kv_impl_set(kv_store_t *store, uint16_t key, const void *data, uint16_t len) {
+    uint8_t old[KV_VALUE_MAX];
+    uint16_t old_len = len;
+    uint32_t need;
+    kv_error_t ret;
+
+    if (store == NULL || data == NULL) {
+        return KV_ERROR_NULL_PTR;
+    }
+    if (key >= KV_KEY_MAX || len > KV_VALUE_MAX) {
+        return KV_ERROR_INVALID_PARAM;
+    }
+
+    if (kv_impl_get(store, key, old, &old_len) == KV_OK &&
+        memcmp(old, data, len) == 0) {
+        store->stats.writes_skipped++;
+        return KV_OK;
+    }
+
+    need = sizeof(kv_record_hdr_t) + KV_ALIGN4(len);
+    if (store->head_offset + need > store->flash->sector_size) {
+        ret = kv_advance(store);
+        if (ret != KV_OK) {
+            return ret;
+        }
+    }
+
+    ret = kv_append(store, key, data, len);
+    if (ret == KV_OK) {
+        store->stats.writes++;
+    }
+    return ret;
+}
+
+/* ==================== 公共函数实现 ==================== */
+
+/**
+ * @brief 键值存储初始化（挂载）函数
+ * @param store 存储结构体指针
+ * @param flash Flash抽象指针
+ * @return 错误码
+ * @note   按扇区序号从旧到新扫描一次，后写入的记录覆盖先写入的记录，
+ *         扫描完成后索引即为每个键的最新有效值；空Flash自动格式化
+ */
+kv_error_t kv_store_init(kv_store_t *store, const kv_flash_t *flash) {
+    kv_sector_hdr_t hdr;
+    uint8_t order[KV_SECTOR_MAX];
+    uint8_t valid = 0;
+    uint8_t oldest;
+    uint32_t free_offset = 0;
+    uint32_t erase_max = 0;
+    uint8_t i, j;
+
+    // 检查指针有效性
+    if (store == NULL || flash == NULL || flash->read == NULL || flash->program == NULL ||
+        flash->erase == NULL) {
+        return KV_ERROR_NULL_PTR;
+    }
+    if (flash->sector_num < 2 || flash->sector_num > KV_SECTOR_MAX ||
+        flash->sector_size < sizeof(kv_sector_hdr_t) + sizeof(kv_record_hdr_t) + KV_VALUE_MAX) {
+        return KV_ERROR_INVALID_PARAM;
+    }
+
+    store->flash = flash;
+    store->next_seq = 1;
+    store->stats = (kv_stats_t){0};
+    for (i = 0; i < KV_KEY_MAX; i++) {
+        store->index[i].addr = KV_ADDR_NONE;
+        store->index[i].len = 0;
+    }
+
+    // 读取扇区头，按序号插入排序
+    for (i = 0; i < flash->sector_num; i++) {
+        store->sector_seq[i] = 0;
+        store->erase_count[i] = 0;
+        if (flash->read(flash->ctx, (uint32_t)i * flash->sector_size, &hdr, sizeof(hdr)) != 0) {
+            return KV_ERROR_FLASH;
+        }
+        if (hdr.magic != KV_SECTOR_MAGIC ||
+            hdr.crc != kv_crc32(0, (const uint8_t *)&hdr, offsetof(kv_sector_hdr_t, crc))) {
+            continue;
+        }
+        store->sector_seq[i] = hdr.seq;
+        store->erase_count[i] = hdr.erase_count;
+        if (hdr.seq >= store->next_seq) {
+            store->next_seq = hdr.seq + 1U;
+        }
+        for (j = valid; j > 0 && store->sector_seq[order[j - 1]] > hdr.seq; j--) {
+            order[j] = order[j - 1];
+        }
+        order[j] = i;
+        valid++;
+    }
+
+    // 空闲扇区的头已被擦除，擦除次数取有效扇区中的最大值（环形轮转下各扇区相差不超过1轮）
+    for (i = 0; i < valid; i++) {
+        if (store->erase_count[order[i]] > erase_max) {
+            erase_max = store->erase_count[order[i]];
+        }
+    }
+    for (i = 0; i < flash->sector_num; i++) {
+        if (store->sector_seq[i] == 0) {
+            store->erase_count[i] = erase_max;
+        }
+    }
+
+    // 绑定函数指针（面向对象核心）
+    store->get = kv_impl_get;
+    store->set = kv_impl_set;
+
+    if (valid == 0) {
+        return kv_open_sector(store, 0);
+    }
+
+    for (i = 0; i < valid; i++) {
+        kv_scan_sector(store, order[i], &free_offset);
+    }
+    store->head = order[valid - 1];
+    store->head_offset = free_offset;
+
+    // 上次回收被掉电打断时，在此完成回收，恢复“写入扇区之后为空闲扇区”的约束
+    oldest = (uint8_t)((store->head + 1U) % flash->sector_num);
+    if (valid > 1 && store->sector_seq[oldest] != 0) {
+        return kv_gc_sector(store, oldest);
+    }
+
+    return KV_OK;
+}
+
+/**
+ * @brief 获取存储统计
+ * @param store 存储结构体指针
+ * @param stats 统计输出指针
+ * @return 错误码
+ */
+kv_error_t kv_store_get_stats(kv_store_t *store, kv_stats_t *stats) {
+    uint8_t i;
+
+    if (store == NULL || stats == NULL) {
+        return KV_ERROR_NULL_PTR;
+    }
+
+    *stats = store->stats;
+    stats->erase_min = UINT32_MAX;
+    stats->erase_max = 0;
+    for (i = 0; i < store->flash->sector_num; i++) {
+        if (store->erase_count[i] < stats->erase_min) {
+            stats->erase_min = store->erase_count[i];
+        }
+        if (store->erase_count[i] > stats->erase_max) {
+            stats->erase_max = store->erase_count[i];
+        }
+    }
+
+    return KV_OK;
+}
+
+/* ==================== Linux文件模拟Flash ==================== */
+
+#ifdef KV_FLASH_POSIX
+
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief 文件模拟Flash上下文结构体
+ */
+typedef struct {
+    int fd;                        /**< 后备文件 */
+    uint32_t sector_size;          /**< 扇区大小 */
+    int32_t fail_after;            /**< 剩余可成功编程的字节数，-1表示不注入掉电 */
+} kv_posix_flash_t;
+
+/**
+ * @brief 读取
+ */
+static uint8_t kv_posix_read(void *ctx, uint32_t addr, void *buf, uint32_t len) {
+    kv_posix_flash_t *pf = (kv_posix_flash_t *)ctx;
+
+    return (pread(pf->fd, buf, len, addr) == (ssize_t)len) ? 0 : 1;
+}
+
+/**
+ * @brief 编程：新内容与原内容按位与，模拟Flash只能把1写为0
+ * @note   fail_after耗尽时只写入前面部分字节后返回失败，用于模拟掉电
+ */
+static uint8_t kv_posix_program(void *ctx, uint32_t addr, const void *buf, uint32_t len) {
+    kv_posix_flash_t *pf = (kv_posix_flash_t *)ctx;
+    const uint8_t *src = (const uint8_t *)buf;
+    uint8_t cell[KV_VALUE_MAX + sizeof(kv_record_hdr_t)];
+    uint32_t n = len;
+    uint32_t i;
+
+    if (len > sizeof(cell)) {
+        return 1;
+    }
+    if (pf->fail_after >= 0 && (uint32_t)pf->fail_after < len) {
+        n = (uint32_t)pf->fail_after;
+    }
+    if (pread(pf->fd, cell, n, addr) != (ssize_t)n) {
+        return 1;
+    }
+    for (i = 0; i < n; i++) {
+        cell[i] &= src[i];
+    }
+    if (pwrite(pf->fd, cell, n, addr) != (ssize_t)n) {
+        return 1;
+    }
+
+    if (pf->fail_after >= 0) {
+        pf->fail_after -= (int32_t)n;
+        if (n < len) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 擦除扇区
+ */
+static uint8_t kv_posix_erase(void *ctx, uint8_t sector) {
+    kv_posix_flash_t *pf = (kv_posix_flash_t *)ctx;
+    uint8_t blank[256];
+    uint32_t base = (uint32_t)sector * pf->sector_size;
+    uint32_t off;
+
+    if (pf->fail_after == 0) {
+        return 1;
+    }
+    memset(blank, 0xFF, sizeof(blank));
+    for (off = 0; off < pf->sector_size; off += sizeof(blank)) {
+        if (pwrite(pf->fd, blank, sizeof(blank), base + off) != (ssize_t)sizeof(blank)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 打开文件模拟Flash
+ * @param pf          上下文指针
+ * @param flash       Flash抽象输出指针
+ * @param path        后备文件路径，不存在或长度不足时初始化为全0xFF
+ * @param sector_size 扇区大小（256的整数倍）
+ * @param sector_num  扇区数量
+ * @return 0表示成功，非0表示失败
+ */
+uint8_t kv_posix_flash_open(kv_posix_flash_t *pf, kv_flash_t *flash, const char *path,
+                            uint32_t sector_size, uint8_t sector_num) {
+    uint8_t i;
+
+    if (pf == NULL || flash == NULL || path == NULL || sector_size % 256U != 0) {
+        return 1;
+    }
+
+    pf->sector_size = sector_size;
+    pf->fail_after = -1;
+    pf->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (pf->fd < 0) {
+        return 1;
+    }
+
+    flash->read = kv_posix_read;
+    flash->program = kv_posix_program;
+    flash->erase = kv_posix_erase;
+    flash->sector_size = sector_size;
+    flash->sector_num = sector_num;
+    flash->ctx = pf;
+
+    if (lseek(pf->fd, 0, SEEK_END) < (off_t)sector_size * sector_num) {
+        for (i = 0; i < sector_num; i++) {
+            if (kv_posix_erase(pf, i) != 0) {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 挂载耗时基准
+ * @param flash  已打开的Flash抽象
+ * @param rounds 重复挂载次数
+ * @return 单次挂载平均耗时（微秒）
+ * @note   文件模拟的读取经过系统调用，比片上Flash直接读取慢，结果可作为上限参考
+ */
+double kv_posix_bench_mount(const kv_flash_t *flash, uint32_t rounds) {
+    kv_store_t store;
+    struct timespec t0, t1;
+    uint32_t r;
+
+    if (flash == NULL || rounds == 0) {
+        return 0.0;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (r = 0; r < rounds; r++) {
+        if (kv_store_init(&store, flash) != KV_OK) {
+            return 0.0;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    return ((double)(t1.tv_sec - t0.tv_sec) * 1e6 + (double)(t1.tv_nsec - t0.tv_nsec) / 1e3) / rounds;
+}
+
+#define KV_FUZZ_KEYS               8           // 掉电测试使用的键数
+#define KV_FUZZ_LEN_MAX            64          // 掉电测试值的最大长度
+#define KV_FUZZ_CUT_RATE           10          // 平均每多少次写入注入一次掉电
+#define KV_FUZZ_CUT_BYTES          200         // 掉电前最多还能落盘的字节数
+
+/**
+ * @brief 掉电测试结果结构体
+ */
+typedef struct {
+    uint32_t ops;                  /**< 写入次数 */
+    uint32_t cuts;                 /**< 注入的掉电次数 */
+    uint32_t no_space;             /**< 返回KV_ERROR_NO_SPACE的写入次数（应为0） */
+    uint32_t mount_errors;         /**< 掉电后重新挂载失败次数（应为0） */
+    uint32_t lost;                 /**< 重新挂载后值既非最后确认值也非被打断的新值的次数（应为0） */
+} kv_fuzz_result_t;
+
+/**
+ * @brief 掉电随机测试（回归测试）
+ * @param path        后备文件路径（会被重建）
+ * @param sector_size 扇区大小
+ * @param sector_num  扇区数量
+ * @param ops         写入次数
+ * @param seed        随机种子
+ * @param result      结果输出指针
+ * @return 0表示测试执行完毕（结果见result），非0表示无法打开模拟Flash
+ * @note   随机键与随机长度的写入中随机注入掉电（掉电点可落在普通写入、回收搬运与擦除中），
+ *         每次掉电后重新挂载并与参照模型逐键比对；有效数据总量远小于单扇区容量，
+ *         任何KV_ERROR_NO_SPACE都说明掉电使存储卡死
+ */
+uint8_t kv_posix_fuzz_power_cut(const char *path, uint32_t sector_size, uint8_t sector_num,
+                                uint32_t ops, uint32_t seed, kv_fuzz_result_t *result) {
+    static uint8_t model[KV_FUZZ_KEYS][KV_FUZZ_LEN_MAX];
+    static uint16_t model_len[KV_FUZZ_KEYS];
+    uint8_t value[KV_FUZZ_LEN_MAX], got[KV_FUZZ_LEN_MAX];
+    kv_posix_flash_t pf;
+    kv_flash_t flash;
+    kv_store_t store;
+    uint32_t rnd = (seed != 0) ? seed : 1U;
+    uint32_t op, i;
+    uint16_t key, len, got_len;
+    bool is_cut;
+    kv_error_t ret;
+
+// xorshift32伪随机数
+#define KV_FUZZ_RAND()  (rnd ^= rnd << 13, rnd ^= rnd >> 17, rnd ^= rnd << 5, rnd)
+
+    if (path == NULL || result == NULL) {
+        return 1;
+    }
+    *result = (kv_fuzz_result_t){0};
+    memset(model_len, 0, sizeof(model_len));
+
+    unlink(path);
+    if (kv_posix_flash_open(&pf, &flash, path, sector_size, sector_num) != 0) {
+        return 1;
+    }
+    if (kv_store_init(&store, &flash) != KV_OK) {
+        close(pf.fd);
+        return 1;
+    }
+
+    for (op = 0; op < ops; op++) {
+        key = (uint16_t)(KV_FUZZ_RAND() % KV_FUZZ_KEYS);
+        len = (uint16_t)(1U + KV_FUZZ_RAND() % KV_FUZZ_LEN_MAX);
+        for (i = 0; i < len; i++) {
+            value[i] = (uint8_t)KV_FUZZ_RAND();
+        }
+        is_cut = (KV_FUZZ_RAND() % KV_FUZZ_CUT_RATE) == 0;
+        if (is_cut) {
+            pf.fail_after = (int32_t)(KV_FUZZ_RAND() % KV_FUZZ_CUT_BYTES);
+            result->cuts++;
+        }
+
+        ret = store.set(&store, key, value, len);
+        result->ops++;
+        if (ret == KV_ERROR_NO_SPACE) {
+            result->no_space++;
+        }
+        if (ret == KV_OK) {
+            memcpy(model[key], value, len);
+            model_len[key] = len;
+        }
+        if (!is_cut) {
+            continue;
+        }
+
+        // 重新上电：挂载后被打断的键可能是旧值或新值，其余键必须是最后确认值
+        pf.fail_after = -1;
+        if (kv_store_init(&store, &flash) != KV_OK) {
+            result->mount_errors++;
+        }
+        for (i = 0; i < KV_FUZZ_KEYS; i++) {
+            if (model_len[i] == 0) {
+                continue;
+            }
+            got_len = model_len[i];
+            ret = store.get(&store, (uint16_t)i, got, &got_len);
+            if (ret == KV_OK && memcmp(got, model[i], model_len[i]) == 0) {
+                continue;
+            }
+            got_len = len;
+            if (i == key && store.get(&store, key, got, &got_len) == KV_OK &&
+                memcmp(got, value, len) == 0) {
+                memcpy(model[key], value, len);
+                model_len[key] = len;
+                continue;
+            }
+            result->lost++;
+        }
+    }
+
+#undef KV_FUZZ_RAND
+
+    close(pf.fd);
+    return 0;
+}
+
+#endif /* KV_FLASH_POSIX */
+
+/* ==================== 使用示例 ==================== */
+
+/*
+ * 使用示例：
+ *
+ * // 片上Flash端口：STM32F4扇区擦除/字编程，选用两个以上同尺寸扇区
+ * static uint8_t flash_read(void *ctx, uint32_t addr, void *buf, uint32_t len) {
+ *     memcpy(buf, (const void *)(KV_FLASH_BASE + addr), len);
+ *     return 0;
+ * }
+ * static uint8_t flash_program(void *ctx, uint32_t addr, const void *buf, uint32_t len) {
+ *     // HAL_FLASH_Unlock(); 逐字 HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, ...); HAL_FLASH_Lock();
+ *     return 0;
+ * }
+ * static uint8_t flash_erase(void *ctx, uint8_t sector) {
+ *     // HAL_FLASHEx_Erase(&(FLASH_EraseInitTypeDef){ .Sector = KV_FIRST_SECTOR + sector, ... }, &err);
+ *     return 0;
+ * }
+ *
+ * static const kv_flash_t param_flash = {
+ *     .read = flash_read, .program = flash_program, .erase = flash_erase,
+ *     .sector_size = 16 * 1024, .sector_num = 2, .ctx = NULL,
+ * };
+ * static kv_store_t param_store;
+ *
+ * // 电机驱动通过回调访问存储，键由驱动定义（MOTOR_PARAM_KEY_xxx）
+ * static uint8_t param_load(uint16_t key, void *buf, uint16_t len) {
+ *     uint16_t got = len;
+ *     return (param_store.get(&param_store, key, buf, &got) == KV_OK && got == len) ? 0 : 1;
+ * }
+ * static uint8_t param_save(uint16_t key, const void *data, uint16_t len) {
+ *     return (param_store.set(&param_store, key, data, len) == KV_OK) ? 0 : 1;
+ * }
+ *
+ * int main(void) {
+ *     kv_store_init(&param_store, &param_flash);   // 扫描一次建立索引
+ *     motor_set_param_store(param_load, param_save);
+ *     motor_init(&foc_motor);                       // 内部调用motor_param_restore
+ *
+ *     if (!foc_motor.is_calibrated) {
+ *         // 首次上电（或存储的标定数据无效）：执行零偏与编码器零位标定，标记后保存
+ *         // 采样三相零偏写入 foc_motor.calib.adc_offset，对齐转子得到 foc_motor.encoder.offset
+ *         foc_motor.is_calibrated = true;
+ *         motor_param_save(&foc_motor);
+ *     }
+ * }
+ *
+ * 主机验证（Linux）：
+ *   gcc -std=c11 -O2 -DKV_FLASH_POSIX -D_DEFAULT_SOURCE kv_store_template.c test_main.c
+ *
+ *   kv_posix_flash_t pf;
+ *   kv_flash_t flash;
+ *   kv_posix_flash_open(&pf, &flash, "/tmp/param.bin", 4096, 4);
+ *   kv_store_init(&store, &flash);
+ *   pf.fail_after = 10;                      // 下一次写入只落盘10字节，模拟掉电
+ *   store.set(&store, 3, &gain, sizeof(gain));
+ *   kv_store_init(&store, &flash);           // 重新挂载：旧值仍可读，残留记录被跳过
+ *   kv_posix_bench_mount(&flash, 1000);      // 挂载耗时（微秒）
+ *
+ *   // 掉电随机回归测试：2扇区与4扇区各20万次写入
+ *   kv_fuzz_result_t fz;
+ *   kv_posix_fuzz_power_cut("/tmp/fuzz.bin", 1024, 2, 200000, 1, &fz);
+ *   // fz.no_space、fz.mount_errors、fz.lost 均应为0
+ */
@@ -0,0 +1,933 @@
+/**
+ * @file mmap_log_template.c
+ * @brief 内存映射二进制日志模板文件（Linux网关主机）
+ * @description 用于长时间记录传感器与电机控制数据：定长、带schema标识的记录
+ *              追加写入预分配并映射到内存的分段文件，生产者直接在映射区填写记录（零拷贝），
+ *              后台线程负责msync、分段轮换与索引写入；读取库使用相同格式，
+ *              支持按序号O(1)定位、按时间戳二分定位和顺序遍历
+ */
+
+#define _GNU_SOURCE
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* ==================== 宏定义 ==================== */
+
+#define MLOG_MAGIC                 0x474F4C4DUL        // 分段文件标识"MLOG"
+#define MLOG_VERSION               1                   // 格式版本
+#define MLOG_SEGMENT_BYTES         (64UL << 20)        // 单个分段文件大小（64MB）
+#define MLOG_SYNC_INTERVAL_MS      200                 // 后台异步刷盘周期（毫秒）
+#define MLOG_PATH_MAX              256                 // 路径最大长度
+#define MLOG_INDEX_FILE            "index.mlog"        // 分段索引文件名
+#define MLOG_SEGMENT_FMT           "%s/seg_%08llu.mlog" // 分段文件名格式
+
+/* ==================== 类型定义 ==================== */
+
+/**
+ * @brief 日志错误码枚举
+ */
+typedef enum {
+    MLOG_OK = 0,                   /**< 成功 */
+    MLOG_ERROR_NULL_PTR,           /**< 空指针错误 */
+    MLOG_ERROR_INVALID_PARAM,      /**< 无效参数 */
+    MLOG_ERROR_IO,                 /**< 文件或映射操作失败 */
+    MLOG_ERROR_FORMAT,             /**< 文件格式或schema不匹配 */
+    MLOG_ERROR_NOT_FOUND           /**< 未找到记录 */
+} mlog_error_t;
+
+/**
+ * @brief 分段文件头结构体（64字节，位于每个分段文件起始处）
+ * @note  record_count由生产者以release语义更新，读者可安全读取正在写入的分段
+ */
+typedef struct {
+    uint32_t magic;                /**< 标识 */
+    uint32_t version;              /**< 格式版本 */
+    uint32_t schema_id;            /**< 记录schema标识 */
+    uint32_t record_size;          /**< 记录大小（含记录头） */
+    uint64_t segment_no;           /**< 分段编号 */
+    uint64_t first_seq;            /**< 首条记录序号 */
+    _Atomic uint64_t record_count; /**< 已提交记录数 */
+    uint8_t reserved[24];          /**< 保留，补齐到64字节 */
+} mlog_segment_header_t;
+
+/**
+ * @brief 记录头结构体（每条记录起始处）
+ */
+typedef struct {
+    uint64_t seq;                  /**< 全局记录序号 */
+    uint64_t timestamp_ns;         /**< 时间戳（纳秒） */
+} mlog_record_header_t;
+
+/**
+ * @brief 分段索引项结构体（索引文件中按分段编号顺序追加）
+ */
+typedef struct {
+    uint64_t segment_no;           /**< 分段编号 */
+    uint64_t first_seq;            /**< 首条记录序号 */
+    uint64_t record_count;         /**< 记录数 */
+    uint64_t first_ts_ns;          /**< 首条记录时间戳 */
+    uint64_t last_ts_ns;           /**< 末条记录时间戳 */
+} mlog_index_entry_t;
+
+/**
+ * @brief 已映射分段结构体
+ */
+typedef struct {
+    int fd;                        /**< 文件描述符 */
+    uint8_t *base;                 /**< 映射基址 */
+    size_t size;                   /**< 映射大小 */
+    mlog_segment_header_t *hdr;    /**< 文件头 */
+} mlog_segment_t;
+
+/**
+ * @brief 写入统计结构体
+ */
+typedef struct {
+    uint64_t records;              /**< 已提交记录数 */
+    uint64_t rotations;            /**< 分段轮换次数 */
+    uint64_t syncs;                /**< 后台刷盘次数 */
+    uint64_t rotate_waits;         /**< 轮换时等待后台预分配的次数 */
+} mlog_stats_t;
+
+/**
+ * @brief 基准测试结果结构体
+ */
+typedef struct {
+    uint64_t records;              /**< 写入记录数 */
+    double wall_s;                 /**< 墙钟耗时（秒） */
+    double cpu_s;                  /**< 进程CPU耗时（秒，含后台线程） */
+    double records_per_s;          /**< 吞吐量（条/秒） */
+    double cpu_ns_per_record;      /**< 每条记录CPU开销（纳秒） */
+} mlog_bench_result_t;
+
+/* === 前向声明 === */
+
+typedef struct mlog_writer_t mlog_writer_t;
+typedef struct mlog_reader_t mlog_reader_t;
+
+/* === 函数指针类型定义 === */
+
+/**
+ * @brief 预留记录函数指针类型，返回映射区内的负载地址
+ */
+typedef void *(*mlog_writer_reserve_fn)(mlog_writer_t *writer, uint64_t timestamp_ns);
+
+/**
+ * @brief 提交记录函数指针类型
+ */
+typedef void (*mlog_writer_commit_fn)(mlog_writer_t *writer);
+
+/**
+ * @brief 按序号定位函数指针类型
+ */
+typedef const void *(*mlog_reader_seek_seq_fn)(mlog_reader_t *reader, uint64_t seq);
+
+/**
+ * @brief 按时间戳定位函数指针类型
+ */
+typedef const void *(*mlog_reader_seek_time_fn)(mlog_reader_t *reader, uint64_t timestamp_ns);
+
+/**
+ * @brief 顺序读取下一条记录函数指针类型
+ */
+typedef const void *(*mlog_reader_next_fn)(mlog_reader_t *reader);
+
+/**
+ * @brief 日志写入器结构体
+ * @note  单生产者；后台线程预分配下一分段并回收已写满的分段
+ */
+struct mlog_writer_t {
+    /* 配置 */
+    char dir[MLOG_PATH_MAX];       /**< 日志目录 */
+    uint32_t schema_id;            /**< 记录schema标识 */
+    uint32_t record_size;          /**< 记录大小（含记录头，8字节对齐） */
+    uint64_t capacity;             /**< 每个分段可容纳的记录数 */
+
+    /* 运行状态 */
+    mlog_segment_t cur;            /**< 当前写入分段 */
+    mlog_segment_t next;           /**< 预分配的下一分段 */
+    mlog_segment_t retire;         /**< 待回收分段 */
+    uint64_t next_segment_no;      /**< 下一个预分配的分段编号 */
+    uint64_t seq;                  /**< 下一条记录序号 */
+    uint64_t cur_count;            /**< 当前分段已写记录数 */
+    uint8_t *pending;              /**< 已预留未提交的记录 */
+    int index_fd;                  /**< 索引文件描述符 */
+    bool is_next_ready;            /**< 下一分段已就绪 */
+    bool is_retire_pending;        /**< 有待回收分段 */
+    bool is_running;               /**< 后台线程运行标志 */
+    pthread_t bg_thread;           /**< 后台线程 */
+    pthread_mutex_t lock;          /**< 保护与后台线程共享的状态 */
+    pthread_cond_t cond;           /**< 唤醒后台线程 */
+    pthread_cond_t ready_cond;     /**< 通知生产者下一分段就绪 */
+    mlog_stats_t stats;            /**< 写入统计 */
+
+    /* 函数指针 - 操作方法 */
+    mlog_writer_reserve_fn reserve;  /**< 预留记录 */
+    mlog_writer_commit_fn  commit;   /**< 提交记录 */
+};
+
+/**
+ * @brief 日志读取器结构体
+ */
+struct mlog_reader_t {
+    /* 配置 */
+    char dir[MLOG_PATH_MAX];       /**< 日志目录 */
+    uint32_t schema_id;            /**< 期望的schema标识 */
+
+    /* 运行状态 */
+    mlog_index_entry_t *index;     /**< 索引（映射自索引文件） */
+    size_t index_size;             /**< 索引映射大小 */
+    uint64_t index_num;            /**< 索引项数量 */
+    mlog_segment_t seg;            /**< 当前打开的分段 */
+    uint64_t seg_no;               /**< 当前分段编号 */
+    uint64_t pos;                  /**< 当前分段内的读取位置 */
+    bool has_seg;                  /**< 已打开分段 */
+
+    /* 函数指针 - 操作方法 */
+    mlog_reader_seek_seq_fn  seek_seq;   /**< 按序号定位 */
+    mlog_reader_seek_time_fn seek_time;  /**< 按时间戳定位 */
+    mlog_reader_next_fn      next;       /**< 顺序读取 */
+};
+
+/* ==================== 静态函数声明 ==================== */
+
+static void *mlog_writer_impl_reserve(mlog_writer_t *writer, uint64_t timestamp_ns);
+static void mlog_writer_impl_commit(mlog_writer_t *writer);
+static const void *mlog_reader_impl_seek_seq(mlog_reader_t *reader, uint64_t seq);
+static const void *mlog_reader_impl_seek_time(mlog_reader_t *reader, uint64_t timestamp_ns);
+static const void *mlog_reader_impl_next(mlog_reader_t *reader);
+static mlog_error_t mlog_segment_create(const char *dir, uint64_t segment_no, mlog_segment_t *seg);
+static mlog_error_t mlog_segment_open(const char *dir, uint64_t segment_no, mlog_segment_t *seg);
+static void mlog_segment_close(mlog_segment_t *seg);
+static void *mlog_writer_bg_main(void *arg);
+
+/* ==================== 静态函数实现 ==================== */
+
+/**
+ * @brief 创建并映射一个预分配的分段文件
+ * @param dir        日志目录
+ * @param segment_no 分段编号
+ * @param seg        分段输出指针
+ * @return 错误码
+ * @note   预先分配磁盘块，写入时不会因文件扩展产生缺页阻塞
+ */
+static mlog_error_t mlog_segment_create(const char *dir, uint64_t segment_no, mlog_segment_t *seg) {
+    char path[MLOG_PATH_MAX + 32];
+
+    snprintf(path, sizeof(path), MLOG_SEGMENT_FMT, dir, (unsigned long long)segment_no);
+    seg->fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (seg->fd < 0) {
+        return MLOG_ERROR_IO;
+    }
+    if (posix_fallocate(seg->fd, 0, MLOG_SEGMENT_BYTES) != 0) {
+        close(seg->fd);
+        return MLOG_ERROR_IO;
+    }
+
+    seg->size = MLOG_SEGMENT_BYTES;
+    seg->base = mmap(NULL, seg->size, PROT_READ | PROT_WRITE, MAP_SHARED, seg->fd, 0);
+    if (seg->base == MAP_FAILED) {
+        close(seg->fd);
+        return MLOG_ERROR_IO;
+    }
+    seg->hdr = (mlog_segment_header_t *)seg->base;
+    seg->hdr->segment_no = segment_no;
+
+    return MLOG_OK;
+}
+
+/**
+ * @brief 以只读方式映射已有分段文件
+ * @param dir        日志目录
+ * @param segment_no 分段编号
+ * @param seg        分段输出指针
+ * @return 错误码
+ */
+static mlog_error_t mlog_segment_open(const char *dir, uint64_t segment_no, mlog_segment_t *seg) {
+    char path[MLOG_PATH_MAX + 32];
+    struct stat st;
+
+    snprintf(path, sizeof(path), MLOG_SEGMENT_FMT, dir, (unsigned long long)segment_no);
+    seg->fd = open(path, O_RDONLY);
+    if (seg->fd < 0) {
+        return MLOG_ERROR_NOT_FOUND;
+    }
+    if (fstat(seg->fd, &st) != 0 || (size_t)st.st_size < sizeof(mlog_segment_header_t)) {
+        close(seg->fd);
+        return MLOG_ERROR_FORMAT;
+    }
+
+    seg->size = (size_t)st.st_size;
+    seg->base = mmap(NULL, seg->size, PROT_READ, MAP_SHARED, seg->fd, 0);
+    if (seg->base == MAP_FAILED) {
+        close(seg->fd);
+        return MLOG_ERROR_IO;
+    }
+    seg->hdr = (mlog_segment_header_t *)seg->base;
+    if (seg->hdr->magic != MLOG_MAGIC || seg->hdr->version != MLOG_VERSION) {
+        mlog_segment_close(seg);
+        return MLOG_ERROR_FORMAT;
+    }
+
+    return MLOG_OK;
+}
+
+/**
+ * @brief 解除分段映射并关闭文件
+ * @param seg 分段指针
+ */
+static void mlog_segment_close(mlog_segment_t *seg) {
+    if (seg->base != NULL && seg->base != MAP_FAILED) {
+        munmap(seg->base, seg->size);
+    }
+    if (seg->fd >= 0) {
+        close(seg->fd);
+    }
+    seg->base = NULL;
+    seg->hdr = NULL;
+    seg->fd = -1;
+}
+
+/**
+ * @brief 回收已写满的分段：同步刷盘、写索引、解除映射
+ * @param writer 写入器结构体指针
+ * @param seg    待回收分段
+ * @note   在后台线程中执行，不占用生产者时间
+ */
+static void mlog_writer_retire(mlog_writer_t *writer, mlog_segment_t *seg) {
+    mlog_index_entry_t entry;
+    const mlog_record_header_t *first;
+    const mlog_record_header_t *last;
+    uint64_t count = atomic_load_explicit(&seg->hdr->record_count, memory_order_acquire);
+
+    msync(seg->base, seg->size, MS_SYNC);
+
+    entry.segment_no = seg->hdr->segment_no;
+    entry.first_seq = seg->hdr->first_seq;
+    entry.record_count = count;
+    entry.first_ts_ns = 0;
+    entry.last_ts_ns = 0;
+    if (count > 0) {
+        first = (const mlog_record_header_t *)(seg->base + sizeof(mlog_segment_header_t));
+        last = (const mlog_record_header_t *)(seg->base + sizeof(mlog_segment_header_t) +
+                                              (count - 1) * writer->record_size);
+        entry.first_ts_ns = first->timestamp_ns;
+        entry.last_ts_ns = last->timestamp_ns;
+    }
+    if (write(writer->index_fd, &entry, sizeof(entry)) == (ssize_t)sizeof(entry)) {
+        fdatasync(writer->index_fd);
+    }
+
+    mlog_segment_close(seg);
+}
+
+/**
+ * @brief 后台线程主函数
+ * @param arg 写入器结构体指针
+ * @return NULL
+ * @note   周期性异步刷盘当前分段，回收旧分段并预分配下一分段
+ */
+static void *mlog_writer_bg_main(void *arg) {
+    mlog_writer_t *writer = (mlog_writer_t *)arg;
+    mlog_segment_t retire;
+    mlog_segment_t fresh;
+    struct timespec deadline;
+    bool is_need_next;
+    bool is_need_retire;
+    uint8_t *sync_base;
+
+    pthread_mutex_lock(&writer->lock);
+    while (writer->is_running || writer->is_retire_pending) {
+        is_need_retire = writer->is_retire_pending;
+        is_need_next = !writer->is_next_ready && writer->is_running;
+        retire = writer->retire;
+        writer->is_retire_pending = false;
+        sync_base = writer->cur.base;
+        pthread_mutex_unlock(&writer->lock);
+
+        // 以下耗时操作均在锁外执行
+        if (is_need_retire) {
+            mlog_writer_retire(writer, &retire);
+        }
+        if (is_need_next) {
+            if (mlog_segment_create(writer->dir, writer->next_segment_no, &fresh) == MLOG_OK) {
+                pthread_mutex_lock(&writer->lock);
+                writer->next = fresh;
+                writer->next_segment_no++;
+                writer->is_next_ready = true;
+                pthread_cond_signal(&writer->ready_cond);
+                pthread_mutex_unlock(&writer->lock);
+            }
+        }
+        if (!is_need_retire && !is_need_next && sync_base != NULL) {
+            msync(sync_base, MLOG_SEGMENT_BYTES, MS_ASYNC);
+            writer->stats.syncs++;
+        }
+
+        pthread_mutex_lock(&writer->lock);
+        if (writer->is_running && !writer->is_retire_pending && writer->is_next_ready) {
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_nsec += (long)MLOG_SYNC_INTERVAL_MS * 1000000L;
+            deadline.tv_sec += deadline.tv_nsec / 1000000000L;
+            deadline.tv_nsec %= 1000000000L;
+            pthread_cond_timedwait(&writer->cond, &writer->lock, &deadline);
+        }
+    }
+    pthread_mutex_unlock(&writer->lock);
+
+    return NULL;
+}
+
+/**
+ * @brief 将预分配的分段切换为当前分段
+ * @param writer 写入器结构体指针
+ * @return 错误码
+ * @note   正常情况下下一分段已由后台线程准备好，切换只是指针交换
+ */
+static mlog_error_t mlog_writer_rotate(mlog_writer_t *writer) {
+    pthread_mutex_lock(&writer->lock);
+    if (!writer->is_next_ready) {
+        writer->stats.rotate_waits++;
+        pthread_cond_signal(&writer->cond);
+        while (!writer->is_next_ready && writer->is_running) {
+            pthread_cond_wait(&writer->ready_cond, &writer->lock);
+        }
+        if (!writer->is_next_ready) {
+            pthread_mutex_unlock(&writer->lock);
+            return MLOG_ERROR_IO;
+        }
+    }
+
+    if (writer->cur.base != NULL) {
+        writer->retire = writer->cur;
+        writer->is_retire_pending = true;
+        writer->stats.rotations++;
+    }
+    writer->cur = writer->next;
+    writer->is_next_ready = false;
+    pthread_cond_signal(&writer->cond);
+    pthread_mutex_unlock(&writer->lock);
+
+    // 填写新分段文件头
+    writer->cur.hdr->magic = MLOG_MAGIC;
+    writer->cur.hdr->version = MLOG_VERSION;
+    writer->cur.hdr->schema_id = writer->schema_id;
+    writer->cur.hdr->record_size = writer->record_size;
+    writer->cur.hdr->first_seq = writer->seq;
+    atomic_store_explicit(&writer->cur.hdr->record_count, 0, memory_order_release);
+    writer->cur_count = 0;
+
+    return MLOG_OK;
+}
+
+/**
+ * @brief 预留记录实现函数
+ * @param writer       写入器结构体指针
+ * @param timestamp_ns 记录时间戳
+ * @return 负载区地址（位于映射区内，直接填写即可），失败返回NULL
+ */
+static void *mlog_writer_impl_reserve(mlog_writer_t *writer, uint64_t timestamp_ns) {
+    mlog_record_header_t *rec;
+
+    if (writer == NULL || writer->pending != NULL) {
+        return NULL;
+    }
+    if (writer->cur_count >= writer->capacity && mlog_writer_rotate(writer) != MLOG_OK) {
+        return NULL;
+    }
+
+    rec = (mlog_record_header_t *)(writer->cur.base + sizeof(mlog_segment_header_t) +
+                                   writer->cur_count * writer->record_size);
+    rec->seq = writer->seq;
+    rec->timestamp_ns = timestamp_ns;
+    writer->pending = (uint8_t *)rec;
+
+    return rec + 1;
+}
+
+/**
+ * @brief 提交记录实现函数
+ * @param writer 写入器结构体指针
+ * @note   以release语义更新已提交计数，读者看到计数即可安全读取记录内容
+ */
+static void mlog_writer_impl_commit(mlog_writer_t *writer) {
+    if (writer == NULL || writer->pending == NULL) {
+        return;
+    }
+
+    writer->pending = NULL;
+    writer->cur_count++;
+    writer->seq++;
+    writer->stats.records++;
+    atomic_store_explicit(&writer->cur.hdr->record_count, writer->cur_count, memory_order_release);
+}
+
+/**
+ * @brief 读取器切换到指定分段
+ * @param reader     读取器结构体指针
+ * @param segment_no 分段编号
+ * @return 错误码
+ */
+static mlog_error_t mlog_reader_load(mlog_reader_t *reader, uint64_t segment_no) {
+    mlog_segment_t seg;
+    mlog_error_t err;
+
+    if (reader->has_seg && reader->seg_no == segment_no) {
+        return MLOG_OK;
+    }
+
+    // 先打开新分段，失败时保留当前分段与读取位置
+    err = mlog_segment_open(reader->dir, segment_no, &seg);
+    if (err != MLOG_OK) {
+        return err;
+    }
+    if (seg.hdr->schema_id != reader->schema_id) {
+        mlog_segment_close(&seg);
+        return MLOG_ERROR_FORMAT;
+    }
+
+    if (reader->has_seg) {
+        mlog_segment_close(&reader->seg);
+    }
+    reader->seg = seg;
+    reader->seg_no = segment_no;
+    reader->pos = 0;
+    reader->has_seg = true;
+    return MLOG_OK;
+}
+
+/**
+ * @brief 取当前分段中指定位置的记录
+ * @param reader 读取器结构体指针
+ * @param pos    分段内位置
+ * @return 记录地址（含记录头），超出已提交范围返回NULL
+ */
+static const mlog_record_header_t *mlog_reader_at(const mlog_reader_t *reader, uint64_t pos) {
+    const mlog_segment_header_t *hdr = reader->seg.hdr;
+
+    if (pos >= atomic_load_explicit(&((mlog_segment_header_t *)hdr)->record_count,
+                                    memory_order_acquire)) {
+        return NULL;
+    }
+    return (const mlog_record_header_t *)(reader->seg.base + sizeof(mlog_segment_header_t) +
+                                          pos * hdr->record_size);
+}
+
+/**
+ * @brief 按序号定位实现函数
+ * @param reader 读取器结构体指针
+ * @param seq    记录序号
+ * @return 记录地址（含记录头），未找到返回NULL
+ * @note   索引二分定位分段，分段内按定长记录直接计算偏移
+ */
+static const void *mlog_reader_impl_seek_seq(mlog_reader_t *reader, uint64_t seq) {
+    uint64_t lo = 0;
+    uint64_t hi;
+    uint64_t mid;
+    uint64_t seg_no;
+    const mlog_record_header_t *rec;
+
+    if (reader == NULL) {
+        return NULL;
+    }
+
+    // 查找first_seq不大于seq的最后一个分段；超出索引范围时尝试正在写入的分段
+    hi = reader->index_num;
+    while (lo < hi) {
+        mid = (lo + hi) / 2;
+        if (reader->index[mid].first_seq <= seq) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo == 0) {
+        seg_no = (reader->index_num > 0) ? reader->index[0].segment_no : 0;
+    } else if (seq < reader->index[lo - 1].first_seq + reader->index[lo - 1].record_count) {
+        seg_no = reader->index[lo - 1].segment_no;
+    } else {
+        seg_no = (reader->index_num > 0) ? reader->index[reader->index_num - 1].segment_no + 1 : 0;
+    }
+
+    if (mlog_reader_load(reader, seg_no) != MLOG_OK || seq < reader->seg.hdr->first_seq) {
+        return NULL;
+    }
+    reader->pos = seq - reader->seg.hdr->first_seq;
+    rec = mlog_reader_at(reader, reader->pos);
+    if (rec != NULL) {
+        reader->pos++;
+    }
+    return rec;
+}
+
+/**
+ * @brief 按时间戳定位实现函数
+ * @param reader       读取器结构体指针
+ * @param timestamp_ns 时间戳
+ * @return 第一条时间戳不早于给定值的记录，未找到返回NULL
+ * @note   要求记录时间戳单调不减，先在索引中二分定位分段，再在分段内二分
+ */
+static const void *mlog_reader_impl_seek_time(mlog_reader_t *reader, uint64_t timestamp_ns) {
+    uint64_t seg_no;
+    uint64_t lo = 0;
+    uint64_t hi;
+    uint64_t mid;
+    const mlog_record_header_t *rec;
+
+    if (reader == NULL) {
+        return NULL;
+    }
+
+    // 查找last_ts_ns不早于给定时间戳的第一个分段
+    hi = reader->index_num;
+    while (lo < hi) {
+        mid = (lo + hi) / 2;
+        if (reader->index[mid].last_ts_ns < timestamp_ns) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo < reader->index_num) {
+        seg_no = reader->index[lo].segment_no;
+    } else {
+        // 落在正在写入的分段中
+        seg_no = (reader->index_num > 0) ? reader->index[reader->index_num - 1].segment_no + 1 : 0;
+    }
+
+    if (mlog_reader_load(reader, seg_no) != MLOG_OK) {
+        return NULL;
+    }
+
+    lo = 0;
+    hi = atomic_load_explicit(&reader->seg.hdr->record_count, memory_order_acquire);
+    while (lo < hi) {
+        mid = (lo + hi) / 2;
+        if (mlog_reader_at(reader, mid)->timestamp_ns < timestamp_ns) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    reader->pos = lo;
+    rec = mlog_reader_at(reader, reader->pos);
+    if (rec != NULL) {
+        reader->pos++;
+    }
+    return rec;
+}
+
+/**
+ * @brief 顺序读取实现函数
+ * @param reader 读取器结构体指针
+ * @return 下一条记录（含记录头），暂无数据返回NULL
+ * @note   当前分段读完且已被封存时自动切换到下一分段
+ */
+static const void *mlog_reader_impl_next(mlog_reader_t *reader) {
+    const mlog_record_header_t *rec;
+
+    if (reader == NULL) {
+        return NULL;
+    }
+    if (!reader->has_seg) {
+        if (mlog_reader_load(reader, (reader->index_num > 0) ? reader->index[0].segment_no : 0) !=
+            MLOG_OK) {
+            return NULL;
+        }
+    }
+
+    rec = mlog_reader_at(reader, reader->pos);
+    if (rec == NULL) {
+        // 尝试下一分段（写入器轮换后才会存在）
+        if (mlog_reader_load(reader, reader->seg_no + 1) != MLOG_OK) {
+            return NULL;
+        }
+        rec = mlog_reader_at(reader, 0);
+    }
+    if (rec != NULL) {
+        reader->pos++;
+    }
+    return rec;
+}
+
+/* ==================== 公共函数实现 ==================== */
+
+/**
+ * @brief 日志写入器初始化函数
+ * @param writer       写入器结构体指针
+ * @param dir          日志目录（需已存在）
+ * @param schema_id    记录schema标识
+ * @param payload_size 记录负载大小（字节）
+ * @return 错误码
+ */
+mlog_error_t mlog_writer_init(mlog_writer_t *writer, const char *dir, uint32_t schema_id,
+                              uint32_t payload_size) {
+    char path[MLOG_PATH_MAX + 32];
+
+    // 检查指针有效性
+    if (writer == NULL || dir == NULL) {
+        return MLOG_ERROR_NULL_PTR;
+    }
+    if (payload_size == 0 || strlen(dir) >= MLOG_PATH_MAX) {
+        return MLOG_ERROR_INVALID_PARAM;
+    }
+
+    memset(writer, 0, sizeof(*writer));
+    strcpy(writer->dir, dir);
+    writer->schema_id = schema_id;
+    writer->record_size = (uint32_t)((sizeof(mlog_record_header_t) + payload_size + 7U) & ~7U);
+    writer->capacity = (MLOG_SEGMENT_BYTES - sizeof(mlog_segment_header_t)) / writer->record_size;
+    writer->cur.fd = writer->next.fd = writer->retire.fd = -1;
+
+    snprintf(path, sizeof(path), "%s/" MLOG_INDEX_FILE, dir);
+    writer->index_fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+    if (writer->index_fd < 0) {
+        return MLOG_ERROR_IO;
+    }
+
+    // 同步创建首个分段，之后的分段由后台线程预分配
+    if (mlog_segment_create(dir, 0, &writer->next) != MLOG_OK) {
+        close(writer->index_fd);
+        return MLOG_ERROR_IO;
+    }
+    writer->next_segment_no = 1;
+    writer->is_next_ready = true;
+    writer->is_running = true;
+
+    pthread_mutex_init(&writer->lock, NULL);
+    pthread_cond_init(&writer->cond, NULL);
+    pthread_cond_init(&writer->ready_cond, NULL);
+
+    // 绑定函数指针（面向对象核心）
+    writer->reserve = mlog_writer_impl_reserve;
+    writer->commit = mlog_writer_impl_commit;
+
+    if (mlog_writer_rotate(writer) != MLOG_OK ||
+        pthread_create(&writer->bg_thread, NULL, mlog_writer_bg_main, writer) != 0) {
+        mlog_segment_close(&writer->cur);
+        close(writer->index_fd);
+        return MLOG_ERROR_IO;
+    }
+
+    return MLOG_OK;
+}
+
+/**
+ * @brief 日志写入器去初始化函数
+ * @param writer 写入器结构体指针
+ * @return 错误码
+ * @note   封存当前分段并写入索引，删除未使用的预分配分段
+ */
+mlog_error_t mlog_writer_deinit(mlog_writer_t *writer) {
+    char path[MLOG_PATH_MAX + 32];
+    mlog_segment_t spare;
+    uint64_t spare_no;
+    bool has_spare;
+
+    if (writer == NULL) {
+        return MLOG_ERROR_NULL_PTR;
+    }
+
+    pthread_mutex_lock(&writer->lock);
+    writer->is_running = false;
+    pthread_cond_signal(&writer->cond);
+    pthread_cond_signal(&writer->ready_cond);
+    pthread_mutex_unlock(&writer->lock);
+    pthread_join(writer->bg_thread, NULL);
+
+    // 当前分段截断到实际长度后封存
+    if (ftruncate(writer->cur.fd, (off_t)(sizeof(mlog_segment_header_t) +
+                                          writer->cur_count * writer->record_size)) != 0) {
+        // 截断失败不影响数据完整性，保留预分配长度
+    }
+    mlog_writer_retire(writer, &writer->cur);
+    has_spare = writer->is_next_ready;
+    spare = writer->next;
+    spare_no = writer->next_segment_no - 1;
+    if (has_spare) {
+        mlog_segment_close(&spare);
+        snprintf(path, sizeof(path), MLOG_SEGMENT_FMT, writer->dir, (unsigned long long)spare_no);
+        unlink(path);
+    }
+
+    close(writer->index_fd);
+    pthread_cond_destroy(&writer->ready_cond);
+    pthread_cond_destroy(&writer->cond);
+    pthread_mutex_destroy(&writer->lock);
+
+    writer->reserve = NULL;
+    writer->commit = NULL;
+
+    return MLOG_OK;
+}
+
+/**
+ * @brief 日志读取器初始化函数
+ * @param reader    读取器结构体指针
+ * @param dir       日志目录
+ * @param schema_id 期望的schema标识
+ * @return 错误码
+ * @note   索引文件只映射一次；正在写入的分段不在索引中，由读取器按编号推断
+ */
+mlog_error_t mlog_reader_init(mlog_reader_t *reader, const char *dir, uint32_t schema_id) {
+    char path[MLOG_PATH_MAX + 32];
+    struct stat st;
+    int fd;
+
+    if (reader == NULL || dir == NULL) {
+        return MLOG_ERROR_NULL_PTR;
+    }
+    if (strlen(dir) >= MLOG_PATH_MAX) {
+        return MLOG_ERROR_INVALID_PARAM;
+    }
+
+    memset(reader, 0, sizeof(*reader));
+    strcpy(reader->dir, dir);
+    reader->schema_id = schema_id;
+    reader->seg.fd = -1;
+
+    snprintf(path, sizeof(path), "%s/" MLOG_INDEX_FILE, dir);
+    fd = open(path, O_RDONLY);
+    if (fd >= 0 && fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(mlog_index_entry_t)) {
+        reader->index_num = (uint64_t)st.st_size / sizeof(mlog_index_entry_t);
+        reader->index_size = reader->index_num * sizeof(mlog_index_entry_t);
+        reader->index = mmap(NULL, reader->index_size, PROT_READ, MAP_SHARED, fd, 0);
+        if (reader->index == MAP_FAILED) {
+            reader->index = NULL;
+            reader->index_num = 0;
+        }
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+
+    // 绑定函数指针（面向对象核心）
+    reader->seek_seq = mlog_reader_impl_seek_seq;
+    reader->seek_time = mlog_reader_impl_seek_time;
+    reader->next = mlog_reader_impl_next;
+
+    return MLOG_OK;
+}
+
+/**
+ * @brief 日志读取器去初始化函数
+ * @param reader 读取器结构体指针
+ * @return 错误码
+ */
+mlog_error_t mlog_reader_deinit(mlog_reader_t *reader) {
+    if (reader == NULL) {
+        return MLOG_ERROR_NULL_PTR;
+    }
+
+    if (reader->has_seg) {
+        mlog_segment_close(&reader->seg);
+        reader->has_seg = false;
+    }
+    if (reader->index != NULL) {
+        munmap(reader->index, reader->index_size);
+        reader->index = NULL;
+    }
+
+    return MLOG_OK;
+}
+
+/**
+ * @brief 写入吞吐量与CPU开销基准测试
+ * @param dir          日志目录
+ * @param payload_size 记录负载大小（字节）
+ * @param count        写入记录数
+ * @param result       结果输出指针
+ * @return 错误码
+ */
+mlog_error_t mlog_bench(const char *dir, uint32_t payload_size, uint64_t count,
+                        mlog_bench_result_t *result) {
+    mlog_writer_t writer;
+    struct timespec w0, w1, c0, c1;
+    uint64_t i;
+    uint32_t *payload;
+    mlog_error_t err;
+
+    if (result == NULL) {
+        return MLOG_ERROR_NULL_PTR;
+    }
+
+    err = mlog_writer_init(&writer, dir, 0xBE7C0001UL, payload_size);
+    if (err != MLOG_OK) {
+        return err;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &w0);
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &c0);
+    for (i = 0; i < count; i++) {
+        payload = writer.reserve(&writer, i);
+        if (payload == NULL) {
+            break;
+        }
+        payload[0] = (uint32_t)i;    // 生产者直接写映射区
+        writer.commit(&writer);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &w1);
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &c1);
+    mlog_writer_deinit(&writer);
+
+    result->records = i;
+    result->wall_s = (double)(w1.tv_sec - w0.tv_sec) + (double)(w1.tv_nsec - w0.tv_nsec) * 1e-9;
+    result->cpu_s = (double)(c1.tv_sec - c0.tv_sec) + (double)(c1.tv_nsec - c0.tv_nsec) * 1e-9;
+    result->records_per_s = (result->wall_s > 0.0) ? (double)i / result->wall_s : 0.0;
+    result->cpu_ns_per_record = (i > 0) ? result->cpu_s * 1e9 / (double)i : 0.0;
+
+    return MLOG_OK;
+}
+
+/* ==================== 使用示例 ==================== */
+
+/*
+ * 使用示例：
+ *
+ * typedef struct {
+ *     float i_d, i_q, speed;
+ *     uint16_t sensor[4];
+ * } ctrl_record_t;
+ *
+ * int main(void) {
+ *     mlog_writer_t log;
+ *     mlog_reader_t rd;
+ *     mlog_bench_result_t bench;
+ *     ctrl_record_t *rec;
+ *     const mlog_record_header_t *hdr;
+ *
+ *     mlog_writer_init(&log, "/var/log/axis0", SCHEMA_CTRL_V1, sizeof(ctrl_record_t));
+ *
+ *     // 生产者：预留 → 直接填写映射区 → 提交
+ *     rec = log.reserve(&log, now_ns());
+ *     rec->i_q = motor_iq;
+ *     log.commit(&log);
+ *
+ *     mlog_writer_deinit(&log);
+ *
+ *     // 读取：按序号O(1)定位，或按时间戳二分定位后顺序读取
+ *     mlog_reader_init(&rd, "/var/log/axis0", SCHEMA_CTRL_V1);
+ *     hdr = rd.seek_time(&rd, t_start_ns);
+ *     while (hdr != NULL) {
+ *         rec = (ctrl_record_t *)(hdr + 1);
+ *         hdr = rd.next(&rd);
+ *     }
+ *     mlog_reader_deinit(&rd);
+ *
+ *     // 基准测试：1000万条64字节记录
+ *     mlog_bench("/tmp/mlog_bench", 64, 10000000ULL, &bench);
+ *     printf("%.0f rec/s, %.1f ns CPU/rec\n", bench.records_per_s, bench.cpu_ns_per_record);
+ * }
+ */
@@ -0,0 +1,897 @@
+/**
+ * @file osal_template.c
+ * @brief 操作系统抽象层（OSAL）模板文件
+ * @description 为电机与传感器子系统的后台工作提供统一的线程、信号量、消息队列、
+ *              临界区与节拍时间接口；默认编译为裸机移植，定义OSAL_PORT_POSIX后
+ *              编译为基于pthread的POSIX移植，可在Linux上测试多线程行为并测量上下文切换开销；
+ *              总线仲裁器（sensor_bus_arbiter_template.c，BUS_ARB_PORT_OSAL）基于本接口实现等待、唤醒与优先级继承
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#ifdef OSAL_PORT_POSIX
+#include <pthread.h>
+#include <time.h>
+#include <limits.h>
+#endif
+
+/* ==================== 宏定义 ==================== */
+
+#define OSAL_WAIT_FOREVER          0xFFFFFFFFUL  // 永久等待
+#define OSAL_NO_WAIT               0UL           // 不等待
+#define OSAL_THREAD_MAX            8             // 裸机移植最大线程数
+
+// 裸机临界区（保存并关闭中断/恢复中断），目标平台替换为PRIMASK读写
+#ifndef OSAL_IRQ_SAVE
+#define OSAL_IRQ_SAVE()            (0U)
+#define OSAL_IRQ_RESTORE(state)    ((void)(state))
+#endif
+
+// 裸机微秒时间，目标平台替换为DWT->CYCCNT或硬件定时器换算
+#ifndef OSAL_TIME_US
+#define OSAL_TIME_US()             (osal_tick_count * 1000U)
+#endif
+
+/* ==================== 类型定义 ==================== */
+
+/**
+ * @brief OSAL状态码枚举
+ */
+typedef enum {
+    OSAL_OK = 0,                   /**< 成功 */
+    OSAL_ERROR_NULL_PTR,           /**< 空指针错误 */
+    OSAL_ERROR_INVALID_PARAM,      /**< 无效参数 */
+    OSAL_ERROR_TIMEOUT,            /**< 等待超时 */
+    OSAL_ERROR_RESOURCE            /**< 资源不足或底层调用失败 */
+} osal_status_t;
+
+/**
+ * @brief 线程入口函数指针类型
+ * @note  裸机移植下入口被循环调用，必须执行完一步后返回
+ */
+typedef void (*osal_thread_entry_fn)(void *arg);
+
+/**
+ * @brief 线程控制结构体
+ */
+typedef struct {
+    const char *name;              /**< 线程名称 */
+    osal_thread_entry_fn entry;    /**< 线程入口 */
+    void *arg;                     /**< 入口参数 */
+    uint8_t prio;                  /**< 优先级（数值越大优先级越高） */
+#ifdef OSAL_PORT_POSIX
+    pthread_t handle;              /**< pthread句柄 */
+#endif
+} osal_thread_t;
+
+/**
+ * @brief 计数信号量结构体
+ */
+typedef struct {
+    volatile uint32_t count;       /**< 当前计数 */
+    uint32_t max_count;            /**< 最大计数 */
+#ifdef OSAL_PORT_POSIX
+    pthread_mutex_t mutex;         /**< 保护计数 */
+    pthread_cond_t cond;           /**< 计数非零条件 */
+#endif
+} osal_sem_t;
+
+/**
+ * @brief 定长消息队列结构体
+ * @note  存储区由调用方提供，队列本身不做动态分配
+ */
+typedef struct {
+    uint8_t *buffer;               /**< 存储区（item_size * depth字节） */
+    uint16_t item_size;            /**< 单条消息字节数 */
+    uint16_t depth;                /**< 队列深度 */
+    volatile uint16_t head;        /**< 读位置 */
+    volatile uint16_t tail;        /**< 写位置 */
+    volatile uint16_t count;       /**< 当前消息数 */
+#ifdef OSAL_PORT_POSIX
+    pthread_mutex_t mutex;         /**< 保护队列 */
+    pthread_cond_t not_empty;      /**< 非空条件 */
+    pthread_cond_t not_full;       /**< 非满条件 */
+#endif
+} osal_queue_t;
+
+/* ==================== 静态函数声明 ==================== */
+
+static void osal_queue_push(osal_queue_t *queue, const void *item);
+static void osal_queue_pop(osal_queue_t *queue, void *item);
+
+/* ==================== 静态函数实现 ==================== */
+
+/**
+ * @brief 写入一条消息（调用方已保证互斥且队列未满）
+ * @param queue 队列指针
+ * @param item  消息指针
+ */
+static void osal_queue_push(osal_queue_t *queue, const void *item) {
+    memcpy(&queue->buffer[(uint32_t)queue->tail * queue->item_size], item, queue->item_size);
+    queue->tail = (uint16_t)((queue->tail + 1U) % queue->depth);
+    queue->count++;
+}
+
+/**
+ * @brief 读出一条消息（调用方已保证互斥且队列非空）
+ * @param queue 队列指针
+ * @param item  消息输出指针
+ */
+static void osal_queue_pop(osal_queue_t *queue, void *item) {
+    memcpy(item, &queue->buffer[(uint32_t)queue->head * queue->item_size], queue->item_size);
+    queue->head = (uint16_t)((queue->head + 1U) % queue->depth);
+    queue->count--;
+}
+
+#ifndef OSAL_PORT_POSIX
+
+/* ==================== 裸机移植 ==================== */
+
+static volatile uint32_t osal_tick_count = 0;   // 毫秒节拍，由定时器中断递增
+static osal_thread_t *osal_threads[OSAL_THREAD_MAX];
+static uint8_t osal_thread_num = 0;
+
+/**
+ * @brief 节拍中断处理函数（1ms定时器中断中调用）
+ */
+void osal_tick_isr(void) {
+    osal_tick_count++;
+}
+
+/**
+ * @brief 获取毫秒节拍
+ * @return 自启动以来的毫秒数
+ */
+uint32_t osal_get_tick_ms(void) {
+    return osal_tick_count;
+}
+
+/**
+ * @brief 获取微秒时间
+ * @return 微秒时间（32位回绕），默认由节拍换算，精度1ms
+ */
+uint32_t osal_get_time_us(void) {
+    return OSAL_TIME_US();
+}
+
+/**
+ * @brief 毫秒延时（忙等）
+ * @param ms 延时毫秒数
+ */
+void osal_delay_ms(uint32_t ms) {
+    uint32_t start = osal_tick_count;
+
+    while ((uint32_t)(osal_tick_count - start) < ms) {
+    }
+}
+
+/**
+ * @brief 进入临界区
+ * @return 进入前的中断状态，退出时原样传回
+ */
+uint32_t osal_enter_critical(void) {
+    return OSAL_IRQ_SAVE();
+}
+
+/**
+ * @brief 退出临界区
+ * @param state osal_enter_critical返回的中断状态
+ */
+void osal_exit_critical(uint32_t state) {
+    OSAL_IRQ_RESTORE(state);
+}
+
+/**
+ * @brief 创建线程
+ * @param thread     线程控制结构体指针（调用方静态分配）
+ * @param name       线程名称
+ * @param entry      线程入口
+ * @param arg        入口参数
+ * @param prio       优先级
+ * @param stack_size 栈大小（裸机移植忽略）
+ * @return 状态码
+ * @note   裸机移植只登记线程，由osal_kernel_start按优先级轮流调用入口
+ */
+osal_status_t osal_thread_create(osal_thread_t *thread, const char *name,
+                                 osal_thread_entry_fn entry, void *arg,
+                                 uint8_t prio, uint32_t stack_size) {
+    uint8_t i;
+
+    (void)stack_size;
+    if (thread == NULL || entry == NULL) {
+        return OSAL_ERROR_NULL_PTR;
+    }
+    if (osal_thread_num >= OSAL_THREAD_MAX) {
+        return OSAL_ERROR_RESOURCE;
+    }
+
+    thread->name = name;
+    thread->entry = entry;
+    thread->arg = arg;
+    thread->prio = prio;
+
+    // 按优先级降序插入，高优先级先执行
+    for (i = osal_thread_num; i > 0 && osal_threads[i - 1]->prio < prio; i--) {
+        osal_threads[i] = osal_threads[i - 1];
+    }
+    osal_threads[i] = thread;
+    osal_thread_num++;
+
+    return OSAL_OK;
+}
+
+/**
+ * @brief 修改线程优先级
+ * @param thread 线程控制结构体指针（已创建）
+ * @param prio   新优先级
+ * @return 状态码
+ * @note   裸机移植按新优先级重新排序调用顺序，供优先级继承使用
+ */
+osal_status_t osal_thread_set_prio(osal_thread_t *thread, uint8_t prio) {
+    uint32_t state;
+    uint8_t i;
+
+    if (thread == NULL) {
+        return OSAL_ERROR_NULL_PTR;
+    }
+
+    state = osal_enter_critical();
+    for (i = 0; i < osal_thread_num && osal_threads[i] != thread; i++) {
+    }
+    if (i == osal_thread_num) {
+        osal_exit_critical(state);
+        return OSAL_ERROR_INVALID_PARAM;
+    }
+    thread->prio = prio;
+
+    // 向前或向后移动到新位置，保持优先级降序
+    for (; i > 0 && osal_threads[i - 1]->prio < prio; i--) {
+        osal_threads[i] = osal_threads[i - 1];
+        osal_threads[i - 1] = thread;
+    }
+    for (; i + 1 < osal_thread_num && osal_threads[i + 1]->prio > prio; i++) {
+        osal_threads[i] = osal_threads[i + 1];
+        osal_threads[i + 1] = thread;
+    }
+    osal_exit_critical(state);
+
+    return OSAL_OK;
+}
+
+/**
+ * @brief 启动调度（不返回）
+ */
+void osal_kernel_start(void) {
+    uint8_t i;
+
+    while (1) {
+        for (i = 0; i < osal_thread_num; i++) {
+            osal_threads[i]->entry(osal_threads[i]->arg);
+        }
+    }
+}
+
+/**
+ * @brief 初始化计数信号量
+ * @param sem       信号量指针
+ * @param initial   初始计数
+ * @param max_count 最大计数
+ * @return 状态码
+ */
+osal_status_t osal_sem_init(osal_sem_t *sem, uint32_t initial, uint32_t max_count) {
+    if (sem == NULL) {
+        return OSAL_ERROR_NULL_PTR;
+    }
+    if (max_count == 0 || initial > max_count) {
+        return OSAL_ERROR_INVALID_PARAM;
+    }
+
+    sem->count = initial;
+    sem->max_count = max_count;
+    return OSAL_OK;
+}
+
+/**
+ * @brief 释放信号量（可在中断中调用）
+ * @param sem 信号量指针
+ * @return 状态码，计数已满返回OSAL_ERROR_RESOURCE
+ */
+osal_status_t osal_sem_give(osal_sem_t *sem) {
+    osal_status_t ret = OSAL_OK;
+    uint32_t state;
+
+    if (sem == NULL) {
+        return OSAL_ERROR_NULL_PTR;
+    }
+
+    state = osal_enter_critical();
+    if (sem->count < sem->max_count) {
+        sem->count++;
+    } else {
+        ret = OSAL_ERROR_RESOURCE;
+    }
+    osal_exit_critical(state);
+
+    return ret;
+}
+
+/**
+ * @brief 获取信号量
+ * @param sem        信号量指针
+ * @param timeout_ms 超时毫秒数，OSAL_NO_WAIT/OSAL_WAIT_FOREVER
+ * @return 状态码
+ * @note   裸机移植下只能等待中断释放；线程间同步应使用OSAL_NO_WAIT
+ */
+osal_status_t osal_sem_take(osal_sem_t *sem, uint32_t timeout_ms) {
+    uint32_t start = osal_tick_count;
+    uint32_t state;
+
+    if (sem == NULL) {
+        return OSAL_ERROR_NULL_PTR;
+    }
+
+    while (1) {
+        state = osal_enter_critical();
+        if (sem->count > 0) {
+            sem->count--;
+            osal_exit_critical(state);
+            return OSAL_OK;
+        }
+        osal_exit_critical(state);
+
+        if (timeout_ms != OSAL_WAIT_FOREVER &&
+            (uint32_t)(osal_tick_count - start) >= timeout_ms) {
+            return OSAL_ERROR_TIMEOUT;
+        }
+    }
+}
+
+/**
+ * @brief 初始化消息队列
+ * @param queue     队列指针
+ * @param buffer    存储区（item_size * depth字节）
+ * @param item_size 单条消息字节数
+ * @param depth     队列深度
+ * @return 状态码
+ */
+osal_status_t osal_queue_init(osal_queue_t *queue, void *buffer, uint16_t item_size,
+                              uint16_t depth) {
+    if (queue == NULL || buffer == NULL) {
+        return OSAL_ERROR_NULL_PTR;
+    }
+    if (item_size == 0 || depth == 0) {
+        return OSAL_ERROR_INVALID_PARAM;
+    }
+
+    queue->buffer = (uint8_t *)buffer;
+    queue->item_size = item_size;
+    queue->depth = depth;
+    queue->head = 0;
+    queue->tail = 0;
+    queue->count = 0;
+    return OSAL_OK;
+}
+
+/**
+ * @brief 发送消息（可在中断中以OSAL_NO_WAIT调用）
+ * @param queue      队列指针
+ * @param item       消息指针
+ * @param timeout_ms 超时毫秒数
+ * @return 状态码
+ */
+osal_status_t osal_queue_send(osal_queue_t *queue, const void *item, uint32_t timeout_ms) {
+    uint32_t start = osal_tick_count;
+    uint32_t state;
+
+    if (queue == NULL || item == NULL) {
+        return OSAL_ERROR_NULL_PTR;
+    }
+
+    while (1) {
+        state = osal_enter_critical();
+        if (queue->count < queue->depth) {
+            osal_queue_push(queue, item);
+            osal_exit_critical(state);
+            return OSAL_OK;
+        }
+        osal_exit_critical(state);
+
+        if (timeout_ms != OSAL_WAIT_FOREVER &&
+            (uint32_t)(osal_tick_count - start) >= timeout_ms) {
+            return OSAL_ERROR_TIMEOUT;
+        }
+    }
+}
+
+/**
+ * @brief 接收消息
+ * @param queue      队列指针
+ * @param item       消息输出指针
+ * @param timeout_ms 超时毫秒数
+ * @return 状态码
+ */
+osal_status_t osal_queue_recv(osal_queue_t *queue, void *item, uint32_t timeout_ms) {
+    uint32_t start = osal_tick_count;
+    uint32_t state;
+
+    if (queue == NULL || item == NULL) {
+        return OSAL_ERROR_NULL_PTR;
+    }
+
+    while (1) {
+        state = osal_enter_critical();
+        if (queue->count > 0) {
+            osal_queue_pop(queue, item);
+            osal_exit_critical(state);
+            return OSAL_OK;
+        }
+        osal_exit_critical(state);
+
+        if (timeout_ms != OSAL_WAIT_FOREVER &&
+            (uint32_t)(osal_tick_count - start) >= timeout_ms) {
+            return OSAL_ERROR_TIMEOUT;
+        }
+    }
+}
+
+#else /* OSAL_PORT_POSIX */
+
+/* ==================== POSIX移植 ==================== */
+
+static pthread_mutex_t osal_critical_mutex;
+static pthread_once_t osal_critical_once = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief 初始化全局临界区递归锁
+ */
+static void osal_posix_critical_init(void) {
+    pthread_mutexattr_t attr;
+
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&osal_critical_mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+
+/**
+ * @brief 计算单调时钟下的绝对超时时刻
+ * @param ts         输出时刻
+ * @param timeout_ms 超时毫秒数
+ */
+static void osal_posix_deadline(struct timespec *ts, uint32_t timeout_ms) {
+    clock_gettime(CLOCK_MONOTONIC, ts);
+    ts->tv_sec += (time_t)(timeout_ms / 1000U);
+    ts->tv_nsec += (long)(timeout_ms % 1000U) * 1000000L;
+    if (ts->tv_nsec >= 1000000000L) {
+        ts->tv_sec++;
+        ts->tv_nsec -= 1000000000L;
+    }
+}
+
+/**
+ * @brief 初始化使用单调时钟的条件变量
+ * @param cond 条件变量指针
+ */
+static void osal_posix_cond_init(pthread_cond_t *cond) {
+    pthread_condattr_t attr;
+
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+/**
+ * @brief 在条件变量上等待，带超时
+ * @param cond       条件变量指针
+ * @param mutex      已持有的互斥锁
+ * @param deadline   绝对超时时刻
+ * @param timeout_ms 超时毫秒数（OSAL_WAIT_FOREVER表示无超时）
+ * @return 0表示被唤醒，非0表示超时
+ */
+static int osal_posix_wait(pthread_cond_t *cond, pthread_mutex_t *mutex,
+                           const struct timespec *deadline, uint32_t timeout_ms) {
+    if (timeout_ms == OSAL_WAIT_FOREVER) {
+        return pthread_cond_wait(cond, mutex);
+    }
+    return pthread_cond_timedwait(cond, mutex, deadline);
+}
+
+/**
+ * @brief pthread入口适配
+ * @param arg 线程控制结构体指针
+ * @return NULL
+ */
+static void *osal_posix_thread_entry(void *arg) {
+    osal_thread_t *thread = (osal_thread_t *)arg;
+
+    thread->entry(thread->arg);
+    return NULL;
+}
+
+/**
+ * @brief 获取毫秒节拍
+ * @return 单调时钟毫秒数
+ */
+uint32_t osal_get_tick_ms(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000U + (uint64_t)ts.tv_nsec / 1000000U);
+}
+
+/**
+ * @brief 获取微秒时间
+ * @return 单调时钟微秒数（32位回绕）
+ */
+uint32_t osal_get_time_us(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000U + (uint64_t)ts.tv_nsec / 1000U);
+}
+
+/**
+ * @brief 毫秒延时（让出CPU）
+ * @param ms 延时毫秒数
+ */
+void osal_delay_ms(uint32_t ms) {
+    struct timespec ts;
+
+    ts.tv_sec = (time_t)(ms / 1000U);
+    ts.tv_nsec = (long)(ms % 1000U) * 1000000L;
+    nanosleep(&ts, NULL);
+}
+
+/**
+ * @brief 进入临界区
+ * @return 固定为0（POSIX移植以全局递归锁模拟关中断）
+ */
+uint32_t osal_enter_critical(void) {
+    pthread_once(&osal_critical_once, osal_posix_critical_init);
+    pthread_mutex_lock(&osal_critical_mutex);
+    return 0;
+}
+
+/**
+ * @brief 退出临界区
+ * @param state osal_enter_critical返回值
+ */
+void osal_exit_critical(uint32_t state) {
+    (void)state;
+    pthread_mutex_unlock(&osal_critical_mutex);
+}
+
+/**
+ * @brief 创建线程
+ * @param thread     线程控制结构体指针（调用方静态分配）
+ * @param name       线程名称
+ * @param entry      线程入口
+ * @param arg        入口参数
+ * @param prio       优先级（POSIX移植仅记录，不申请实时调度权限）
+ * @param stack_size 栈大小，0表示使用默认值
+ * @return 状态码
+ */
+osal_status_t osal_thread_create(osal_thread_t *thread, const char *name,
+                                 osal_thread_entry_fn entry, void *arg,
+                                 uint8_t prio, uint32_t stack_size) {
+    pthread_attr_t attr;
+    int ret;
+
+    if (thread == NULL || entry == NULL) {
+        return OSAL_ERROR_NULL_PTR;
+    }
+
+    thread->name = name;
+    thread->entry = entry;
+    thread->arg = arg;
+    thread->prio = prio;
+
+    pthread_attr_init(&attr);
+    if (stack_size >= PTHREAD_STACK_MIN) {
+        pthread_attr_setstacksize(&attr, stack_size);
+    }
+    ret = pthread_create(&thread->handle, &attr, osal_posix_thread_entry, thread);
+    pthread_attr_destroy(&attr);
+
+    return (ret == 0) ? OSAL_OK : OSAL_ERROR_RESOURCE;
+}
+
+/**
+ * @brief 修改线程优先级
+ * @param thread 线程控制结构体指针
+ * @param prio   新优先级
+ * @return 状态码
+ * @note   与创建时一致，POSIX移植仅记录，不申请实时调度权限
+ */
+osal_status_t osal_thread_set_prio(osal_thread_t *thread, uint8_t prio) {
+    if (thread == NULL) {
+        return OSAL_ERROR_NULL_PTR;
+    }
+
+    thread->prio = prio;
+    return OSAL_OK;
+}
+
+/**
+ * @brief 启动调度（POSIX移植下线程创建即运行，此处仅阻塞主线程）
+ */
+void osal_kernel_start(void) {
+    while (1) {
+        osal_delay_ms(1000);
+    }
+}
+
+/**
+ * @brief 初始化计数信号量
+ * @param sem       信号量指针
+ * @param initial   初始计数
+ * @param max_count 最大计数
+ * @return 状态码
+ */
+osal_status_t osal_sem_init(osal_sem_t *sem, uint32_t initial, uint32_t max_count) {
+    if (sem == NULL) {
+        return OSAL_ERROR_NULL_PTR;
+    }
+    if (max_count == 0 || initial > max_count) {
+        return OSAL_ERROR_INVALID_PARAM;
+    }
+
+    sem->count = initial;
+    sem->max_count = max_count;
+    pthread_mutex_init(&sem->mutex, NULL);
+    osal_posix_cond_init(&sem->cond);
+    return OSAL_OK;
+}
+
+/**
+ * @brief 释放信号量
+ * @param sem 信号量指针
+ * @return 状态码，计数已满返回OSAL_ERROR_RESOURCE
+ */
+osal_status_t osal_sem_give(osal_sem_t *sem) {
+    osal_status_t ret = OSAL_OK;
+
+    if (sem == NULL) {
+        return OSAL_ERROR_NULL_PTR;
+    }
+
+    pthread_mutex_lock(&sem->mutex);
+    if (sem->count < sem->max_count) {
+        sem->count++;
+        pthread_cond_signal(&sem->cond);
+    } else {
+        ret = OSAL_ERROR_RESOURCE;
+    }
+    pthread_mutex_unlock(&sem->mutex);
+
+    return ret;
+}
+
+/**
+ * @brief 获取信号量
+ * @param sem        信号量指针
+ * @param timeout_ms 超时毫秒数，OSAL_NO_WAIT/OSAL_WAIT_FOREVER
+ * @return 状态码
+ */
+osal_status_t osal_sem_take(osal_sem_t *sem, uint32_t timeout_ms) {
+    struct timespec deadline;
+    osal_status_t ret = OSAL_OK;
+
+    if (sem == NULL) {
+        return OSAL_ERROR_NULL_PTR;
+    }
+
+    osal_posix_deadline(&deadline, timeout_ms);
+    pthread_mutex_lock(&sem->mutex);
+    while (sem->count == 0) {
+        if (timeout_ms == OSAL_NO_WAIT ||
+            osal_posix_wait(&sem->cond, &sem->mutex, &deadline, timeout_ms) != 0) {
+            ret = OSAL_ERROR_TIMEOUT;
+            break;
+        }
+    }
+    if (ret == OSAL_OK) {
+        sem->count--;
+    }
+    pthread_mutex_unlock(&sem->mutex);
+
+    return ret;
+}
+
+/**
+ * @brief 初始化消息队列
+ * @param queue     队列指针
+ * @param buffer    存储区（item_size * depth字节）
+ * @param item_size 单条消息字节数
+ * @param depth     队列深度
+ * @return 状态码
+ */
+osal_status_t osal_queue_init(osal_queue_t *queue, void *buffer, uint16_t item_size,
+                              uint16_t depth) {
+    if (queue == NULL || buffer == NULL) {
+        return OSAL_ERROR_NULL_PTR;
+    }
+    if (item_size == 0 || depth == 0) {
+        return OSAL_ERROR_INVALID_PARAM;
+    }
+
+    queue->buffer = (uint8_t *)buffer;
+    queue->item_size = item_size;
+    queue->depth = depth;
+    queue->head = 0;
+    queue->tail = 0;
+    queue->count = 0;
+    pthread_mutex_init(&queue->mutex, NULL);
+    osal_posix_cond_init(&queue->not_empty);
+    osal_posix_cond_init(&queue->not_full);
+    return OSAL_OK;
+}
+
+/**
+ * @brief 发送消息
+ * @param queue      队列指针
+ * @param item       消息指针
+ * @param timeout_ms 超时毫秒数
+ * @return 状态码
+ */
+osal_status_t osal_queue_send(osal_queue_t *queue, const void *item, uint32_t timeout_ms) {
+    struct timespec deadline;
+    osal_status_t ret = OSAL_OK;
+
+    if (queue == NULL || item == NULL) {
+        return OSAL_ERROR_NULL_PTR;
+    }
+
+    osal_posix_deadline(&deadline, timeout_ms);
+    pthread_mutex_lock(&queue->mutex);
+    while (queue->count == queue->depth) {
+        if (timeout_ms == OSAL_NO_WAIT ||
+            osal_posix_wait(&queue->not_full, &queue->mutex, &deadline, timeout_ms) != 0) {
+            ret = OSAL_ERROR_TIMEOUT;
+            break;
+        }
+    }
+    if (ret == OSAL_OK) {
+        osal_queue_push(queue, item);
+        pthread_cond_signal(&queue->not_empty);
+    }
+    pthread_mutex_unlock(&queue->mutex);
+
+    return ret;
+}
+
+/**
+ * @brief 接收消息
+ * @param queue      队列指针
+ * @param item       消息输出指针
+ * @param timeout_ms 超时毫秒数
+ * @return 状态码
+ */
+osal_status_t osal_queue_recv(osal_queue_t *queue, void *item, uint32_t timeout_ms) {
+    struct timespec deadline;
+    osal_status_t ret = OSAL_OK;
+
+    if (queue == NULL || item == NULL) {
+        return OSAL_ERROR_NULL_PTR;
+    }
+
+    osal_posix_deadline(&deadline, timeout_ms);
+    pthread_mutex_lock(&queue->mutex);
+    while (queue->count == 0) {
+        if (timeout_ms == OSAL_NO_WAIT ||
+            osal_posix_wait(&queue->not_empty, &queue->mutex, &deadline, timeout_ms) != 0) {
+            ret = OSAL_ERROR_TIMEOUT;
+            break;
+        }
+    }
+    if (ret == OSAL_OK) {
+        osal_queue_pop(queue, item);
+        pthread_cond_signal(&queue->not_full);
+    }
+    pthread_mutex_unlock(&queue->mutex);
+
+    return ret;
+}
+
+/* === 上下文切换基准 === */
+
+static osal_sem_t osal_bench_ping;
+static osal_sem_t osal_bench_pong;
+static volatile uint32_t osal_bench_rounds;
+
+/**
+ * @brief 基准测试对端线程：收到ping后回复pong
+ * @param arg 未使用
+ */
+static void osal_bench_peer(void *arg) {
+    uint32_t i;
+
+    (void)arg;
+    for (i = 0; i < osal_bench_rounds; i++) {
+        osal_sem_take(&osal_bench_ping, OSAL_WAIT_FOREVER);
+        osal_sem_give(&osal_bench_pong);
+    }
+}
+
+/**
+ * @brief 上下文切换开销基准测试
+ * @param rounds 往返次数
+ * @return 单次线程切换的平均耗时（纳秒），每次往返包含两次切换
+ * @note   在单核上运行（taskset -c 0）结果最接近RTOS上的切换开销
+ */
+double osal_posix_bench_switch(uint32_t rounds) {
+    osal_thread_t peer;
+    struct timespec t0, t1;
+    uint32_t i;
+
+    if (rounds == 0) {
+        return 0.0;
+    }
+
+    osal_bench_rounds = rounds;
+    osal_sem_init(&osal_bench_ping, 0, 1);
+    osal_sem_init(&osal_bench_pong, 0, 1);
+    if (osal_thread_create(&peer, "bench", osal_bench_peer, NULL, 0, 0) != OSAL_OK) {
+        return 0.0;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (i = 0; i < rounds; i++) {
+        osal_sem_give(&osal_bench_ping);
+        osal_sem_take(&osal_bench_pong, OSAL_WAIT_FOREVER);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    pthread_join(peer.handle, NULL);
+
+    return ((double)(t1.tv_sec - t0.tv_sec) * 1e9 + (double)(t1.tv_nsec - t0.tv_nsec)) /
+           ((double)rounds * 2.0);
+}
+
+#endif /* OSAL_PORT_POSIX */
+
+/* ==================== 使用示例 ==================== */
+
+/*
+ * 使用示例（电机与传感器子系统的后台工作）：
+ *
+ * static osal_thread_t sensor_thread;
+ * static osal_thread_t tuning_thread;
+ * static osal_sem_t sensor_ready;
+ * static osal_queue_t cmd_queue;
+ * static motor_cmd_t cmd_buffer[8];
+ *
+ * void SENSOR_DRDY_IRQHandler(void) {
+ *     osal_sem_give(&sensor_ready);                 // 中断中释放信号量
+ * }
+ *
+ * static void sensor_worker(void *arg) {
+ *     uint16_t value;
+ *     // POSIX移植为常驻循环；裸机移植每次调用执行一步，应使用OSAL_NO_WAIT
+ *     if (osal_sem_take(&sensor_ready, OSAL_NO_WAIT) == OSAL_OK) {
+ *         imu.get_data(&value);
+ *     }
+ * }
+ *
+ * static void tuning_worker(void *arg) {
+ *     motor_cmd_t cmd;
+ *     if (osal_queue_recv(&cmd_queue, &cmd, OSAL_NO_WAIT) == OSAL_OK) {
+ *         motor_cmd_post(&motor, 0, &cmd);          // 转交控制中断
+ *     }
+ * }
+ *
+ * int main(void) {
+ *     osal_sem_init(&sensor_ready, 0, 1);
+ *     osal_queue_init(&cmd_queue, cmd_buffer, sizeof(motor_cmd_t), 8);
+ *     osal_thread_create(&sensor_thread, "sensor", sensor_worker, NULL, 10, 1024);
+ *     osal_thread_create(&tuning_thread, "tuning", tuning_worker, NULL, 5, 1024);
+ *     osal_kernel_start();
+ * }
+ *
+ * 主机测试（Linux）：
+ *   gcc -DOSAL_PORT_POSIX -D_GNU_SOURCE -O2 -c osal_template.c -pthread
+ *   taskset -c 0 ./bench    // 调用 osal_posix_bench_switch(100000)
+ */
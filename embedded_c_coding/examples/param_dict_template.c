@@ -0,0 +1,597 @@
+/**
+ * @file param_dict_template.c
+ * @brief 参数对象字典模板文件
+ * @description 为motor_config_t、pid_param_t、sensor_config_t等运行参数生成静态对象字典：
+ *              每个参数有类型、范围、访问权限与结构体内偏移，参数ID为“对象编号 << 8 | 子索引”，
+ *              经两级稠密数组O(1)定位；控制环使用的热参数对象采用双缓冲，
+ *              外部工具只写影子副本，控制中断在周期开始时一次性生效，远程整定不阻塞控制环
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdatomic.h>
+
+/* ==================== 宏定义 ==================== */
+
+#define PARAM_SHADOW_WORDS         8       // 热参数对象影子副本大小（32位字）
+
+// 快速RAM放置：定义USE_FAST_RAM并在链接脚本中包含fast_ram_sections.ld后，
+// 控制中断开始时调用的热参数生效函数放入ITCM/CCM（段宏与fast_ram_template.c一致，启动拷贝见该文件）
+#ifndef FAST_RAM_CODE
+#ifdef USE_FAST_RAM
+#define FAST_RAM_CODE              __attribute__((section(".fast_text")))
+#else
+#define FAST_RAM_CODE
+#endif
+#endif
+
+// 参数ID编解码
+#define PARAM_ID(obj, sub)         ((uint16_t)(((uint16_t)(obj) << 8) | (uint8_t)(sub)))
+#define PARAM_ID_OBJ(id)           ((uint8_t)((id) >> 8))
+#define PARAM_ID_SUB(id)           ((uint8_t)((id) & 0xFFU))
+
+/* ==================== 类型定义 ==================== */
+
+/**
+ * @brief 参数错误码枚举
+ */
+typedef enum {
+    PARAM_OK = 0,                  /**< 成功 */
+    PARAM_ERROR_NULL_PTR,          /**< 空指针错误 */
+    PARAM_ERROR_INVALID_ID,        /**< 参数ID不存在 */
+    PARAM_ERROR_UNBOUND,           /**< 参数对象未绑定实例 */
+    PARAM_ERROR_ACCESS,            /**< 访问权限不足 */
+    PARAM_ERROR_SIZE,              /**< 数据长度与参数类型不符 */
+    PARAM_ERROR_RANGE,             /**< 超出取值范围 */
+    PARAM_ERROR_BUSY               /**< 上一次热参数更新尚未被控制环取走 */
+} param_error_t;
+
+/**
+ * @brief 参数类型枚举
+ * @note  整数按成员实际大小（1/2/4字节）解释，枚举成员使用PARAM_TYPE_UINT
+ */
+typedef enum {
+    PARAM_TYPE_UINT = 0,           /**< 无符号整数 */
+    PARAM_TYPE_INT,                /**< 有符号整数 */
+    PARAM_TYPE_FLOAT,              /**< 单精度浮点 */
+    PARAM_TYPE_BOOL                /**< 布尔 */
+} param_type_t;
+
+/**
+ * @brief 参数访问权限
+ */
+#define PARAM_ACCESS_READ          0x01U
+#define PARAM_ACCESS_WRITE         0x02U
+#define PARAM_ACCESS_RW            (PARAM_ACCESS_READ | PARAM_ACCESS_WRITE)
+
+/*
+ * 参数所属的结构体，与foc_motor_driver_template.c、sensor_driver_template.c中的定义一致，
+ * 工程中改为包含对应头文件
+ */
+
+typedef enum {
+    MOTOR_MODE_VOLTAGE = 0,
+    MOTOR_MODE_CURRENT,
+    MOTOR_MODE_SPEED,
+    MOTOR_MODE_POSITION
+} motor_mode_t;
+
+typedef struct {
+    float kp;
+    float ki;
+    float kd;
+    float integral_limit;
+    float output_limit;
+} pid_param_t;
+
+typedef struct {
+    uint16_t pole_pairs;
+    float max_current;
+    float max_speed;
+    motor_mode_t control_mode;
+} motor_config_t;
+
+typedef struct {
+    uint8_t sample_rate;
+    uint8_t resolution;
+    bool enable_interrupt;
+} sensor_config_t;
+
+/**
+ * @brief 参数描述结构体（const，存放于Flash）
+ */
+typedef struct {
+    const char *name;              /**< 参数名（成员名） */
+    uint16_t offset;               /**< 结构体内偏移 */
+    uint8_t size;                  /**< 字节数 */
+    uint8_t type;                  /**< 参数类型（param_type_t） */
+    uint8_t access;                /**< 访问权限 */
+    float min;                     /**< 最小值 */
+    float max;                     /**< 最大值 */
+} param_entry_t;
+
+/**
+ * @brief 参数对象描述结构体（const，存放于Flash）
+ */
+typedef struct {
+    const char *name;              /**< 对象名 */
+    const param_entry_t *entries;  /**< 参数描述表，按子索引排列 */
+    uint8_t entry_num;             /**< 参数个数 */
+    uint16_t obj_size;             /**< 对象结构体大小 */
+    bool is_hot;                   /**< 是否由控制环使用（双缓冲更新） */
+} param_obj_desc_t;
+
+/* ==================== 参数表 ==================== */
+
+/*
+ * 结构体成员表：每行描述一个成员，新增参数只需追加一行
+ * 参数依次为：子索引名、成员、类型（PARAM_TYPE_xxx）、最小值、最大值、访问权限（PARAM_ACCESS_xxx）
+ * 控制模式只读：切换须经MOTOR_CMD_SET_MODE命令（见foc_motor_driver_template.c），
+ * 由控制中断在切换时清外环积分，直接写入会跳过该步骤
+ */
+#define PARAM_MOTOR_CONFIG_FIELDS(X)                                    \
+    X(MOTOR_POLE_PAIRS,   pole_pairs,   UINT,  1.0f,    64.0f, RW)      \
+    X(MOTOR_MAX_CURRENT,  max_current,  FLOAT, 0.0f,    60.0f, RW)      \
+    X(MOTOR_MAX_SPEED,    max_speed,    FLOAT, 0.0f, 30000.0f, RW)      \
+    X(MOTOR_CONTROL_MODE, control_mode, UINT,  0.0f,     3.0f, READ)
+
+#define PARAM_PID_FIELDS(X)                                             \
+    X(PID_KP,             kp,             FLOAT, 0.0f, 100.0f, RW)      \
+    X(PID_KI,             ki,             FLOAT, 0.0f, 100.0f, RW)      \
+    X(PID_KD,             kd,             FLOAT, 0.0f, 100.0f, RW)      \
+    X(PID_INTEGRAL_LIMIT, integral_limit, FLOAT, 0.0f, 100.0f, RW)      \
+    X(PID_OUTPUT_LIMIT,   output_limit,   FLOAT, 0.0f, 100.0f, RW)
+
+#define PARAM_SENSOR_CONFIG_FIELDS(X)                                   \
+    X(SENSOR_SAMPLE_RATE, sample_rate,      UINT, 1.0f, 200.0f, RW)     \
+    X(SENSOR_RESOLUTION,  resolution,       UINT, 8.0f,  24.0f, READ)   \
+    X(SENSOR_ENABLE_IRQ,  enable_interrupt, BOOL, 0.0f,   1.0f, RW)
+
+/*
+ * 参数对象表：每行描述一个对象实例，对象编号即参数ID高8位
+ * 参数依次为：对象名、成员表（PARAM_xxx_FIELDS）、结构体类型、是否为控制环热参数
+ */
+#define PARAM_OBJ_TABLE(X)                                              \
+    X(MOTOR_CONFIG,  MOTOR_CONFIG,  motor_config_t,  false)             \
+    X(PID_D,         PID,           pid_param_t,     true)              \
+    X(PID_Q,         PID,           pid_param_t,     true)              \
+    X(SENSOR_CONFIG, SENSOR_CONFIG, sensor_config_t, false)
+
+// 子索引枚举
+#define PARAM_SUB_ENUM(sub, member, type, lo, hi, acc)  PARAM_SUB_##sub,
+typedef enum { PARAM_MOTOR_CONFIG_FIELDS(PARAM_SUB_ENUM) PARAM_SUB_MOTOR_NUM } param_sub_motor_t;
+typedef enum { PARAM_PID_FIELDS(PARAM_SUB_ENUM) PARAM_SUB_PID_NUM } param_sub_pid_t;
+typedef enum { PARAM_SENSOR_CONFIG_FIELDS(PARAM_SUB_ENUM) PARAM_SUB_SENSOR_NUM } param_sub_sensor_t;
+#undef PARAM_SUB_ENUM
+
+// 对象编号枚举
+#define PARAM_OBJ_ENUM(obj, fields, type, hot)  PARAM_OBJ_##obj,
+typedef enum {
+    PARAM_OBJ_TABLE(PARAM_OBJ_ENUM)
+    PARAM_OBJ_NUM
+} param_obj_id_t;
+#undef PARAM_OBJ_ENUM
+
+// 参数描述项，PARAM_LAYOUT为当前展开的结构体类型
+#define PARAM_ENTRY(sub, member, kind, lo, hi, acc)                     \
+    [PARAM_SUB_##sub] = {                                               \
+        .name = #member,                                                \
+        .offset = offsetof(PARAM_LAYOUT, member),                       \
+        .size = sizeof(((PARAM_LAYOUT *)0)->member),                    \
+        .type = PARAM_TYPE_##kind,                                      \
+        .access = PARAM_ACCESS_##acc,                                   \
+        .min = (lo),                                                    \
+        .max = (hi),                                                    \
+    },
+
+#define PARAM_LAYOUT motor_config_t
+static const param_entry_t param_motor_config_entries[] = { PARAM_MOTOR_CONFIG_FIELDS(PARAM_ENTRY) };
+#undef PARAM_LAYOUT
+
+#define PARAM_LAYOUT pid_param_t
+static const param_entry_t param_pid_entries[] = { PARAM_PID_FIELDS(PARAM_ENTRY) };
+#undef PARAM_LAYOUT
+
+#define PARAM_LAYOUT sensor_config_t
+static const param_entry_t param_sensor_config_entries[] = { PARAM_SENSOR_CONFIG_FIELDS(PARAM_ENTRY) };
+#undef PARAM_LAYOUT
+
+#undef PARAM_ENTRY
+
+// 成员表到描述表的对应关系
+#define PARAM_ENTRIES_OF_MOTOR_CONFIG   param_motor_config_entries
+#define PARAM_ENTRIES_OF_PID            param_pid_entries
+#define PARAM_ENTRIES_OF_SENSOR_CONFIG  param_sensor_config_entries
+
+// 对象描述表
+#define PARAM_OBJ_DESC(obj, fields, type, hot)                          \
+    [PARAM_OBJ_##obj] = {                                               \
+        .name = #obj,                                                   \
+        .entries = PARAM_ENTRIES_OF_##fields,                           \
+        .entry_num = sizeof(PARAM_ENTRIES_OF_##fields) /                \
+                     sizeof(param_entry_t),                             \
+        .obj_size = sizeof(type),                                       \
+        .is_hot = (hot),                                                \
+    },
+static const param_obj_desc_t param_obj_table[PARAM_OBJ_NUM] = {
+    PARAM_OBJ_TABLE(PARAM_OBJ_DESC)
+};
+#undef PARAM_OBJ_DESC
+
+// 热参数对象必须能放入影子副本
+#define PARAM_OBJ_CHECK(obj, fields, type, hot)                         \
+    _Static_assert(!(hot) || sizeof(type) <= PARAM_SHADOW_WORDS * 4U,   \
+                   #obj " exceeds PARAM_SHADOW_WORDS");
+PARAM_OBJ_TABLE(PARAM_OBJ_CHECK)
+#undef PARAM_OBJ_CHECK
+
+/* === 前向声明 === */
+
+typedef struct param_dict_t param_dict_t;
+
+/* === 函数指针类型定义 === */
+
+/**
+ * @brief 参数变更回调函数指针类型
+ * @note  写入成功后在写入方上下文调用，obj为含新值的对象副本：普通对象为实例本身，
+ *        热参数对象为影子副本（已提交，下一个控制周期生效，实例此时仍是旧值），回调中只读
+ */
+typedef void (*param_change_fn)(uint16_t id, void *obj, void *ctx);
+
+/**
+ * @brief 参数读取函数指针类型
+ * @param len 输入为缓冲区大小，输出为参数字节数
+ */
+typedef param_error_t (*param_read_fn)(param_dict_t *dict, uint16_t id, void *buf, uint8_t *len);
+
+/**
+ * @brief 参数写入函数指针类型
+ */
+typedef param_error_t (*param_write_fn)(param_dict_t *dict, uint16_t id, const void *data, uint8_t len);
+
+/**
+ * @brief 参数对象实例结构体
+ */
+typedef struct {
+    void *live;                                /**< 对象实例（控制环使用的副本） */
+    uint32_t shadow[PARAM_SHADOW_WORDS];       /**< 影子副本（热参数对象） */
+    atomic_bool is_pending;                    /**< 影子副本待生效 */
+    param_change_fn on_change;                 /**< 变更回调 */
+    void *ctx;                                 /**< 回调上下文 */
+} param_obj_t;
+
+/**
+ * @brief 参数字典统计结构体
+ */
+typedef struct {
+    uint32_t reads;                /**< 读取次数 */
+    uint32_t writes;               /**< 写入成功次数 */
+    uint32_t rejects;              /**< 因权限、长度、范围被拒绝的写入次数 */
+    uint32_t busy;                 /**< 因上一次更新未生效而返回BUSY的次数 */
+    uint32_t syncs;                /**< 控制环生效的热参数更新次数 */
+} param_stats_t;
+
+/**
+ * @brief 参数字典结构体
+ * @note  读写在单一任务上下文（如协议任务）调用，param_dict_sync在控制中断调用
+ */
+struct param_dict_t {
+    /* 运行状态 */
+    param_obj_t obj[PARAM_OBJ_NUM];            /**< 对象实例，按对象编号索引 */
+    param_stats_t stats;                       /**< 统计 */
+
+    /* 函数指针 - 操作方法 */
+    param_read_fn read;                        /**< 读取参数 */
+    param_write_fn write;                      /**< 写入参数 */
+};
+
+/* ==================== 静态函数声明 ==================== */
+
+static param_error_t param_impl_read(param_dict_t *dict, uint16_t id, void *buf, uint8_t *len);
+static param_error_t param_impl_write(param_dict_t *dict, uint16_t id, const void *data, uint8_t len);
+static const param_entry_t *param_lookup(param_dict_t *dict, uint16_t id, param_obj_t **obj);
+static float param_to_float(const param_entry_t *entry, const void *data);
+
+/* ==================== 静态函数实现 ==================== */
+
+/**
+ * @brief 按ID定位参数描述与对象实例
+ * @param dict 参数字典指针
+ * @param id   参数ID
+ * @param obj  对象实例输出指针
+ * @return 参数描述指针，ID不存在时返回NULL
+ * @note   对象编号与子索引分别直接索引两级数组，O(1)
+ */
+static const param_entry_t *param_lookup(param_dict_t *dict, uint16_t id, param_obj_t **obj) {
+    uint8_t obj_id = PARAM_ID_OBJ(id);
+    uint8_t sub = PARAM_ID_SUB(id);
+
+    if (obj_id >= PARAM_OBJ_NUM || sub >= param_obj_table[obj_id].entry_num) {
+        return NULL;
+    }
+
+    *obj = &dict->obj[obj_id];
+    return &param_obj_table[obj_id].entries[sub];
+}
+
+/**
+ * @brief 把参数值转换为浮点数用于范围检查
+ * @param entry 参数描述
+ * @param data  参数值（按参数类型与大小解释）
+ * @return 浮点值
+ */
+static float param_to_float(const param_entry_t *entry, const void *data) {
+    union { uint8_t u8; uint16_t u16; uint32_t u32; int8_t i8; int16_t i16; int32_t i32; float f; } v;
+
+    memcpy(&v, data, entry->size);
+    switch (entry->type) {
+        case PARAM_TYPE_FLOAT:
+            return v.f;
+        case PARAM_TYPE_INT:
+            return (entry->size == 1) ? (float)v.i8 : (entry->size == 2) ? (float)v.i16 : (float)v.i32;
+        case PARAM_TYPE_BOOL:
+        case PARAM_TYPE_UINT:
+        default:
+            return (entry->size == 1) ? (float)v.u8 : (entry->size == 2) ? (float)v.u16 : (float)v.u32;
+    }
+}
+
+/**
+ * @brief 读取参数实现函数
+ * @param dict 参数字典指针
+ * @param id   参数ID
+ * @param buf  输出缓冲区
+ * @param len  输入为缓冲区大小，输出为参数字节数
+ * @return 错误码
+ * @note   热参数对象读取影子副本，即最近一次写入的值（生效前后一致）
+ */
+static param_error_t param_impl_read(param_dict_t *dict, uint16_t id, void *buf, uint8_t *len) {
+    const param_entry_t *entry;
+    const uint8_t *src;
+    param_obj_t *obj;
+
+    if (dict == NULL || buf == NULL || len == NULL) {
+        return PARAM_ERROR_NULL_PTR;
+    }
+
+    entry = param_lookup(dict, id, &obj);
+    if (entry == NULL) {
+        return PARAM_ERROR_INVALID_ID;
+    }
+    if (obj->live == NULL) {
+        return PARAM_ERROR_UNBOUND;
+    }
+    if ((entry->access & PARAM_ACCESS_READ) == 0) {
+        return PARAM_ERROR_ACCESS;
+    }
+    if (*len < entry->size) {
+        return PARAM_ERROR_SIZE;
+    }
+
+    src = param_obj_table[PARAM_ID_OBJ(id)].is_hot ? (const uint8_t *)obj->shadow
+                                                   : (const uint8_t *)obj->live;
+    memcpy(buf, src + entry->offset, entry->size);
+    *len = entry->size;
+    dict->stats.reads++;
+    return PARAM_OK;
+}
+
+/**
+ * @brief 写入参数实现函数
+ * @param dict 参数字典指针
+ * @param id   参数ID
+ * @param data 参数值
+ * @param len  参数字节数，须与参数大小一致
+ * @return 错误码
+ * @note   普通对象直接写入实例；热参数对象写入影子副本并标记待生效，
+ *         由控制中断中的param_dict_sync整体拷贝，控制环不会看到写了一半的参数
+ */
+static param_error_t param_impl_write(param_dict_t *dict, uint16_t id, const void *data, uint8_t len) {
+    const param_entry_t *entry;
+    param_obj_t *obj;
+    float value;
+
+    if (dict == NULL || data == NULL) {
+        return PARAM_ERROR_NULL_PTR;
+    }
+
+    entry = param_lookup(dict, id, &obj);
+    if (entry == NULL) {
+        return PARAM_ERROR_INVALID_ID;
+    }
+    if (obj->live == NULL) {
+        return PARAM_ERROR_UNBOUND;
+    }
+    if ((entry->access & PARAM_ACCESS_WRITE) == 0 || len != entry->size) {
+        dict->stats.rejects++;
+        return ((entry->access & PARAM_ACCESS_WRITE) == 0) ? PARAM_ERROR_ACCESS : PARAM_ERROR_SIZE;
+    }
+
+    value = param_to_float(entry, data);
+    if (!(value >= entry->min && value <= entry->max)) {
+        dict->stats.rejects++;
+        return PARAM_ERROR_RANGE;
+    }
+
+    if (param_obj_table[PARAM_ID_OBJ(id)].is_hot) {
+        // 控制环尚未取走上一次更新，影子副本不可改写
+        if (atomic_load_explicit(&obj->is_pending, memory_order_acquire)) {
+            dict->stats.busy++;
+            return PARAM_ERROR_BUSY;
+        }
+        memcpy((uint8_t *)obj->shadow + entry->offset, data, entry->size);
+        atomic_store_explicit(&obj->is_pending, true, memory_order_release);
+    } else {
+        memcpy((uint8_t *)obj->live + entry->offset, data, entry->size);
+    }
+
+    dict->stats.writes++;
+    if (obj->on_change != NULL) {
+        obj->on_change(id, param_obj_table[PARAM_ID_OBJ(id)].is_hot ? (void *)obj->shadow : obj->live,
+                       obj->ctx);
+    }
+    return PARAM_OK;
+}
+
+/* ==================== 公共函数实现 ==================== */
+
+/**
+ * @brief 参数字典初始化函数
+ * @param dict 参数字典指针
+ * @return 初始化状态，0表示成功，非0表示失败
+ */
+uint8_t param_dict_init(param_dict_t *dict) {
+    uint8_t i;
+
+    // 检查指针有效性
+    if (dict == NULL) {
+        return 1;
+    }
+
+    for (i = 0; i < PARAM_OBJ_NUM; i++) {
+        dict->obj[i].live = NULL;
+        dict->obj[i].on_change = NULL;
+        dict->obj[i].ctx = NULL;
+        atomic_init(&dict->obj[i].is_pending, false);
+    }
+    dict->stats = (param_stats_t){0};
+
+    // 绑定函数指针（面向对象核心）
+    dict->read = param_impl_read;
+    dict->write = param_impl_write;
+
+    return 0;
+}
+
+/**
+ * @brief 绑定参数对象实例
+ * @param dict      参数字典指针
+ * @param obj_id    对象编号
+ * @param live      对象实例（如&foc_motor.pid_q）
+ * @param on_change 变更回调，可为NULL
+ * @param ctx       回调上下文
+ * @return 绑定状态，0表示成功，非0表示失败
+ * @note   热参数对象绑定时以实例当前值初始化影子副本，此后只应通过字典修改
+ */
+uint8_t param_dict_bind(param_dict_t *dict, uint8_t obj_id, void *live,
+                        param_change_fn on_change, void *ctx) {
+    param_obj_t *obj;
+
+    if (dict == NULL || live == NULL || obj_id >= PARAM_OBJ_NUM) {
+        return 1;
+    }
+
+    obj = &dict->obj[obj_id];
+    if (param_obj_table[obj_id].is_hot) {
+        memcpy(obj->shadow, live, param_obj_table[obj_id].obj_size);
+        atomic_store_explicit(&obj->is_pending, false, memory_order_relaxed);
+    }
+    obj->on_change = on_change;
+    obj->ctx = ctx;
+    obj->live = live;
+
+    return 0;
+}
+
+/**
+ * @brief 热参数生效（控制中断中调用）
+ * @param dict 参数字典指针
+ * @note   每个控制周期开始时调用，开销为每个热参数对象一次标志检查，
+ *         有待生效的更新时再加一次对象拷贝（不超过PARAM_SHADOW_WORDS个字）；
+ *         memcpy仍在FLASH中执行，只在有更新的周期调用一次，不在常态路径上
+ */
+FAST_RAM_CODE
+void param_dict_sync(param_dict_t *dict) {
+    param_obj_t *obj;
+    uint8_t i;
+
+    for (i = 0; i < PARAM_OBJ_NUM; i++) {
+        obj = &dict->obj[i];
+        if (!param_obj_table[i].is_hot ||
+            !atomic_load_explicit(&obj->is_pending, memory_order_acquire)) {
+            continue;
+        }
+        memcpy(obj->live, obj->shadow, param_obj_table[i].obj_size);
+        atomic_store_explicit(&obj->is_pending, false, memory_order_release);
+        dict->stats.syncs++;
+    }
+}
+
+/**
+ * @brief 获取参数描述
+ * @param id 参数ID
+ * @return 参数描述指针，ID不存在时返回NULL
+ * @note   供外部工具枚举参数名、类型与范围：对象编号0~PARAM_OBJ_NUM-1，
+ *         子索引0~entry_num-1
+ */
+const param_entry_t *param_dict_get_entry(uint16_t id) {
+    uint8_t obj_id = PARAM_ID_OBJ(id);
+    uint8_t sub = PARAM_ID_SUB(id);
+
+    if (obj_id >= PARAM_OBJ_NUM || sub >= param_obj_table[obj_id].entry_num) {
+        return NULL;
+    }
+    return &param_obj_table[obj_id].entries[sub];
+}
+
+/**
+ * @brief 获取参数对象描述
+ * @param obj_id 对象编号
+ * @return 对象描述指针，编号不存在时返回NULL
+ */
+const param_obj_desc_t *param_dict_get_obj(uint8_t obj_id) {
+    return (obj_id < PARAM_OBJ_NUM) ? &param_obj_table[obj_id] : NULL;
+}
+
+/* ==================== 使用示例 ==================== */
+
+/*
+ * 使用示例：
+ *
+ * static param_dict_t params;
+ *
+ * // 传感器配置变更后下发到器件
+ * static void sensor_config_changed(uint16_t id, void *obj, void *ctx) {
+ *     sensor_device_id_t dev = (sensor_device_id_t)(uintptr_t)ctx;
+ *     sensor_dev_select(dev);
+ *     sensor_device_table[dev].driver->set_config((sensor_config_t *)obj);
+ * }
+ *
+ * int main(void) {
+ *     motor_init(&foc_motor);
+ *
+ *     param_dict_init(&params);
+ *     param_dict_bind(&params, PARAM_OBJ_MOTOR_CONFIG, &foc_motor.config, NULL, NULL);
+ *     param_dict_bind(&params, PARAM_OBJ_PID_D, &foc_motor.pid_d, NULL, NULL);
+ *     param_dict_bind(&params, PARAM_OBJ_PID_Q, &foc_motor.pid_q, NULL, NULL);
+ *     param_dict_bind(&params, PARAM_OBJ_SENSOR_CONFIG,
+ *                     &sensor_dev_states[SENSOR_DEV_IMU_0].config,
+ *                     sensor_config_changed, (void *)(uintptr_t)SENSOR_DEV_IMU_0);
+ * }
+ *
+ * // 协议任务：远程整定Q轴比例系数
+ * void tuning_task(void) {
+ *     float kp = 0.8f;
+ *     param_error_t err = params.write(&params, PARAM_ID(PARAM_OBJ_PID_Q, PARAM_SUB_PID_KP),
+ *                                      &kp, sizeof(kp));
+ *     if (err == PARAM_ERROR_BUSY) {
+ *         // 上一次更新将在下一个控制周期生效，稍后重试
+ *     }
+ * }
+ *
+ * // 电流环中断开头：热参数一次性生效
+ * void ADC_IRQHandler(void) {
+ *     param_dict_sync(&params);
+ *     motor_current_loop_isr(&foc_motor);
+ * }
+ *
+ * // 外部工具枚举全部参数
+ * for (uint8_t o = 0; o < PARAM_OBJ_NUM; o++) {
+ *     const param_obj_desc_t *desc = param_dict_get_obj(o);
+ *     for (uint8_t s = 0; s < desc->entry_num; s++) {
+ *         // PARAM_ID(o, s)、desc->name、desc->entries[s].name/type/min/max/access
+ *     }
+ * }
+ */
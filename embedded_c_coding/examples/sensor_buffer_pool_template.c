@@ -0,0 +1,516 @@
+/**
+ * @file sensor_buffer_pool_template.c
+ * @brief 传感器零拷贝缓冲池模板文件
+ * @description 为FIFO突发采样提供静态缓冲池：DMA直接写入池内缓冲区，
+ *              缓冲区所有权以句柄形式在驱动与消费者之间传递，
+ *              释放后归还缓冲池，全程无动态分配、无数据拷贝
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+/* ==================== 宏定义 ==================== */
+
+#define SENSOR_BUF_COUNT           8       // 缓冲区数量（不超过32，受空闲位图宽度限制）
+#define SENSOR_BUF_SAMPLES         256     // 每个缓冲区可容纳的采样点数
+#define SENSOR_BUF_ALIGN           32      // 缓冲区对齐字节数（满足DMA与Cache行要求）
+#define SENSOR_BUF_HANDLE_INVALID  0xFF    // 无效句柄
+#define SENSOR_BUF_READY_DEPTH     (SENSOR_BUF_COUNT + 1)  // 就绪队列深度（留一空位区分满/空）
+
+// 定义缓冲池及其专属存储：每个缓冲池拥有独立的对齐数据区，多个缓冲池互不覆盖
+#define SENSOR_BUF_POOL_DEFINE(var)                                     \
+    _Static_assert((SENSOR_BUF_SAMPLES * sizeof(uint16_t)) % SENSOR_BUF_ALIGN == 0, \
+                   #var " buffer size must keep every buffer aligned"); \
+    static _Alignas(SENSOR_BUF_ALIGN) uint16_t                          \
+        var##_storage[SENSOR_BUF_COUNT][SENSOR_BUF_SAMPLES];            \
+    sensor_buf_pool_t var = {                                           \
+        .storage = var##_storage,                                       \
+    }
+
+/* ==================== 类型定义 ==================== */
+
+/**
+ * @brief 缓冲池错误码枚举
+ */
+typedef enum {
+    SENSOR_BUF_OK = 0,             /**< 成功 */
+    SENSOR_BUF_ERROR_NULL_PTR,     /**< 空指针错误 */
+    SENSOR_BUF_ERROR_INVALID,      /**< 无效句柄或状态不符 */
+    SENSOR_BUF_ERROR_EMPTY,        /**< 无可用缓冲区 */
+    SENSOR_BUF_ERROR_FULL          /**< 就绪队列已满 */
+} sensor_buf_error_t;
+
+/**
+ * @brief 缓冲区所有权状态枚举
+ */
+typedef enum {
+    SENSOR_BUF_STATE_FREE = 0,     /**< 空闲，位于缓冲池中 */
+    SENSOR_BUF_STATE_DMA,          /**< DMA正在写入 */
+    SENSOR_BUF_STATE_READY,        /**< 已填满，等待消费者取走 */
+    SENSOR_BUF_STATE_OWNED         /**< 已被消费者持有 */
+} sensor_buf_state_t;
+
+/**
+ * @brief 缓冲区句柄（缓冲区在池中的索引）
+ */
+typedef uint8_t sensor_buf_handle_t;
+
+/**
+ * @brief 缓冲区描述符
+ */
+typedef struct {
+    uint16_t *samples;             /**< 采样数据区（指向静态存储） */
+    uint16_t count;                /**< 有效采样点数 */
+    uint32_t timestamp;            /**< 首个采样点时间戳 */
+    atomic_uint_least8_t state;    /**< 所有权状态（sensor_buf_state_t） */
+} sensor_buf_desc_t;
+
+/**
+ * @brief 拷贝统计结构体
+ * @note  handoff_bytes为以句柄交付的数据量，copy_bytes为兼容接口实际搬运的数据量，
+ *        两者均为实测计数，用于确认数据只经句柄交付
+ */
+typedef struct {
+    uint32_t handoff_bytes;        /**< 以句柄交付的字节数（零拷贝） */
+    uint32_t copy_bytes;           /**< 兼容接口实际拷贝的字节数 */
+    uint32_t buffers_delivered;    /**< 已交付缓冲区数量 */
+    uint32_t dma_overruns;         /**< DMA无空闲缓冲区可用次数 */
+} sensor_buf_stats_t;
+
+/* === 前向声明 === */
+
+typedef struct sensor_buf_pool_t sensor_buf_pool_t;
+
+/* === 函数指针类型定义 === */
+
+/**
+ * @brief 启动DMA函数指针类型（由底层驱动提供）
+ * @note  dst为池内缓冲区地址，DMA直接写入，不经过中间缓冲
+ */
+typedef bool (*sensor_buf_dma_start_fn)(void *ctx, uint16_t *dst, uint16_t samples);
+
+/**
+ * @brief 申请空闲缓冲区函数指针类型
+ */
+typedef sensor_buf_handle_t (*sensor_buf_pool_acquire_fn)(sensor_buf_pool_t *pool);
+
+/**
+ * @brief 提交已填满缓冲区函数指针类型
+ */
+typedef sensor_buf_error_t (*sensor_buf_pool_commit_fn)(sensor_buf_pool_t *pool,
+                                                        sensor_buf_handle_t handle,
+                                                        uint16_t count,
+                                                        uint32_t timestamp);
+
+/**
+ * @brief 取走就绪缓冲区函数指针类型
+ */
+typedef sensor_buf_handle_t (*sensor_buf_pool_fetch_fn)(sensor_buf_pool_t *pool);
+
+/**
+ * @brief 获取缓冲区描述符函数指针类型
+ */
+typedef const sensor_buf_desc_t *(*sensor_buf_pool_peek_fn)(sensor_buf_pool_t *pool,
+                                                            sensor_buf_handle_t handle);
+
+/**
+ * @brief 释放缓冲区函数指针类型
+ */
+typedef sensor_buf_error_t (*sensor_buf_pool_release_fn)(sensor_buf_pool_t *pool,
+                                                         sensor_buf_handle_t handle);
+
+/**
+ * @brief 传感器缓冲池结构体
+ * @note  采用面向对象思想封装，由SENSOR_BUF_POOL_DEFINE定义并绑定专属静态存储，
+ *        空闲位图和就绪队列均为无锁实现
+ */
+struct sensor_buf_pool_t {
+    /* 配置（由SENSOR_BUF_POOL_DEFINE在编译期填写） */
+    uint16_t (*storage)[SENSOR_BUF_SAMPLES];  /**< 缓冲区数据存储区 */
+
+    /* 硬件配置 */
+    sensor_buf_dma_start_fn dma_start;   /**< DMA启动回调 */
+    void *dma_ctx;                       /**< DMA回调上下文 */
+
+    /* 运行状态 */
+    sensor_buf_desc_t desc[SENSOR_BUF_COUNT];            /**< 缓冲区描述符表 */
+    atomic_uint_least32_t free_mask;                     /**< 空闲位图，1表示空闲 */
+    sensor_buf_handle_t ready[SENSOR_BUF_READY_DEPTH];   /**< 就绪队列（单生产者单消费者） */
+    atomic_uint_least8_t ready_head;                     /**< 就绪队列写位置（DMA中断写） */
+    atomic_uint_least8_t ready_tail;                     /**< 就绪队列读位置（消费者写） */
+    sensor_buf_handle_t dma_handle;                      /**< 当前DMA目标缓冲区 */
+    sensor_buf_stats_t stats;                            /**< 拷贝统计 */
+
+    /* 函数指针 - 操作方法 */
+    sensor_buf_pool_acquire_fn acquire;  /**< 申请空闲缓冲区 */
+    sensor_buf_pool_commit_fn  commit;   /**< 提交已填满缓冲区 */
+    sensor_buf_pool_fetch_fn   fetch;    /**< 取走就绪缓冲区 */
+    sensor_buf_pool_peek_fn    peek;     /**< 获取缓冲区描述符 */
+    sensor_buf_pool_release_fn release;  /**< 释放缓冲区 */
+};
+
+/* ==================== 静态函数声明 ==================== */
+
+static sensor_buf_handle_t sensor_buf_impl_acquire(sensor_buf_pool_t *pool);
+static sensor_buf_error_t sensor_buf_impl_commit(sensor_buf_pool_t *pool,
+                                                 sensor_buf_handle_t handle,
+                                                 uint16_t count,
+                                                 uint32_t timestamp);
+static sensor_buf_handle_t sensor_buf_impl_fetch(sensor_buf_pool_t *pool);
+static const sensor_buf_desc_t *sensor_buf_impl_peek(sensor_buf_pool_t *pool,
+                                                     sensor_buf_handle_t handle);
+static sensor_buf_error_t sensor_buf_impl_release(sensor_buf_pool_t *pool,
+                                                  sensor_buf_handle_t handle);
+
+/* ==================== 静态函数实现 ==================== */
+
+/**
+ * @brief 申请空闲缓冲区实现函数
+ * @param pool 缓冲池结构体指针
+ * @return 缓冲区句柄，无空闲时返回SENSOR_BUF_HANDLE_INVALID
+ * @note   通过CAS清除空闲位图最低位实现无锁分配，可在中断中调用
+ */
+static sensor_buf_handle_t sensor_buf_impl_acquire(sensor_buf_pool_t *pool) {
+    uint32_t mask;
+    uint32_t bit;
+
+    if (pool == NULL) {
+        return SENSOR_BUF_HANDLE_INVALID;
+    }
+
+    mask = atomic_load_explicit(&pool->free_mask, memory_order_acquire);
+    do {
+        if (mask == 0) {
+            return SENSOR_BUF_HANDLE_INVALID;
+        }
+        // 取最低位空闲缓冲区
+        bit = mask & (~mask + 1U);
+    } while (!atomic_compare_exchange_weak_explicit(&pool->free_mask, &mask, mask & ~bit,
+                                                    memory_order_acq_rel,
+                                                    memory_order_acquire));
+
+    return (sensor_buf_handle_t)__builtin_ctz(bit);
+}
+
+/**
+ * @brief 提交已填满缓冲区实现函数
+ * @param pool      缓冲池结构体指针
+ * @param handle    缓冲区句柄
+ * @param count     有效采样点数
+ * @param timestamp 首个采样点时间戳
+ * @return 错误码
+ * @note   仅由DMA完成中断（单生产者）调用，只写入句柄，不搬运数据
+ */
+static sensor_buf_error_t sensor_buf_impl_commit(sensor_buf_pool_t *pool,
+                                                 sensor_buf_handle_t handle,
+                                                 uint16_t count,
+                                                 uint32_t timestamp) {
+    uint8_t head;
+    uint8_t next;
+
+    if (pool == NULL) {
+        return SENSOR_BUF_ERROR_NULL_PTR;
+    }
+    if (handle >= SENSOR_BUF_COUNT || count > SENSOR_BUF_SAMPLES) {
+        return SENSOR_BUF_ERROR_INVALID;
+    }
+
+    head = atomic_load_explicit(&pool->ready_head, memory_order_relaxed);
+    next = (uint8_t)((head + 1U) % SENSOR_BUF_READY_DEPTH);
+    if (next == atomic_load_explicit(&pool->ready_tail, memory_order_acquire)) {
+        return SENSOR_BUF_ERROR_FULL;
+    }
+
+    // 填写描述符后再发布句柄，保证消费者看到完整数据
+    pool->desc[handle].count = count;
+    pool->desc[handle].timestamp = timestamp;
+    atomic_store_explicit(&pool->desc[handle].state, SENSOR_BUF_STATE_READY, memory_order_relaxed);
+    pool->ready[head] = handle;
+    atomic_store_explicit(&pool->ready_head, next, memory_order_release);
+
+    return SENSOR_BUF_OK;
+}
+
+/**
+ * @brief 取走就绪缓冲区实现函数
+ * @param pool 缓冲池结构体指针
+ * @return 缓冲区句柄，无就绪缓冲区时返回SENSOR_BUF_HANDLE_INVALID
+ * @note   调用后所有权转移给消费者，消费者可继续将句柄转交给其他任务
+ */
+static sensor_buf_handle_t sensor_buf_impl_fetch(sensor_buf_pool_t *pool) {
+    uint8_t tail;
+    sensor_buf_handle_t handle;
+
+    if (pool == NULL) {
+        return SENSOR_BUF_HANDLE_INVALID;
+    }
+
+    tail = atomic_load_explicit(&pool->ready_tail, memory_order_relaxed);
+    if (tail == atomic_load_explicit(&pool->ready_head, memory_order_acquire)) {
+        return SENSOR_BUF_HANDLE_INVALID;
+    }
+
+    handle = pool->ready[tail];
+    atomic_store_explicit(&pool->desc[handle].state, SENSOR_BUF_STATE_OWNED, memory_order_release);
+    atomic_store_explicit(&pool->ready_tail,
+                          (uint8_t)((tail + 1U) % SENSOR_BUF_READY_DEPTH),
+                          memory_order_release);
+
+    // 统计零拷贝交付量
+    pool->stats.handoff_bytes += (uint32_t)pool->desc[handle].count * sizeof(uint16_t);
+    pool->stats.buffers_delivered++;
+
+    return handle;
+}
+
+/**
+ * @brief 获取缓冲区描述符实现函数
+ * @param pool   缓冲池结构体指针
+ * @param handle 缓冲区句柄
+ * @return 描述符指针，句柄无效或未被持有时返回NULL
+ */
+static const sensor_buf_desc_t *sensor_buf_impl_peek(sensor_buf_pool_t *pool,
+                                                     sensor_buf_handle_t handle) {
+    if (pool == NULL || handle >= SENSOR_BUF_COUNT) {
+        return NULL;
+    }
+    if (atomic_load_explicit(&pool->desc[handle].state, memory_order_acquire) != SENSOR_BUF_STATE_OWNED) {
+        return NULL;
+    }
+    return &pool->desc[handle];
+}
+
+/**
+ * @brief 释放缓冲区实现函数
+ * @param pool   缓冲池结构体指针
+ * @param handle 缓冲区句柄
+ * @return 错误码
+ * @note   状态检查与OWNED→FREE转换由一次CAS完成，并发或重复释放时只有一方成功，
+ *         其余返回SENSOR_BUF_ERROR_INVALID；随后以原子或操作置位空闲位图，任意上下文均可释放
+ */
+static sensor_buf_error_t sensor_buf_impl_release(sensor_buf_pool_t *pool,
+                                                  sensor_buf_handle_t handle) {
+    uint_least8_t expected = SENSOR_BUF_STATE_OWNED;
+
+    if (pool == NULL) {
+        return SENSOR_BUF_ERROR_NULL_PTR;
+    }
+    if (handle >= SENSOR_BUF_COUNT ||
+        !atomic_compare_exchange_strong_explicit(&pool->desc[handle].state, &expected,
+                                                 SENSOR_BUF_STATE_FREE,
+                                                 memory_order_acq_rel, memory_order_acquire)) {
+        return SENSOR_BUF_ERROR_INVALID;
+    }
+
+    // 位图置位前清理描述符，重新分配者看到的是干净的缓冲区
+    pool->desc[handle].count = 0;
+    atomic_fetch_or_explicit(&pool->free_mask, 1UL << handle, memory_order_release);
+
+    return SENSOR_BUF_OK;
+}
+
+/**
+ * @brief 为DMA申请下一个缓冲区并启动传输
+ * @param pool 缓冲池结构体指针
+ * @return true启动成功，false无空闲缓冲区或DMA启动失败
+ */
+static bool sensor_buf_arm_dma(sensor_buf_pool_t *pool) {
+    sensor_buf_handle_t handle = pool->acquire(pool);
+
+    if (handle == SENSOR_BUF_HANDLE_INVALID) {
+        pool->dma_handle = SENSOR_BUF_HANDLE_INVALID;
+        pool->stats.dma_overruns++;
+        return false;
+    }
+
+    atomic_store_explicit(&pool->desc[handle].state, SENSOR_BUF_STATE_DMA, memory_order_relaxed);
+    pool->dma_handle = handle;
+
+    if (!pool->dma_start(pool->dma_ctx, pool->desc[handle].samples, SENSOR_BUF_SAMPLES)) {
+        atomic_store_explicit(&pool->desc[handle].state, SENSOR_BUF_STATE_OWNED, memory_order_relaxed);
+        pool->release(pool, handle);
+        pool->dma_handle = SENSOR_BUF_HANDLE_INVALID;
+        return false;
+    }
+
+    return true;
+}
+
+/* ==================== 公共函数实现 ==================== */
+
+/**
+ * @brief 缓冲池初始化函数
+ * @param pool      由SENSOR_BUF_POOL_DEFINE定义的缓冲池指针
+ * @param dma_start DMA启动回调
+ * @param dma_ctx   DMA回调上下文
+ * @return 错误码
+ */
+sensor_buf_error_t sensor_buf_pool_init(sensor_buf_pool_t *pool,
+                                        sensor_buf_dma_start_fn dma_start,
+                                        void *dma_ctx) {
+    uint8_t i;
+
+    // 检查指针有效性
+    if (pool == NULL || pool->storage == NULL || dma_start == NULL) {
+        return SENSOR_BUF_ERROR_NULL_PTR;
+    }
+
+    // 绑定硬件配置
+    pool->dma_start = dma_start;
+    pool->dma_ctx = dma_ctx;
+
+    // 描述符指向本缓冲池的专属存储区
+    for (i = 0; i < SENSOR_BUF_COUNT; i++) {
+        pool->desc[i].samples = pool->storage[i];
+        pool->desc[i].count = 0;
+        pool->desc[i].timestamp = 0;
+        atomic_init(&pool->desc[i].state, SENSOR_BUF_STATE_FREE);
+    }
+
+    atomic_init(&pool->free_mask, (SENSOR_BUF_COUNT >= 32) ? 0xFFFFFFFFUL
+                                                           : ((1UL << SENSOR_BUF_COUNT) - 1UL));
+    atomic_init(&pool->ready_head, 0);
+    atomic_init(&pool->ready_tail, 0);
+    pool->dma_handle = SENSOR_BUF_HANDLE_INVALID;
+    pool->stats = (sensor_buf_stats_t){0};
+
+    // 绑定函数指针（面向对象核心）
+    pool->acquire = sensor_buf_impl_acquire;
+    pool->commit = sensor_buf_impl_commit;
+    pool->fetch = sensor_buf_impl_fetch;
+    pool->peek = sensor_buf_impl_peek;
+    pool->release = sensor_buf_impl_release;
+
+    return SENSOR_BUF_OK;
+}
+
+/**
+ * @brief 启动DMA采集
+ * @param pool 缓冲池结构体指针
+ * @return 错误码
+ */
+sensor_buf_error_t sensor_buf_pool_start(sensor_buf_pool_t *pool) {
+    if (pool == NULL) {
+        return SENSOR_BUF_ERROR_NULL_PTR;
+    }
+    return sensor_buf_arm_dma(pool) ? SENSOR_BUF_OK : SENSOR_BUF_ERROR_EMPTY;
+}
+
+/**
+ * @brief DMA传输完成中断处理函数
+ * @param pool      缓冲池结构体指针
+ * @param count     本次写入的采样点数
+ * @param timestamp 首个采样点时间戳
+ * @note   提交当前缓冲区并立即为下一次突发准备新的缓冲区
+ */
+void sensor_buf_pool_dma_complete_isr(sensor_buf_pool_t *pool, uint16_t count, uint32_t timestamp) {
+    sensor_buf_handle_t done;
+
+    if (pool == NULL || pool->dma_handle == SENSOR_BUF_HANDLE_INVALID) {
+        return;
+    }
+
+    done = pool->dma_handle;
+    if (pool->commit(pool, done, count, timestamp) != SENSOR_BUF_OK) {
+        // 就绪队列已满，丢弃本次数据并归还缓冲区
+        atomic_store_explicit(&pool->desc[done].state, SENSOR_BUF_STATE_OWNED, memory_order_relaxed);
+        pool->release(pool, done);
+        pool->stats.dma_overruns++;
+    }
+
+    sensor_buf_arm_dma(pool);
+}
+
+/**
+ * @brief 拷贝输出兼容接口
+ * @param pool   缓冲池结构体指针
+ * @param handle 缓冲区句柄
+ * @param data   目标数组
+ * @param max    目标数组容量（采样点数）
+ * @return 实际拷贝的采样点数
+ * @note   仅供仍使用uint16_t *data接口的旧代码过渡，拷贝量计入copy_bytes统计
+ */
+uint16_t sensor_buf_pool_copy_out(sensor_buf_pool_t *pool, sensor_buf_handle_t handle,
+                                  uint16_t *data, uint16_t max) {
+    const sensor_buf_desc_t *desc;
+    uint16_t n;
+    uint16_t i;
+
+    if (data == NULL) {
+        return 0;
+    }
+    desc = sensor_buf_impl_peek(pool, handle);
+    if (desc == NULL) {
+        return 0;
+    }
+
+    n = (desc->count < max) ? desc->count : max;
+    for (i = 0; i < n; i++) {
+        data[i] = desc->samples[i];
+    }
+    pool->stats.copy_bytes += (uint32_t)n * sizeof(uint16_t);
+
+    return n;
+}
+
+/**
+ * @brief 获取拷贝统计
+ * @param pool  缓冲池结构体指针
+ * @param stats 统计输出指针
+ * @return 错误码
+ */
+sensor_buf_error_t sensor_buf_pool_get_stats(const sensor_buf_pool_t *pool, sensor_buf_stats_t *stats) {
+    if (pool == NULL || stats == NULL) {
+        return SENSOR_BUF_ERROR_NULL_PTR;
+    }
+    *stats = pool->stats;
+    return SENSOR_BUF_OK;
+}
+
+/* ==================== 使用示例 ==================== */
+
+/*
+ * 使用示例：
+ *
+ * SENSOR_BUF_POOL_DEFINE(fifo_pool);     // 缓冲池与其专属存储区
+ *
+ * // 底层驱动：将池内缓冲区地址直接配置为DMA目标地址
+ * static bool fifo_dma_start(void *ctx, uint16_t *dst, uint16_t samples) {
+ *     HAL_I2C_Mem_Read_DMA((I2C_HandleTypeDef *)ctx, SENSOR_I2C_ADDR << 1,
+ *                          SENSOR_REG_DATA, I2C_MEMADD_SIZE_8BIT,
+ *                          (uint8_t *)dst, samples * 2);
+ *     return true;
+ * }
+ *
+ * // DMA完成中断
+ * void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c) {
+ *     sensor_buf_pool_dma_complete_isr(&fifo_pool, SENSOR_BUF_SAMPLES, get_tick());
+ * }
+ *
+ * // 消费者任务：取得句柄即取得所有权，处理完毕后释放
+ * void sensor_task(void) {
+ *     sensor_buf_handle_t h = fifo_pool.fetch(&fifo_pool);
+ *     const sensor_buf_desc_t *buf;
+ *     sensor_buf_stats_t stats;
+ *
+ *     if (h != SENSOR_BUF_HANDLE_INVALID) {
+ *         buf = fifo_pool.peek(&fifo_pool, h);
+ *         process_samples(buf->samples, buf->count);   // 原地处理，无拷贝
+ *         fifo_pool.release(&fifo_pool, h);
+ *     }
+ *
+ *     // 确认数据只经句柄交付
+ *     sensor_buf_pool_get_stats(&fifo_pool, &stats);
+ *     // stats.handoff_bytes 为交付量，未使用兼容接口时 stats.copy_bytes == 0
+ * }
+ *
+ * int main(void) {
+ *     sensor_buf_pool_init(&fifo_pool, fifo_dma_start, &hi2c1);
+ *     sensor_buf_pool_start(&fifo_pool);
+ *     while (1) {
+ *         sensor_task();
+ *     }
+ * }
+ */
@@ -0,0 +1,936 @@
+/**
+ * @file sensor_bus_arbiter_template.c
+ * @brief 传感器共享总线优先级仲裁器模板文件
+ * @description 多个任务经sensor_read_reg访问同一路I2C总线时，由仲裁器串行化访问：
+ *              等待请求按优先级排队，总线以单个事务为粒度授予，持有者在事务之间
+ *              让出总线给更高优先级的请求；持有期间继承最高等待者的优先级，
+ *              使高优先级请求的最坏等待时间不超过一个事务的持有时间；
+ *              定义BUS_ARB_PORT_OSAL后临界区、等待/唤醒、时间与优先级继承均基于osal_template.c，
+ *              再定义OSAL_PORT_POSIX即可在Linux上以多线程运行仲裁器自测
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef BUS_ARB_PORT_OSAL
+#include "osal_template.c"     // 与OSAL在同一编译单元构建，不再单独编译osal_template.c
+#endif
+
+/* ==================== 宏定义 ==================== */
+
+#define BUS_ARB_PRIO_NUM           8       // 请求优先级数量，数值越大优先级越高
+
+// 临界区保护（仲裁状态在多个任务间共享），目标平台替换为关/开中断或调度锁
+#if defined(BUS_ARB_PORT_OSAL)
+#define BUS_ARB_ENTER_CRITICAL()   (bus_arb_irq_state = osal_enter_critical())
+#define BUS_ARB_EXIT_CRITICAL()    osal_exit_critical(bus_arb_irq_state)
+#elif !defined(BUS_ARB_ENTER_CRITICAL)
+#define BUS_ARB_ENTER_CRITICAL()   ((void)0)
+#define BUS_ARB_EXIT_CRITICAL()    ((void)0)
+#endif
+
+/* ==================== 类型定义 ==================== */
+
+/**
+ * @brief 仲裁器错误码枚举
+ */
+typedef enum {
+    BUS_ARB_OK = 0,                /**< 成功 */
+    BUS_ARB_ERROR_NULL_PTR,        /**< 空指针错误 */
+    BUS_ARB_ERROR_INVALID_PARAM,   /**< 无效参数 */
+    BUS_ARB_ERROR_NOT_OWNER        /**< 调用方未持有总线 */
+} bus_arb_error_t;
+
+/**
+ * @brief 仲裁统计结构体
+ */
+typedef struct {
+    uint32_t grants;                           /**< 授予次数 */
+    uint32_t contended;                        /**< 需要排队的请求数 */
+    uint32_t preemptions;                      /**< 事务间让出给更高优先级的次数 */
+    uint32_t inherits;                         /**< 优先级继承次数 */
+    uint32_t max_hold_us;                      /**< 单事务最长持有时间（微秒） */
+    uint32_t max_wait_us[BUS_ARB_PRIO_NUM];    /**< 各优先级最长等待时间（微秒） */
+} bus_arb_stats_t;
+
+/* === 前向声明 === */
+
+typedef struct bus_arb_req_t bus_arb_req_t;
+typedef struct bus_arb_t bus_arb_t;
+
+/* === 函数指针类型定义 === */
+
+/**
+ * @brief 获取微秒时间函数指针类型（平台移植接口）
+ */
+typedef uint32_t (*bus_arb_get_time_us_fn)(void);
+
+/**
+ * @brief 阻塞等待函数指针类型（平台移植接口，如获取请求方信号量）
+ * @note  返回后仲裁器重新检查授予标志，允许虚假唤醒
+ */
+typedef void (*bus_arb_wait_fn)(bus_arb_req_t *req);
+
+/**
+ * @brief 唤醒函数指针类型（平台移植接口，如释放请求方信号量）
+ */
+typedef void (*bus_arb_wake_fn)(bus_arb_req_t *req);
+
+/**
+ * @brief 设置任务优先级函数指针类型（平台移植接口，可为NULL表示不做继承）
+ */
+typedef void (*bus_arb_set_prio_fn)(void *task, uint8_t prio);
+
+/**
+ * @brief 获取总线函数指针类型
+ */
+typedef bus_arb_error_t (*bus_arb_acquire_fn)(bus_arb_t *arb, bus_arb_req_t *req);
+
+/**
+ * @brief 释放总线函数指针类型
+ */
+typedef bus_arb_error_t (*bus_arb_release_fn)(bus_arb_t *arb, bus_arb_req_t *req);
+
+/**
+ * @brief 事务间让出函数指针类型
+ */
+typedef bus_arb_error_t (*bus_arb_yield_fn)(bus_arb_t *arb, bus_arb_req_t *req);
+
+/**
+ * @brief 总线请求结构体
+ * @note  每个访问总线的任务持有一个，由调用方静态分配
+ */
+struct bus_arb_req_t {
+    uint8_t prio;                  /**< 请求优先级（0~BUS_ARB_PRIO_NUM-1） */
+    void *task;                    /**< 任务句柄，用于优先级继承 */
+    void *ctx;                     /**< 平台等待对象（如osal_sem_t） */
+    volatile bool is_granted;      /**< 已获得总线 */
+    uint32_t enqueue_us;           /**< 发起请求时刻 */
+    bus_arb_req_t *next;           /**< 等待链表 */
+};
+
+/**
+ * @brief 总线仲裁器结构体（每路总线一个）
+ */
+struct bus_arb_t {
+    /* 平台移植接口 */
+    bus_arb_get_time_us_fn get_time_us;    /**< 获取时间 */
+    bus_arb_wait_fn wait;                  /**< 阻塞等待 */
+    bus_arb_wake_fn wake;                  /**< 唤醒 */
+    bus_arb_set_prio_fn set_prio;          /**< 设置任务优先级 */
+
+    /* 运行状态 */
+    bus_arb_req_t *owner;                  /**< 当前持有者 */
+    bus_arb_req_t *wait_head;              /**< 等待链表（优先级降序，同级先到先得） */
+    uint8_t owner_prio;                    /**< 持有者当前有效优先级（含继承） */
+    uint32_t hold_start_us;                /**< 当前事务开始时刻 */
+    bus_arb_stats_t stats;                 /**< 统计 */
+
+    /* 函数指针 - 操作方法 */
+    bus_arb_acquire_fn acquire;            /**< 获取总线 */
+    bus_arb_release_fn release;            /**< 释放总线 */
+    bus_arb_yield_fn yield;                /**< 事务间让出 */
+};
+
+/* ==================== 静态函数声明 ==================== */
+
+static bus_arb_error_t bus_arb_impl_acquire(bus_arb_t *arb, bus_arb_req_t *req);
+static bus_arb_error_t bus_arb_impl_release(bus_arb_t *arb, bus_arb_req_t *req);
+static bus_arb_error_t bus_arb_impl_yield(bus_arb_t *arb, bus_arb_req_t *req);
+static void bus_arb_enqueue(bus_arb_t *arb, bus_arb_req_t *req);
+static void bus_arb_end_hold(bus_arb_t *arb, uint32_t now);
+#ifdef BUS_ARB_PORT_OSAL
+static uint32_t bus_arb_osal_time_us(void);
+static void bus_arb_osal_wait(bus_arb_req_t *req);
+static void bus_arb_osal_wake(bus_arb_req_t *req);
+static void bus_arb_osal_set_prio(void *task, uint8_t prio);
+#endif
+
+/* ==================== 静态变量 ==================== */
+
+#ifdef BUS_ARB_PORT_OSAL
+// 临界区进入前的中断状态，只在临界区内写入，不会被并发覆盖
+static uint32_t bus_arb_irq_state;
+#endif
+
+/* ==================== 静态函数实现 ==================== */
+
+/**
+ * @brief 将请求按优先级插入等待链表
+ * @param arb 仲裁器结构体指针
+ * @param req 请求指针
+ * @note   调用方需处于临界区；同优先级插在末尾，保证先到先得
+ */
+static void bus_arb_enqueue(bus_arb_t *arb, bus_arb_req_t *req) {
+    bus_arb_req_t **pp = &arb->wait_head;
+
+    while (*pp != NULL && (*pp)->prio >= req->prio) {
+        pp = &(*pp)->next;
+    }
+    req->next = *pp;
+    *pp = req;
+}
+
+/**
+ * @brief 结束一次事务持有并更新统计
+ * @param arb 仲裁器结构体指针
+ * @param now 当前时间（微秒）
+ * @note   调用方需处于临界区
+ */
+static void bus_arb_end_hold(bus_arb_t *arb, uint32_t now) {
+    uint32_t hold = now - arb->hold_start_us;
+
+    if (hold > arb->stats.max_hold_us) {
+        arb->stats.max_hold_us = hold;
+    }
+}
+
+/**
+ * @brief 获取总线实现函数
+ * @param arb 仲裁器结构体指针
+ * @param req 请求指针
+ * @return 错误码
+ * @note   总线被占用时按优先级排队并阻塞；若请求优先级高于持有者，
+ *         持有者继承该优先级，防止中等优先级任务抢占持有者造成优先级反转
+ */
+static bus_arb_error_t bus_arb_impl_acquire(bus_arb_t *arb, bus_arb_req_t *req) {
+    uint32_t wait_us;
+
+    if (arb == NULL || req == NULL) {
+        return BUS_ARB_ERROR_NULL_PTR;
+    }
+    if (req->prio >= BUS_ARB_PRIO_NUM) {
+        return BUS_ARB_ERROR_INVALID_PARAM;
+    }
+
+    req->enqueue_us = arb->get_time_us();
+    req->is_granted = false;
+
+    BUS_ARB_ENTER_CRITICAL();
+    if (arb->owner == NULL && arb->wait_head == NULL) {
+        // 总线空闲，直接授予
+        arb->owner = req;
+        arb->owner_prio = req->prio;
+        arb->hold_start_us = req->enqueue_us;
+        arb->stats.grants++;
+        req->is_granted = true;
+        BUS_ARB_EXIT_CRITICAL();
+        return BUS_ARB_OK;
+    }
+
+    bus_arb_enqueue(arb, req);
+    arb->stats.contended++;
+    if (arb->owner != NULL && req->prio > arb->owner_prio && arb->set_prio != NULL) {
+        arb->set_prio(arb->owner->task, req->prio);
+        arb->owner_prio = req->prio;
+        arb->stats.inherits++;
+    }
+    BUS_ARB_EXIT_CRITICAL();
+
+    while (!req->is_granted) {
+        arb->wait(req);
+    }
+
+    wait_us = arb->get_time_us() - req->enqueue_us;
+    BUS_ARB_ENTER_CRITICAL();
+    if (wait_us > arb->stats.max_wait_us[req->prio]) {
+        arb->stats.max_wait_us[req->prio] = wait_us;
+    }
+    BUS_ARB_EXIT_CRITICAL();
+
+    return BUS_ARB_OK;
+}
+
+/**
+ * @brief 释放总线实现函数
+ * @param arb 仲裁器结构体指针
+ * @param req 请求指针（必须是当前持有者）
+ * @return 错误码
+ * @note   恢复持有者原优先级，并把总线直接移交给最高优先级的等待者
+ */
+static bus_arb_error_t bus_arb_impl_release(bus_arb_t *arb, bus_arb_req_t *req) {
+    bus_arb_req_t *next;
+    uint32_t now;
+
+    if (arb == NULL || req == NULL) {
+        return BUS_ARB_ERROR_NULL_PTR;
+    }
+
+    now = arb->get_time_us();
+
+    BUS_ARB_ENTER_CRITICAL();
+    if (arb->owner != req) {
+        BUS_ARB_EXIT_CRITICAL();
+        return BUS_ARB_ERROR_NOT_OWNER;
+    }
+
+    bus_arb_end_hold(arb, now);
+    if (arb->owner_prio != req->prio && arb->set_prio != NULL) {
+        arb->set_prio(req->task, req->prio);
+    }
+    req->is_granted = false;
+
+    // 链表按优先级降序，表头即下一个持有者，其余等待者优先级均不高于它
+    next = arb->wait_head;
+    arb->owner = next;
+    if (next != NULL) {
+        arb->wait_head = next->next;
+        next->next = NULL;
+        arb->owner_prio = next->prio;
+        arb->hold_start_us = now;
+        arb->stats.grants++;
+        next->is_granted = true;
+    }
+    BUS_ARB_EXIT_CRITICAL();
+
+    if (next != NULL) {
+        arb->wake(next);
+    }
+
+    return BUS_ARB_OK;
+}
+
+/**
+ * @brief 事务间让出实现函数
+ * @param arb 仲裁器结构体指针
+ * @param req 请求指针（必须是当前持有者）
+ * @return 错误码
+ * @note   多事务传输（如EEPROM分页写）在每个事务之后调用；仅当存在更高优先级
+ *         等待者时才真正让出，否则继续持有并开始新的事务计时
+ */
+static bus_arb_error_t bus_arb_impl_yield(bus_arb_t *arb, bus_arb_req_t *req) {
+    bool is_preempt;
+    bus_arb_error_t ret;
+
+    if (arb == NULL || req == NULL) {
+        return BUS_ARB_ERROR_NULL_PTR;
+    }
+
+    BUS_ARB_ENTER_CRITICAL();
+    if (arb->owner != req) {
+        BUS_ARB_EXIT_CRITICAL();
+        return BUS_ARB_ERROR_NOT_OWNER;
+    }
+    is_preempt = (arb->wait_head != NULL && arb->wait_head->prio > req->prio);
+    if (is_preempt) {
+        arb->stats.preemptions++;
+    } else {
+        bus_arb_end_hold(arb, arb->get_time_us());
+        arb->hold_start_us = arb->get_time_us();
+    }
+    BUS_ARB_EXIT_CRITICAL();
+
+    if (!is_preempt) {
+        return BUS_ARB_OK;
+    }
+
+    ret = bus_arb_impl_release(arb, req);
+    if (ret != BUS_ARB_OK) {
+        return ret;
+    }
+    return bus_arb_impl_acquire(arb, req);
+}
+
+/* ==================== 公共函数实现 ==================== */
+
+/**
+ * @brief 仲裁器初始化函数
+ * @param arb         仲裁器结构体指针
+ * @param get_time_us 获取时间的平台函数
+ * @param wait        阻塞等待的平台函数
+ * @param wake        唤醒的平台函数
+ * @param set_prio    设置任务优先级的平台函数（可为NULL）
+ * @return 错误码
+ */
+bus_arb_error_t bus_arb_init(bus_arb_t *arb, bus_arb_get_time_us_fn get_time_us,
+                             bus_arb_wait_fn wait, bus_arb_wake_fn wake,
+                             bus_arb_set_prio_fn set_prio) {
+    // 检查指针有效性
+    if (arb == NULL || get_time_us == NULL || wait == NULL || wake == NULL) {
+        return BUS_ARB_ERROR_NULL_PTR;
+    }
+
+    arb->get_time_us = get_time_us;
+    arb->wait = wait;
+    arb->wake = wake;
+    arb->set_prio = set_prio;
+    arb->owner = NULL;
+    arb->wait_head = NULL;
+    arb->owner_prio = 0;
+    arb->hold_start_us = 0;
+    arb->stats = (bus_arb_stats_t){0};
+
+    // 绑定函数指针（面向对象核心）
+    arb->acquire = bus_arb_impl_acquire;
+    arb->release = bus_arb_impl_release;
+    arb->yield = bus_arb_impl_yield;
+
+    return BUS_ARB_OK;
+}
+
+/**
+ * @brief 获取仲裁统计
+ * @param arb      仲裁器结构体指针
+ * @param stats    统计输出指针
+ * @param is_clear 读取后是否清零
+ * @return 错误码
+ * @note   最高优先级请求的最坏等待时间应满足 max_wait_us[最高] ≤ max_hold_us + 调度延迟，
+ *         可据此在目标板或仿真环境中验证等待上界
+ */
+bus_arb_error_t bus_arb_get_stats(bus_arb_t *arb, bus_arb_stats_t *stats, bool is_clear) {
+    if (arb == NULL || stats == NULL) {
+        return BUS_ARB_ERROR_NULL_PTR;
+    }
+
+    BUS_ARB_ENTER_CRITICAL();
+    *stats = arb->stats;
+    if (is_clear) {
+        arb->stats = (bus_arb_stats_t){0};
+    }
+    BUS_ARB_EXIT_CRITICAL();
+
+    return BUS_ARB_OK;
+}
+
+/* ==================== OSAL移植 ==================== */
+
+#ifdef BUS_ARB_PORT_OSAL
+
+/**
+ * @brief 平台接口：获取时间
+ */
+static uint32_t bus_arb_osal_time_us(void) {
+    return osal_get_time_us();
+}
+
+/**
+ * @brief 平台接口：阻塞在请求方信号量上
+ */
+static void bus_arb_osal_wait(bus_arb_req_t *req) {
+    osal_sem_take((osal_sem_t *)req->ctx, OSAL_WAIT_FOREVER);
+}
+
+/**
+ * @brief 平台接口：释放请求方信号量
+ * @note   信号量计数已满时表示对方尚未取走上一次唤醒，忽略即可（仲裁器会重新检查授予标志）
+ */
+static void bus_arb_osal_wake(bus_arb_req_t *req) {
+    (void)osal_sem_give((osal_sem_t *)req->ctx);
+}
+
+/**
+ * @brief 平台接口：设置持有者线程优先级
+ */
+static void bus_arb_osal_set_prio(void *task, uint8_t prio) {
+    (void)osal_thread_set_prio((osal_thread_t *)task, prio);
+}
+
+/**
+ * @brief 基于OSAL的仲裁器初始化函数
+ * @param arb 仲裁器结构体指针
+ * @return 错误码
+ * @note   裸机移植的线程为轮询执行，等待者会一直占用CPU，仲裁器需在抢占式内核上使用
+ */
+bus_arb_error_t bus_arb_init_osal(bus_arb_t *arb) {
+    return bus_arb_init(arb, bus_arb_osal_time_us, bus_arb_osal_wait, bus_arb_osal_wake,
+                        bus_arb_osal_set_prio);
+}
+
+/**
+ * @brief 基于OSAL的总线请求初始化函数
+ * @param req    请求指针
+ * @param sem    请求方专用信号量（调用方静态分配，此处初始化为0/1）
+ * @param thread 请求方线程，用于优先级继承
+ * @param prio   请求优先级（0~BUS_ARB_PRIO_NUM-1）
+ * @return 错误码
+ */
+bus_arb_error_t bus_arb_req_init_osal(bus_arb_req_t *req, osal_sem_t *sem,
+                                      osal_thread_t *thread, uint8_t prio) {
+    if (req == NULL || sem == NULL || thread == NULL) {
+        return BUS_ARB_ERROR_NULL_PTR;
+    }
+    if (prio >= BUS_ARB_PRIO_NUM) {
+        return BUS_ARB_ERROR_INVALID_PARAM;
+    }
+    if (osal_sem_init(sem, 0, 1) != OSAL_OK) {
+        return BUS_ARB_ERROR_INVALID_PARAM;
+    }
+
+    *req = (bus_arb_req_t){ .prio = prio, .task = thread, .ctx = sem };
+    return BUS_ARB_OK;
+}
+
+#ifdef OSAL_PORT_POSIX
+
+#include <sched.h>
+#include <stdatomic.h>
+
+#define BUS_ARB_OSAL_TEST_THREADS  3           // 自测线程数
+#define BUS_ARB_OSAL_TEST_ROUNDS   2000        // 每线程获取总线次数
+#define BUS_ARB_OSAL_TEST_PAGES    4           // 每次持有的事务数（事务间让出）
+
+/**
+ * @brief OSAL自测结果结构体
+ */
+typedef struct {
+    uint32_t transactions;         /**< 完成的事务数 */
+    uint32_t overlaps;             /**< 同时持有总线的次数（应为0） */
+    uint32_t grants;               /**< 授予次数 */
+    uint32_t contended;            /**< 需要排队的请求数 */
+    uint32_t preemptions;          /**< 事务间让出次数 */
+    uint32_t inherits;             /**< 优先级继承次数 */
+    uint32_t max_wait_high_us;     /**< 最高优先级线程最长等待（微秒） */
+} bus_arb_osal_test_result_t;
+
+/**
+ * @brief 自测线程上下文
+ */
+typedef struct {
+    bus_arb_t *arb;                /**< 被测仲裁器 */
+    bus_arb_req_t req;             /**< 总线请求 */
+    osal_sem_t sem;                /**< 请求方信号量 */
+    osal_thread_t thread;          /**< 线程 */
+    osal_sem_t *done;              /**< 完成通知 */
+    atomic_uint *holders;          /**< 当前持有总线的线程数 */
+    atomic_uint *overlaps;         /**< 重叠计数 */
+    atomic_uint *transactions;     /**< 事务计数 */
+} bus_arb_osal_worker_t;
+
+/**
+ * @brief 自测线程：反复获取总线，每次持有若干事务并在事务间让出
+ * @param arg 线程上下文
+ */
+static void bus_arb_osal_worker(void *arg) {
+    bus_arb_osal_worker_t *w = (bus_arb_osal_worker_t *)arg;
+    uint32_t round;
+    uint8_t page;
+
+    for (round = 0; round < BUS_ARB_OSAL_TEST_ROUNDS; round++) {
+        w->arb->acquire(w->arb, &w->req);
+        for (page = 0; page < BUS_ARB_OSAL_TEST_PAGES; page++) {
+            // 一个事务：检查独占后让出CPU，给其他线程制造竞争
+            if (atomic_fetch_add(w->holders, 1) != 0) {
+                atomic_fetch_add(w->overlaps, 1);
+            }
+            sched_yield();
+            atomic_fetch_sub(w->holders, 1);
+            atomic_fetch_add(w->transactions, 1);
+            w->arb->yield(w->arb, &w->req);
+        }
+        w->arb->release(w->arb, &w->req);
+    }
+    osal_sem_give(w->done);
+}
+
+/**
+ * @brief 基于OSAL POSIX移植的多线程自测
+ * @param result 结果输出指针
+ * @return 错误码
+ * @note   三个线程（优先级7/4/1）竞争同一仲裁器，检查互斥、唤醒不丢失与统计；
+ *         POSIX移植不改变线程的实际调度优先级，等待时间上界由BUS_ARB_SIM_POSIX仿真验证
+ */
+bus_arb_error_t bus_arb_osal_selftest(bus_arb_osal_test_result_t *result) {
+    static const uint8_t prio[BUS_ARB_OSAL_TEST_THREADS] = { 7, 4, 1 };
+    static bus_arb_osal_worker_t worker[BUS_ARB_OSAL_TEST_THREADS];
+    static bus_arb_t arb;
+    static osal_sem_t done;
+    atomic_uint holders = 0, overlaps = 0, transactions = 0;
+    bus_arb_stats_t stats;
+    uint8_t i;
+
+    if (result == NULL) {
+        return BUS_ARB_ERROR_NULL_PTR;
+    }
+    *result = (bus_arb_osal_test_result_t){0};
+
+    bus_arb_init_osal(&arb);
+    osal_sem_init(&done, 0, BUS_ARB_OSAL_TEST_THREADS);
+    for (i = 0; i < BUS_ARB_OSAL_TEST_THREADS; i++) {
+        worker[i].arb = &arb;
+        worker[i].done = &done;
+        worker[i].holders = &holders;
+        worker[i].overlaps = &overlaps;
+        worker[i].transactions = &transactions;
+        bus_arb_req_init_osal(&worker[i].req, &worker[i].sem, &worker[i].thread, prio[i]);
+    }
+    for (i = 0; i < BUS_ARB_OSAL_TEST_THREADS; i++) {
+        if (osal_thread_create(&worker[i].thread, "arb", bus_arb_osal_worker, &worker[i],
+                               prio[i], 0) != OSAL_OK) {
+            return BUS_ARB_ERROR_INVALID_PARAM;
+        }
+    }
+    for (i = 0; i < BUS_ARB_OSAL_TEST_THREADS; i++) {
+        osal_sem_take(&done, OSAL_WAIT_FOREVER);
+    }
+    for (i = 0; i < BUS_ARB_OSAL_TEST_THREADS; i++) {
+        pthread_join(worker[i].thread.handle, NULL);
+    }
+
+    bus_arb_get_stats(&arb, &stats, false);
+    result->transactions = atomic_load(&transactions);
+    result->overlaps = atomic_load(&overlaps);
+    result->grants = stats.grants;
+    result->contended = stats.contended;
+    result->preemptions = stats.preemptions;
+    result->inherits = stats.inherits;
+    result->max_wait_high_us = stats.max_wait_us[prio[0]];
+
+    return BUS_ARB_OK;
+}
+
+#endif /* OSAL_PORT_POSIX */
+
+#endif /* BUS_ARB_PORT_OSAL */
+
+/* ==================== 主机仿真 ==================== */
+
+#ifdef BUS_ARB_SIM_POSIX
+
+#include <ucontext.h>
+
+#define BUS_ARB_SIM_TASKS          3           // 仿真任务数（编码器、计算、EEPROM）
+#define BUS_ARB_SIM_STACK          65536       // 每个仿真任务的栈大小（字节）
+#define BUS_ARB_SIM_END_US         500000      // 仿真时长（微秒）
+#define BUS_ARB_SIM_ENC_PRIO       7           // 编码器任务优先级
+#define BUS_ARB_SIM_ENC_PERIOD_US  1000        // 编码器读取周期（微秒）
+#define BUS_ARB_SIM_ENC_XFER_US    60          // 编码器单次读取事务（微秒）
+#define BUS_ARB_SIM_HOG_PRIO       4           // 计算任务优先级（不使用总线）
+#define BUS_ARB_SIM_HOG_PERIOD_US  4700        // 计算任务周期（微秒）
+#define BUS_ARB_SIM_HOG_BURST_US   3000        // 计算任务每周期占用CPU时间（微秒）
+#define BUS_ARB_SIM_EE_PRIO        1           // EEPROM任务优先级
+#define BUS_ARB_SIM_EE_XFER_US     400         // EEPROM单页写事务（微秒）
+#define BUS_ARB_SIM_EE_PAGES       64          // EEPROM每批写入页数
+#define BUS_ARB_SIM_EE_PAUSE_US    2000        // EEPROM批次间隔（微秒）
+
+/**
+ * @brief 仿真结果结构体
+ */
+typedef struct {
+    uint32_t max_wait_no_pi_us;    /**< 不做优先级继承时编码器请求最长等待（微秒） */
+    uint32_t max_wait_pi_us;       /**< 优先级继承时编码器请求最长等待（微秒） */
+    uint32_t max_hold_us;          /**< 单事务最长持有时间（微秒，含持有者被抢占的时间） */
+    uint32_t inherits;             /**< 优先级继承次数 */
+    uint32_t preemptions;          /**< 事务间让出次数 */
+    uint32_t enc_reads;            /**< 编码器读取次数（优先级继承运行） */
+} bus_arb_sim_result_t;
+
+/**
+ * @brief 仿真任务结构体
+ */
+typedef struct {
+    ucontext_t ctx;                /**< 任务上下文 */
+    uint8_t prio;                  /**< 当前有效优先级 */
+    bool is_ready;                 /**< 就绪 */
+    uint32_t wake_at;              /**< 睡眠唤醒时刻，UINT32_MAX表示阻塞在总线上 */
+    bus_arb_req_t req;             /**< 总线请求 */
+} bus_arb_sim_task_t;
+
+/**
+ * @brief 单核抢占式调度器仿真状态
+ * @note  虚拟时间以微秒推进；I2C事务按阻塞（轮询）方式执行，事务期间占用CPU，
+ *        持有者被中优先级任务抢占时总线随之停顿，这正是优先级反转的来源
+ */
+static struct {
+    ucontext_t sched_ctx;                          /**< 调度器上下文 */
+    bus_arb_sim_task_t task[BUS_ARB_SIM_TASKS];    /**< 任务 */
+    bus_arb_sim_task_t *cur;                       /**< 正在运行的任务 */
+    uint32_t now_us;                               /**< 虚拟时间 */
+    uint32_t enc_reads;                            /**< 编码器读取次数 */
+    bus_arb_t arb;                                 /**< 被测仲裁器 */
+} bus_arb_sim;
+
+static uint8_t bus_arb_sim_stack[BUS_ARB_SIM_TASKS][BUS_ARB_SIM_STACK];
+
+/**
+ * @brief 切回调度器
+ */
+static void bus_arb_sim_switch(void) {
+    swapcontext(&bus_arb_sim.cur->ctx, &bus_arb_sim.sched_ctx);
+}
+
+/**
+ * @brief 唤醒睡眠到期的任务
+ * @return 是否存在比当前任务优先级更高的就绪任务
+ */
+static bool bus_arb_sim_release_due(void) {
+    bus_arb_sim_task_t *t;
+    bool is_preempt = false;
+    uint8_t i;
+
+    for (i = 0; i < BUS_ARB_SIM_TASKS; i++) {
+        t = &bus_arb_sim.task[i];
+        if (!t->is_ready && t->wake_at <= bus_arb_sim.now_us) {
+            t->is_ready = true;
+        }
+        if (t->is_ready && t != bus_arb_sim.cur && bus_arb_sim.cur != NULL &&
+            t->prio > bus_arb_sim.cur->prio) {
+            is_preempt = true;
+        }
+    }
+    return is_preempt;
+}
+
+/**
+ * @brief 当前任务占用CPU指定时间，每微秒检查一次抢占
+ * @param us 占用时间（微秒）
+ */
+static void bus_arb_sim_busy(uint32_t us) {
+    while (us-- > 0) {
+        bus_arb_sim.now_us++;
+        if (bus_arb_sim_release_due() || bus_arb_sim.now_us >= BUS_ARB_SIM_END_US) {
+            bus_arb_sim_switch();
+        }
+    }
+}
+
+/**
+ * @brief 当前任务睡眠到指定时刻
+ * @param t_us 唤醒时刻（微秒）
+ */
+static void bus_arb_sim_sleep_until(uint32_t t_us) {
+    bus_arb_sim.cur->is_ready = false;
+    bus_arb_sim.cur->wake_at = t_us;
+    bus_arb_sim_switch();
+}
+
+/**
+ * @brief 平台接口：获取时间
+ */
+static uint32_t bus_arb_sim_time_us(void) {
+    return bus_arb_sim.now_us;
+}
+
+/**
+ * @brief 平台接口：阻塞等待（请求方让出CPU直到被唤醒）
+ */
+static void bus_arb_sim_wait(bus_arb_req_t *req) {
+    bus_arb_sim_task_t *t = (bus_arb_sim_task_t *)req->task;
+
+    t->is_ready = false;
+    t->wake_at = UINT32_MAX;
+    bus_arb_sim_switch();
+}
+
+/**
+ * @brief 平台接口：唤醒，被唤醒任务优先级更高时立即抢占
+ */
+static void bus_arb_sim_wake(bus_arb_req_t *req) {
+    bus_arb_sim_task_t *t = (bus_arb_sim_task_t *)req->task;
+
+    t->is_ready = true;
+    if (t->prio > bus_arb_sim.cur->prio) {
+        bus_arb_sim_switch();
+    }
+}
+
+/**
+ * @brief 平台接口：设置任务优先级
+ */
+static void bus_arb_sim_set_prio(void *task, uint8_t prio) {
+    ((bus_arb_sim_task_t *)task)->prio = prio;
+}
+
+/**
+ * @brief 编码器任务：周期性单事务读取
+ */
+static void bus_arb_sim_enc_task(void) {
+    bus_arb_sim_task_t *self = &bus_arb_sim.task[0];
+    uint32_t next = 137;
+
+    for (;;) {
+        bus_arb_sim_sleep_until(next);
+        next += BUS_ARB_SIM_ENC_PERIOD_US;
+        bus_arb_sim.arb.acquire(&bus_arb_sim.arb, &self->req);
+        bus_arb_sim_busy(BUS_ARB_SIM_ENC_XFER_US);
+        bus_arb_sim.arb.release(&bus_arb_sim.arb, &self->req);
+        bus_arb_sim.enc_reads++;
+    }
+}
+
+/**
+ * @brief 计算任务：中优先级，周期性占用CPU，不访问总线
+ */
+static void bus_arb_sim_hog_task(void) {
+    uint32_t next = 0;
+
+    for (;;) {
+        bus_arb_sim_sleep_until(next);
+        next += BUS_ARB_SIM_HOG_PERIOD_US;
+        bus_arb_sim_busy(BUS_ARB_SIM_HOG_BURST_US);
+    }
+}
+
+/**
+ * @brief EEPROM任务：分页写入，每页之后在事务边界让出
+ */
+static void bus_arb_sim_ee_task(void) {
+    bus_arb_sim_task_t *self = &bus_arb_sim.task[2];
+    uint8_t page;
+
+    for (;;) {
+        bus_arb_sim.arb.acquire(&bus_arb_sim.arb, &self->req);
+        for (page = 0; page < BUS_ARB_SIM_EE_PAGES; page++) {
+            bus_arb_sim_busy(BUS_ARB_SIM_EE_XFER_US);
+            bus_arb_sim.arb.yield(&bus_arb_sim.arb, &self->req);
+        }
+        bus_arb_sim.arb.release(&bus_arb_sim.arb, &self->req);
+        bus_arb_sim_sleep_until(bus_arb_sim.now_us + BUS_ARB_SIM_EE_PAUSE_US);
+    }
+}
+
+/**
+ * @brief 运行一轮仿真
+ * @param set_prio 优先级设置接口（NULL表示不做继承）
+ * @param stats    仲裁统计输出
+ */
+static void bus_arb_sim_once(bus_arb_set_prio_fn set_prio, bus_arb_stats_t *stats) {
+    static void (*const entry[BUS_ARB_SIM_TASKS])(void) = {
+        bus_arb_sim_enc_task, bus_arb_sim_hog_task, bus_arb_sim_ee_task,
+    };
+    static const uint8_t prio[BUS_ARB_SIM_TASKS] = {
+        BUS_ARB_SIM_ENC_PRIO, BUS_ARB_SIM_HOG_PRIO, BUS_ARB_SIM_EE_PRIO,
+    };
+    bus_arb_sim_task_t *t, *pick;
+    uint32_t wake_min;
+    uint8_t i;
+
+    bus_arb_sim.now_us = 0;
+    bus_arb_sim.cur = NULL;
+    bus_arb_sim.enc_reads = 0;
+    bus_arb_init(&bus_arb_sim.arb, bus_arb_sim_time_us, bus_arb_sim_wait, bus_arb_sim_wake, set_prio);
+
+    for (i = 0; i < BUS_ARB_SIM_TASKS; i++) {
+        t = &bus_arb_sim.task[i];
+        t->prio = prio[i];
+        t->is_ready = true;
+        t->wake_at = 0;
+        t->req = (bus_arb_req_t){ .prio = prio[i], .task = t };
+        getcontext(&t->ctx);
+        t->ctx.uc_stack.ss_sp = bus_arb_sim_stack[i];
+        t->ctx.uc_stack.ss_size = sizeof(bus_arb_sim_stack[i]);
+        t->ctx.uc_link = &bus_arb_sim.sched_ctx;
+        makecontext(&t->ctx, entry[i], 0);
+    }
+
+    // 调度器：运行最高优先级的就绪任务，全部阻塞时推进到最近的唤醒时刻
+    while (bus_arb_sim.now_us < BUS_ARB_SIM_END_US) {
+        bus_arb_sim_release_due();
+        pick = NULL;
+        wake_min = UINT32_MAX;
+        for (i = 0; i < BUS_ARB_SIM_TASKS; i++) {
+            t = &bus_arb_sim.task[i];
+            if (t->is_ready && (pick == NULL || t->prio > pick->prio)) {
+                pick = t;
+            }
+            if (!t->is_ready && t->wake_at < wake_min) {
+                wake_min = t->wake_at;
+            }
+        }
+        if (pick == NULL) {
+            bus_arb_sim.now_us = (wake_min == UINT32_MAX) ? BUS_ARB_SIM_END_US : wake_min;
+            continue;
+        }
+        bus_arb_sim.cur = pick;
+        swapcontext(&bus_arb_sim.sched_ctx, &pick->ctx);
+    }
+
+    bus_arb_get_stats(&bus_arb_sim.arb, stats, false);
+}
+
+/**
+ * @brief 优先级继承仿真
+ * @param result 结果输出指针
+ * @return 错误码
+ * @note   单核抢占式调度：编码器任务（高）每1ms读一次总线，EEPROM任务（低）连续分页写，
+ *         计算任务（中）周期性占用CPU 3ms。不做继承时EEPROM持有总线期间被计算任务抢占，
+ *         编码器等待达到计算任务的执行时间量级；做继承时等待不超过一个事务的持有时间
+ */
+bus_arb_error_t bus_arb_sim_run(bus_arb_sim_result_t *result) {
+    bus_arb_stats_t stats;
+
+    if (result == NULL) {
+        return BUS_ARB_ERROR_NULL_PTR;
+    }
+    *result = (bus_arb_sim_result_t){0};
+
+    bus_arb_sim_once(NULL, &stats);
+    result->max_wait_no_pi_us = stats.max_wait_us[BUS_ARB_SIM_ENC_PRIO];
+
+    bus_arb_sim_once(bus_arb_sim_set_prio, &stats);
+    result->max_wait_pi_us = stats.max_wait_us[BUS_ARB_SIM_ENC_PRIO];
+    result->max_hold_us = stats.max_hold_us;
+    result->inherits = stats.inherits;
+    result->preemptions = stats.preemptions;
+    result->enc_reads = bus_arb_sim.enc_reads;
+
+    return BUS_ARB_OK;
+}
+
+#endif /* BUS_ARB_SIM_POSIX */
+
+/* ==================== 使用示例 ==================== */
+
+/*
+ * 使用示例（基于osal_template.c，编码器读取与EEPROM写入共用总线0）：
+ *
+ * // 编译选项：-DBUS_ARB_PORT_OSAL（本文件包含osal_template.c）
+ * static bus_arb_t bus0_arb;
+ * static osal_thread_t encoder_thread, eeprom_thread;
+ * static osal_sem_t encoder_sem, eeprom_sem;
+ * static bus_arb_req_t encoder_req, eeprom_req;
+ *
+ * // 挂接到传感器驱动的总线锁钩子（见sensor_driver_template.c）
+ * static void bus_lock(uint8_t bus_id, void *requester)   { bus0_arb.acquire(&bus0_arb, requester); }
+ * static void bus_unlock(uint8_t bus_id, void *requester) { bus0_arb.release(&bus0_arb, requester); }
+ *
+ * static void encoder_worker(void *arg) {
+ *     uint16_t angle;
+ *     for (;;) {
+ *         sensor_bus_begin(&encoder, &encoder_req);    // 最多等待一个事务
+ *         encoder.get_data(&angle);
+ *         sensor_bus_end(&encoder, &encoder_req);
+ *         osal_delay_ms(1);
+ *     }
+ * }
+ *
+ * static void eeprom_worker(void *arg) {
+ *     uint8_t page;
+ *     for (;;) {
+ *         bus0_arb.acquire(&bus0_arb, &eeprom_req);
+ *         for (page = 0; page < 64; page++) {
+ *             eeprom_write_page(page);                 // 单个事务
+ *             bus0_arb.yield(&bus0_arb, &eeprom_req);  // 有更高优先级请求时在此让出
+ *         }
+ *         bus0_arb.release(&bus0_arb, &eeprom_req);
+ *         osal_delay_ms(10);
+ *     }
+ * }
+ *
+ * int main(void) {
+ *     bus_arb_init_osal(&bus0_arb);
+ *     bus_arb_req_init_osal(&encoder_req, &encoder_sem, &encoder_thread, 7);
+ *     bus_arb_req_init_osal(&eeprom_req, &eeprom_sem, &eeprom_thread, 1);
+ *     sensor_set_bus_lock(bus_lock, bus_unlock);
+ *     osal_thread_create(&encoder_thread, "encoder", encoder_worker, NULL, 7, 1024);
+ *     osal_thread_create(&eeprom_thread, "eeprom", eeprom_worker, NULL, 1, 1024);
+ *     osal_kernel_start();
+ * }
+ *
+ * void diag_task(void) {
+ *     bus_arb_stats_t stats;
+ *     bus_arb_get_stats(&bus0_arb, &stats, true);
+ *     // stats.max_wait_us[7] 应不超过 stats.max_hold_us 加调度延迟
+ * }
+ *
+ * 主机仿真（Linux）：
+ *   gcc -std=c11 -O2 -D_DEFAULT_SOURCE -DBUS_ARB_SIM_POSIX sensor_bus_arbiter_template.c test_main.c
+ *   bus_arb_sim_result_t r;
+ *   bus_arb_sim_run(&r);      // r.max_wait_no_pi_us / r.max_wait_pi_us / r.max_hold_us
+ *
+ * OSAL多线程自测（Linux）：
+ *   gcc -std=c11 -O2 -D_GNU_SOURCE -DBUS_ARB_PORT_OSAL -DOSAL_PORT_POSIX \
+ *       sensor_bus_arbiter_template.c test_main.c -pthread
+ *   bus_arb_osal_test_result_t t;
+ *   bus_arb_osal_selftest(&t);   // t.overlaps应为0，t.transactions为3*2000*4
+ */
@@ -0,0 +1,384 @@
+/**
+ * @file sensor_calibration_template.c
+ * @brief 传感器校准引擎模板文件
+ * @description 为每个sensor_t挂接一个校准阶段：零偏/增益、非线性（多项式或分段线性表）
+ *              与温度补偿全部以定点运算完成；支持对FIFO突发数据块批量处理，
+ *              校准系数从持久化存储加载并做CRC校验
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* ==================== 宏定义 ==================== */
+
+#define SENSOR_CALIB_MAGIC         0x314C4143UL  // 系数块标识"CAL1"
+#define SENSOR_CALIB_VERSION       1             // 系数块版本
+#define SENSOR_CALIB_LUT_SHIFT     12            // 分段线性表步长为2^12
+#define SENSOR_CALIB_LUT_POINTS    ((65536 >> SENSOR_CALIB_LUT_SHIFT) + 1)  // 表点数（17）
+#define SENSOR_CALIB_POLY_ORDER    3             // 多项式最高阶数
+#define SENSOR_CALIB_TEMP_POINTS   8             // 温度补偿表点数
+#define SENSOR_CALIB_Q16_ONE       65536L        // Q16格式的1.0
+
+/* ==================== 类型定义 ==================== */
+
+/**
+ * @brief 非线性校正方式枚举
+ */
+typedef enum {
+    SENSOR_CALIB_NONLIN_NONE = 0,  /**< 不做非线性校正 */
+    SENSOR_CALIB_NONLIN_POLY,      /**< 多项式校正 */
+    SENSOR_CALIB_NONLIN_PWL        /**< 分段线性查表 */
+} sensor_calib_nonlin_t;
+
+/**
+ * @brief 校准错误码枚举
+ */
+typedef enum {
+    SENSOR_CALIB_OK = 0,           /**< 成功 */
+    SENSOR_CALIB_ERROR_NULL_PTR,   /**< 空指针错误 */
+    SENSOR_CALIB_ERROR_NOT_FOUND,  /**< 存储中无系数 */
+    SENSOR_CALIB_ERROR_CORRUPT     /**< 系数块标识、版本或CRC错误 */
+} sensor_calib_error_t;
+
+/**
+ * @brief 校准系数块结构体（持久化格式）
+ * @note  字段均为32位，避免结构体填充影响CRC计算；crc覆盖其前的全部字段
+ */
+typedef struct {
+    uint32_t magic;                                  /**< 标识 */
+    uint32_t version;                                /**< 版本 */
+    uint32_t nonlin;                                 /**< 非线性校正方式 */
+    int32_t offset;                                  /**< 零偏（原始码值） */
+    int32_t gain_q16;                                /**< 增益（Q16） */
+    int32_t poly[SENSOR_CALIB_POLY_ORDER + 1];       /**< 多项式系数，自变量为v/65536 */
+    int32_t lut[SENSOR_CALIB_LUT_POINTS];            /**< 分段线性表，输入均匀分布 */
+    int32_t temp_start_c10;                          /**< 温度表起点（0.1℃） */
+    int32_t temp_step_c10;                           /**< 温度表步长（0.1℃） */
+    int32_t temp_offset[SENSOR_CALIB_TEMP_POINTS];   /**< 各温度点零偏（输出单位） */
+    int32_t temp_gain_q16[SENSOR_CALIB_TEMP_POINTS]; /**< 各温度点增益（Q16） */
+    uint32_t crc;                                    /**< CRC-32校验 */
+} sensor_calib_coeff_t;
+
+/* === 前向声明 === */
+
+typedef struct sensor_calib_t sensor_calib_t;
+
+/* === 函数指针类型定义 === */
+
+/**
+ * @brief 从持久化存储读取系数函数指针类型
+ * @return 实际读取的字节数，0表示不存在
+ */
+typedef uint16_t (*sensor_calib_store_read_fn)(void *ctx, uint16_t key, void *buf, uint16_t len);
+
+/**
+ * @brief 单点校准函数指针类型
+ */
+typedef int32_t (*sensor_calib_apply_fn)(const sensor_calib_t *calib, uint16_t raw);
+
+/**
+ * @brief 数据块校准函数指针类型
+ */
+typedef void (*sensor_calib_apply_block_fn)(const sensor_calib_t *calib, const uint16_t *raw,
+                                            int32_t *out, uint16_t count);
+
+/**
+ * @brief 更新温度函数指针类型
+ */
+typedef void (*sensor_calib_set_temperature_fn)(sensor_calib_t *calib, int16_t temp_c10);
+
+/**
+ * @brief 传感器校准引擎结构体
+ * @note  温度补偿系数在温度更新时预先插值得到，逐样本路径只做乘加与查表
+ */
+struct sensor_calib_t {
+    /* 校准参数 */
+    sensor_calib_coeff_t coeff;            /**< 校准系数 */
+
+    /* 运行状态 */
+    int16_t temp_c10;                      /**< 当前温度（0.1℃） */
+    int32_t t_offset;                      /**< 当前温度下的零偏 */
+    int32_t t_gain_q16;                    /**< 当前温度下的增益（Q16） */
+    bool is_valid;                         /**< 系数来自有效的持久化数据 */
+
+    /* 函数指针 - 操作方法 */
+    sensor_calib_apply_fn           apply;            /**< 单点校准 */
+    sensor_calib_apply_block_fn     apply_block;      /**< 数据块校准 */
+    sensor_calib_set_temperature_fn set_temperature;  /**< 更新温度 */
+};
+
+/* ==================== 静态函数声明 ==================== */
+
+static int32_t sensor_calib_impl_apply(const sensor_calib_t *calib, uint16_t raw);
+static void sensor_calib_impl_apply_block(const sensor_calib_t *calib, const uint16_t *raw,
+                                          int32_t *out, uint16_t count);
+static void sensor_calib_impl_set_temperature(sensor_calib_t *calib, int16_t temp_c10);
+static int32_t sensor_calib_nonlin(const sensor_calib_coeff_t *c, int32_t v);
+static uint32_t sensor_calib_crc32(const uint8_t *data, uint32_t len);
+
+/* ==================== 静态函数实现 ==================== */
+
+/**
+ * @brief 计算CRC-32（多项式0xEDB88320）
+ * @param data 数据指针
+ * @param len  数据长度
+ * @return CRC值
+ * @note   仅在加载时调用，采用逐位算法以节省Flash
+ */
+static uint32_t sensor_calib_crc32(const uint8_t *data, uint32_t len) {
+    uint32_t crc = 0xFFFFFFFFUL;
+    uint8_t bit;
+
+    while (len--) {
+        crc ^= *data++;
+        for (bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0U - (crc & 1U)));
+        }
+    }
+    return ~crc;
+}
+
+/**
+ * @brief 非线性校正
+ * @param c 校准系数指针
+ * @param v 经过零偏/增益校正的码值
+ * @return 校正结果
+ */
+static int32_t sensor_calib_nonlin(const sensor_calib_coeff_t *c, int32_t v) {
+    int64_t acc;
+    int32_t idx;
+    int32_t frac;
+    int8_t k;
+
+    switch (c->nonlin) {
+    case SENSOR_CALIB_NONLIN_POLY:
+        // 霍纳法则：y = c0 + x*(c1 + x*(c2 + x*c3))，x = v/65536
+        acc = c->poly[SENSOR_CALIB_POLY_ORDER];
+        for (k = SENSOR_CALIB_POLY_ORDER - 1; k >= 0; k--) {
+            acc = ((acc * v) >> 16) + c->poly[k];
+        }
+        return (int32_t)acc;
+
+    case SENSOR_CALIB_NONLIN_PWL:
+        // 输入均匀分布，段号由移位直接得到，无需搜索
+        if (v < 0) v = 0;
+        if (v > 65535) v = 65535;
+        idx = v >> SENSOR_CALIB_LUT_SHIFT;
+        frac = v & ((1L << SENSOR_CALIB_LUT_SHIFT) - 1);
+        return c->lut[idx] +
+               (int32_t)(((int64_t)(c->lut[idx + 1] - c->lut[idx]) * frac) >> SENSOR_CALIB_LUT_SHIFT);
+
+    default:
+        return v;
+    }
+}
+
+/**
+ * @brief 单点校准实现函数
+ * @param calib 校准引擎结构体指针
+ * @param raw   原始读数
+ * @return 校准后的值（输出单位由系数决定）
+ */
+static int32_t sensor_calib_impl_apply(const sensor_calib_t *calib, uint16_t raw) {
+    int32_t v;
+
+    // 零偏/增益校正
+    v = (int32_t)(((int64_t)((int32_t)raw - calib->coeff.offset) * calib->coeff.gain_q16) >> 16);
+
+    // 非线性校正
+    v = sensor_calib_nonlin(&calib->coeff, v);
+
+    // 温度补偿
+    return (int32_t)(((int64_t)(v - calib->t_offset) * calib->t_gain_q16) >> 16);
+}
+
+/**
+ * @brief 数据块校准实现函数
+ * @param calib 校准引擎结构体指针
+ * @param raw   原始读数数组（如缓冲池中的FIFO突发数据）
+ * @param out   输出数组
+ * @param count 样本数
+ * @note   同一数据块内温度视为不变，系数只取一次
+ */
+static void sensor_calib_impl_apply_block(const sensor_calib_t *calib, const uint16_t *raw,
+                                          int32_t *out, uint16_t count) {
+    const int32_t offset = calib->coeff.offset;
+    const int32_t gain = calib->coeff.gain_q16;
+    const int32_t t_offset = calib->t_offset;
+    const int32_t t_gain = calib->t_gain_q16;
+    int32_t v;
+    uint16_t i;
+
+    for (i = 0; i < count; i++) {
+        v = (int32_t)(((int64_t)((int32_t)raw[i] - offset) * gain) >> 16);
+        v = sensor_calib_nonlin(&calib->coeff, v);
+        out[i] = (int32_t)(((int64_t)(v - t_offset) * t_gain) >> 16);
+    }
+}
+
+/**
+ * @brief 更新温度实现函数
+ * @param calib    校准引擎结构体指针
+ * @param temp_c10 当前温度（0.1℃）
+ * @note   在温度表中线性插值得到当前零偏与增益，超出范围时取端点值
+ */
+static void sensor_calib_impl_set_temperature(sensor_calib_t *calib, int16_t temp_c10) {
+    const sensor_calib_coeff_t *c = &calib->coeff;
+    int32_t pos;
+    int32_t idx;
+    int32_t frac;
+
+    calib->temp_c10 = temp_c10;
+
+    if (c->temp_step_c10 <= 0) {
+        calib->t_offset = c->temp_offset[0];
+        calib->t_gain_q16 = c->temp_gain_q16[0];
+        return;
+    }
+
+    pos = temp_c10 - c->temp_start_c10;
+    if (pos <= 0) {
+        idx = 0;
+        frac = 0;
+    } else if (pos >= c->temp_step_c10 * (SENSOR_CALIB_TEMP_POINTS - 1)) {
+        idx = SENSOR_CALIB_TEMP_POINTS - 2;
+        frac = c->temp_step_c10;
+    } else {
+        idx = pos / c->temp_step_c10;
+        frac = pos % c->temp_step_c10;
+    }
+
+    calib->t_offset = c->temp_offset[idx] +
+        (c->temp_offset[idx + 1] - c->temp_offset[idx]) * frac / c->temp_step_c10;
+    calib->t_gain_q16 = c->temp_gain_q16[idx] +
+        (int32_t)((int64_t)(c->temp_gain_q16[idx + 1] - c->temp_gain_q16[idx]) * frac /
+                  c->temp_step_c10);
+}
+
+/* ==================== 公共函数实现 ==================== */
+
+/**
+ * @brief 加载默认（恒等）校准系数
+ * @param coeff 系数结构体指针
+ */
+void sensor_calib_coeff_default(sensor_calib_coeff_t *coeff) {
+    uint8_t i;
+
+    if (coeff == NULL) {
+        return;
+    }
+
+    *coeff = (sensor_calib_coeff_t){0};
+    coeff->magic = SENSOR_CALIB_MAGIC;
+    coeff->version = SENSOR_CALIB_VERSION;
+    coeff->nonlin = SENSOR_CALIB_NONLIN_NONE;
+    coeff->gain_q16 = SENSOR_CALIB_Q16_ONE;
+    for (i = 0; i < SENSOR_CALIB_TEMP_POINTS; i++) {
+        coeff->temp_gain_q16[i] = SENSOR_CALIB_Q16_ONE;
+    }
+}
+
+/**
+ * @brief 对系数块计算并填写CRC（生产标定工具写入存储前调用）
+ * @param coeff 系数结构体指针
+ */
+void sensor_calib_coeff_seal(sensor_calib_coeff_t *coeff) {
+    if (coeff == NULL) {
+        return;
+    }
+    coeff->crc = sensor_calib_crc32((const uint8_t *)coeff, offsetof(sensor_calib_coeff_t, crc));
+}
+
+/**
+ * @brief 校准引擎初始化函数
+ * @param calib 校准引擎结构体指针
+ * @return 错误码
+ * @note   初始为恒等校准，随后调用sensor_calib_load加载持久化系数
+ */
+sensor_calib_error_t sensor_calib_init(sensor_calib_t *calib) {
+    // 检查指针有效性
+    if (calib == NULL) {
+        return SENSOR_CALIB_ERROR_NULL_PTR;
+    }
+
+    sensor_calib_coeff_default(&calib->coeff);
+    calib->is_valid = false;
+
+    // 绑定函数指针（面向对象核心）
+    calib->apply = sensor_calib_impl_apply;
+    calib->apply_block = sensor_calib_impl_apply_block;
+    calib->set_temperature = sensor_calib_impl_set_temperature;
+
+    calib->set_temperature(calib, 250);
+
+    return SENSOR_CALIB_OK;
+}
+
+/**
+ * @brief 从持久化存储加载校准系数
+ * @param calib 校准引擎结构体指针
+ * @param read  存储读取函数
+ * @param ctx   存储上下文
+ * @param key   系数在存储中的键
+ * @return 错误码，失败时保持原有系数不变
+ */
+sensor_calib_error_t sensor_calib_load(sensor_calib_t *calib, sensor_calib_store_read_fn read,
+                                       void *ctx, uint16_t key) {
+    sensor_calib_coeff_t tmp;
+
+    if (calib == NULL || read == NULL) {
+        return SENSOR_CALIB_ERROR_NULL_PTR;
+    }
+
+    if (read(ctx, key, &tmp, sizeof(tmp)) != sizeof(tmp)) {
+        return SENSOR_CALIB_ERROR_NOT_FOUND;
+    }
+
+    // 校验标识、版本与CRC
+    if (tmp.magic != SENSOR_CALIB_MAGIC || tmp.version != SENSOR_CALIB_VERSION ||
+        tmp.nonlin > SENSOR_CALIB_NONLIN_PWL ||
+        tmp.crc != sensor_calib_crc32((const uint8_t *)&tmp, offsetof(sensor_calib_coeff_t, crc))) {
+        return SENSOR_CALIB_ERROR_CORRUPT;
+    }
+
+    calib->coeff = tmp;
+    calib->is_valid = true;
+    calib->set_temperature(calib, calib->temp_c10);
+
+    return SENSOR_CALIB_OK;
+}
+
+/* ==================== 使用示例 ==================== */
+
+/*
+ * 使用示例：
+ *
+ * static sensor_t imu;
+ * static sensor_calib_t imu_calib;
+ *
+ * int main(void) {
+ *     uint16_t raw;
+ *     int32_t value;
+ *
+ *     sensor_init(&imu);
+ *
+ *     // 初始化校准阶段并从参数存储加载系数，挂接到传感器对象
+ *     sensor_calib_init(&imu_calib);
+ *     if (sensor_calib_load(&imu_calib, param_store_read, &param_store, PARAM_KEY_IMU_CALIB) != SENSOR_CALIB_OK) {
+ *         // 无有效系数，继续使用恒等校准并提示需要标定
+ *     }
+ *     imu.calib = &imu_calib;
+ *
+ *     // 温度变化较慢，在低速任务中更新
+ *     imu.calib->set_temperature(imu.calib, board_temp_c10());
+ *
+ *     // 单点校准
+ *     if (imu.get_data(&raw) == SENSOR_STATUS_OK) {
+ *         value = imu.calib->apply(imu.calib, raw);
+ *     }
+ *
+ *     // FIFO突发数据块校准（见sensor_buffer_pool_template.c）
+ *     imu.calib->apply_block(imu.calib, buf->samples, calibrated, buf->count);
+ * }
+ */
@@ -7,15 +7,20 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
 
 /* ==================== 宏定义 ==================== */
 
-#define SENSOR_I2C_ADDR        0x30    // 传感器I2C地址
+#define SENSOR_I2C_ADDR        0x30    // 传感器默认I2C地址
+#define SENSOR_CHIP_ID         0x5A    // 本驱动支持的芯片ID
 #define SENSOR_REG_ID          0x00    // ID寄存器地址
 #define SENSOR_REG_CTRL        0x01    // 控制寄存器地址
 #define SENSOR_REG_DATA        0x02    // 数据寄存器地址
 #define I2C_TIMEOUT_MS         100     // I2C超时时间（毫秒）
 #define MAX_RETRY_COUNT        3       // 最大重试次数
+#define SENSOR_PROBE_ADDR_NUM  4       // 枚举时探测的候选地址数量
+#define SENSOR_LAT_BINS        12      // 延迟直方图桶数（按2的幂划分，单位微秒）
 
 /* ==================== 类型定义 ==================== */
 
@@ -38,11 +43,62 @@ typedef struct {
     bool enable_interrupt;    // 是否使能中断
 } sensor_config_t;
 
+/**
+ * @brief 传感器驱动描述结构体
+ * @note  枚举时按芯片ID匹配驱动，匹配成功后将操作函数绑定到sensor_t
+ */
+typedef struct {
+    const char *name;          // 驱动名称
+    uint8_t chip_id;           // 匹配的芯片ID
+    void (*reset)(void);
+    sensor_status_t (*read_reg)(uint8_t reg, uint8_t *data);
+    sensor_status_t (*write_reg)(uint8_t reg, uint8_t data);
+    sensor_status_t (*set_config)(sensor_config_t *config);
+    sensor_status_t (*get_data)(uint16_t *data);
+} sensor_driver_t;
+
+/**
+ * @brief 枚举结果结构体
+ */
+typedef struct {
+    uint8_t probed;            // 已探测地址数
+    uint8_t acked;             // 应答地址数
+    uint32_t probe_time_us;    // 枚举总耗时（微秒）
+} sensor_probe_result_t;
+
+/**
+ * @brief 总线事务统计结构体
+ * @note  由传输层在每次事务后以单次原子加更新，任意上下文均可安全读取
+ */
+typedef struct {
+    atomic_uint_least32_t transactions;    // 事务次数
+    atomic_uint_least32_t bytes;           // 传输字节数
+    atomic_uint_least32_t retries;         // 重试次数
+    atomic_uint_least32_t nacks;           // 无应答次数
+    atomic_uint_least32_t timeouts;        // 超时次数
+    atomic_uint_least32_t latency_hist[SENSOR_LAT_BINS];  // 延迟直方图，第k桶为[2^k, 2^(k+1))微秒
+} sensor_bus_stats_t;
+
+/**
+ * @brief 总线事务统计快照结构体
+ */
+typedef struct {
+    uint32_t transactions;     // 事务次数
+    uint32_t bytes;            // 传输字节数
+    uint32_t retries;          // 重试次数
+    uint32_t nacks;            // 无应答次数
+    uint32_t timeouts;         // 超时次数
+    uint32_t latency_hist[SENSOR_LAT_BINS];  // 延迟直方图
+} sensor_bus_snapshot_t;
+
 /**
  * @brief 传感器结构体（面向对象封装）
  */
 typedef struct {
+    uint8_t bus_id;            // 所在总线编号
     uint8_t slv_addr;          // 从设备地址
+    uint8_t chip_id;           // 枚举得到的芯片ID
+    const sensor_driver_t *driver;  // 绑定的驱动
     
     // 函数指针成员
     void (*reset)(void);
@@ -53,9 +109,66 @@ typedef struct {
     
     // 私有成员
     sensor_config_t config;    // 当前配置
+    struct sensor_calib_t *calib;  // 校准阶段（可选，见sensor_calibration_template.c）
+    sensor_bus_stats_t bus_stats;  // 总线事务统计
     bool is_initialized;      // 初始化标志
 } sensor_t;
 
+/**
+ * @brief 静态设备描述结构体
+ * @note  由SENSOR_DEVICE_TABLE在编译期生成，存放于Flash
+ */
+typedef struct {
+    const char *name;          // 设备名称
+    uint8_t bus_id;            // 所在总线编号
+    uint8_t slv_addr;          // 从设备地址
+    const sensor_driver_t *driver;  // 驱动
+    sensor_config_t config;    // 初始配置
+    uint16_t poll_rate_hz;     // 轮询频率（Hz）
+} sensor_device_desc_t;
+
+/**
+ * @brief 设备运行状态结构体
+ * @note  只保存运行中会变化的数据，地址、驱动等不变信息只从sensor_device_table读取
+ */
+typedef struct {
+    sensor_config_t config;    // 当前配置（启动时取自描述表）
+    sensor_bus_stats_t bus_stats;  // 总线事务统计
+    bool is_initialized;       // 启动标志
+} sensor_dev_state_t;
+
+/**
+ * @brief 设备表启动结果结构体
+ */
+typedef struct {
+    uint8_t started;           // 启动成功的设备数
+    uint8_t failed;            // 启动失败的设备数
+    uint32_t boot_time_us;     // 设备表启动总耗时（微秒）
+} sensor_table_result_t;
+
+/**
+ * @brief 总线访问上下文结构体
+ * @note  记录当前选中的目标与统计归属；每个访问总线的任务各持有一个，
+ *        避免一个任务的选中操作把另一个任务的事务计入错误的设备
+ */
+typedef struct {
+    uint8_t bus_id;            // 选中的总线编号
+    uint8_t slv_addr;          // 选中的从设备地址
+    sensor_bus_stats_t *stats; // 选中设备的总线统计（可为NULL）
+} sensor_bus_ctx_t;
+
+/**
+ * @brief 获取当前任务总线访问上下文的钩子函数指针类型
+ * @note  RTOS下通常返回任务本地存储中的上下文（如pvTaskGetThreadLocalStoragePointer）
+ */
+typedef sensor_bus_ctx_t *(*sensor_ctx_fn)(void);
+
+/**
+ * @brief 总线加锁/解锁钩子函数指针类型
+ * @note  requester为调用方的请求句柄（如bus_arb_req_t），驱动不解释其内容
+ */
+typedef void (*sensor_bus_lock_fn)(uint8_t bus_id, void *requester);
+
 /* ==================== 静态函数声明 ==================== */
 
 static void sensor_reset(void);
@@ -63,6 +176,102 @@ static sensor_status_t sensor_read_reg(uint8_t reg, uint8_t *data);
 static sensor_status_t sensor_write_reg(uint8_t reg, uint8_t data);
 static sensor_status_t sensor_set_config(sensor_config_t *config);
 static sensor_status_t sensor_get_data(uint16_t *data);
+static sensor_status_t sensor_probe_id(uint8_t addr, uint8_t *id);
+static uint32_t sensor_get_time_us(void);
+static const sensor_driver_t *sensor_match_driver(uint8_t chip_id);
+static sensor_status_t sensor_i2c_transfer(uint8_t reg, uint8_t *data, bool is_read);
+static sensor_status_t sensor_bus_xfer(uint8_t reg, uint8_t *data, bool is_read);
+static void sensor_select_target(uint8_t bus_id, uint8_t slv_addr, sensor_bus_stats_t *stats);
+static sensor_bus_ctx_t *sensor_current_ctx(void);
+static void sensor_stats_snapshot(sensor_bus_stats_t *stats, sensor_bus_snapshot_t *snapshot);
+#ifdef SENSOR_SIM_POSIX
+static sensor_status_t sensor_sim_probe(uint8_t addr, uint8_t *id);
+static sensor_status_t sensor_sim_transfer(uint8_t reg, uint8_t *data, bool is_read);
+#endif
+
+/* ==================== 静态变量 ==================== */
+
+// 枚举候选地址（覆盖各板卡变体的地址引脚配置）
+static const uint8_t sensor_probe_addrs[SENSOR_PROBE_ADDR_NUM] = {
+    SENSOR_I2C_ADDR, SENSOR_I2C_ADDR + 1, SENSOR_I2C_ADDR + 2, SENSOR_I2C_ADDR + 3
+};
+
+// 默认总线访问上下文（未设置上下文钩子时所有调用方共用，仅适用于单任务）
+static sensor_bus_ctx_t sensor_default_ctx = { .bus_id = 0, .slv_addr = SENSOR_I2C_ADDR, .stats = NULL };
+
+// 获取当前任务上下文的钩子，未设置时使用默认上下文
+static sensor_ctx_fn sensor_ctx_hook = NULL;
+
+#ifdef SENSOR_SIM_POSIX
+// 仿真总线：各候选地址上挂接的芯片ID（0表示无设备）与虚拟时间
+static struct {
+    uint8_t chip_at[SENSOR_PROBE_ADDR_NUM];
+    bool is_nack_timeout;      // 控制器不检测NACK，只能等超时并重试（对比基准）
+    uint64_t now_ns;
+} sensor_sim;
+#endif
+
+// 总线加锁/解锁钩子，未设置时不做串行化（单任务使用）
+static sensor_bus_lock_fn sensor_bus_lock = NULL;
+static sensor_bus_lock_fn sensor_bus_unlock = NULL;
+
+// 本文件实现的驱动
+static const sensor_driver_t sensor_driver = {
+    .name = "sensor",
+    .chip_id = SENSOR_CHIP_ID,
+    .reset = sensor_reset,
+    .read_reg = sensor_read_reg,
+    .write_reg = sensor_write_reg,
+    .set_config = sensor_set_config,
+    .get_data = sensor_get_data,
+};
+
+// 驱动表，新增传感器型号时在此追加条目
+static const sensor_driver_t *const sensor_driver_table[] = {
+    &sensor_driver,
+};
+
+#define SENSOR_DRIVER_NUM  (sizeof(sensor_driver_table) / sizeof(sensor_driver_table[0]))
+
+/* ==================== 静态设备表 ==================== */
+
+/*
+ * 板级设备表：每行描述一个设备，新增设备只需追加一行
+ * 参数依次为：名称、总线、地址、驱动、采样率、分辨率、中断使能、轮询频率（Hz）
+ * 驱动参数为驱动函数前缀，如sensor对应sensor_reset/sensor_read_reg等
+ */
+#define SENSOR_DEVICE_TABLE(X)                                          \
+    X(IMU_0,    0, 0x30, sensor, 20, 16, true,  200)                    \
+    X(IMU_1,    0, 0x31, sensor, 20, 16, true,  200)                    \
+    X(PRESS_0,  1, 0x30, sensor, 10, 12, false,  50)                    \
+    X(TEMP_0,   2, 0x32, sensor,  1, 12, false,   1)
+
+// 设备编号枚举
+#define SENSOR_DEVICE_ENUM(id, bus, addr, drv, rate, res, irq, hz)  SENSOR_DEV_##id,
+typedef enum {
+    SENSOR_DEVICE_TABLE(SENSOR_DEVICE_ENUM)
+    SENSOR_DEV_NUM
+} sensor_device_id_t;
+#undef SENSOR_DEVICE_ENUM
+
+// 设备描述表（const，存放于Flash）
+#define SENSOR_DEVICE_DESC(id, bus, addr, drv, rate, res, irq, hz)      \
+    [SENSOR_DEV_##id] = {                                               \
+        .name = #id,                                                    \
+        .bus_id = (bus),                                                \
+        .slv_addr = (addr),                                             \
+        .driver = &drv##_driver,                                        \
+        .config = { .sample_rate = (rate), .resolution = (res),         \
+                    .enable_interrupt = (irq) },                        \
+        .poll_rate_hz = (hz),                                           \
+    },
+const sensor_device_desc_t sensor_device_table[SENSOR_DEV_NUM] = {
+    SENSOR_DEVICE_TABLE(SENSOR_DEVICE_DESC)
+};
+#undef SENSOR_DEVICE_DESC
+
+// 设备运行状态（位于.bss，不占Flash；配置由sensor_table_start从描述表拷贝）
+sensor_dev_state_t sensor_dev_states[SENSOR_DEV_NUM];
 
 /* ==================== 静态函数实现 ==================== */
 
@@ -82,10 +291,7 @@ static void sensor_reset(void) {
  * @return 传感器状态
  */
 static sensor_status_t sensor_read_reg(uint8_t reg, uint8_t *data) {
-    // I2C读取实现
-    // 这里省略具体的I2C读取代码
-    *data = 0;
-    return SENSOR_STATUS_OK;
+    return sensor_bus_xfer(reg, data, true);
 }
 
 /**
@@ -95,9 +301,130 @@ static sensor_status_t sensor_read_reg(uint8_t reg, uint8_t *data) {
  * @return 传感器状态
  */
 static sensor_status_t sensor_write_reg(uint8_t reg, uint8_t data) {
-    // I2C写入实现
-    // 这里省略具体的I2C写入代码
+    return sensor_bus_xfer(reg, &data, false);
+}
+
+/**
+ * @brief 单次I2C寄存器事务
+ * @param reg     寄存器地址
+ * @param data    数据指针
+ * @param is_read true为读，false为写
+ * @return 传感器状态，无应答返回SENSOR_STATUS_ERROR，超时返回SENSOR_STATUS_TIMEOUT
+ */
+static sensor_status_t sensor_i2c_transfer(uint8_t reg, uint8_t *data, bool is_read) {
+#ifdef SENSOR_SIM_POSIX
+    return sensor_sim_transfer(reg, data, is_read);
+#else
+    // I2C读写实现，总线与从设备地址取自sensor_current_ctx()
+    // 这里省略具体的I2C读写代码
+    (void)reg;
+    if (is_read) {
+        *data = 0;
+    }
+    return SENSOR_STATUS_OK;
+#endif
+}
+
+/**
+ * @brief 带重试与统计的寄存器事务（传输层）
+ * @param reg     寄存器地址
+ * @param data    数据指针
+ * @param is_read true为读，false为写
+ * @return 传感器状态
+ * @note   每个计数器只做一次原子加，不关中断、不加锁
+ */
+static sensor_status_t sensor_bus_xfer(uint8_t reg, uint8_t *data, bool is_read) {
+    sensor_bus_stats_t *stats = sensor_current_ctx()->stats;
+    sensor_status_t status;
+    uint32_t start_us = sensor_get_time_us();
+    uint32_t latency_us;
+    uint8_t bin;
+    uint8_t attempt;
+
+    for (attempt = 0; attempt < MAX_RETRY_COUNT; attempt++) {
+        status = sensor_i2c_transfer(reg, data, is_read);
+        if (status == SENSOR_STATUS_OK) {
+            break;
+        }
+        if (stats != NULL) {
+            atomic_fetch_add_explicit(status == SENSOR_STATUS_TIMEOUT ? &stats->timeouts
+                                                                      : &stats->nacks,
+                                      1, memory_order_relaxed);
+            if (attempt + 1 < MAX_RETRY_COUNT) {
+                atomic_fetch_add_explicit(&stats->retries, 1, memory_order_relaxed);
+            }
+        }
+    }
+
+    if (stats == NULL) {
+        return status;
+    }
+
+    // 延迟按2的幂分桶：桶号为floor(log2(latency_us))
+    latency_us = sensor_get_time_us() - start_us;
+    bin = (latency_us == 0) ? 0 : (uint8_t)(31 - __builtin_clz(latency_us));
+    if (bin >= SENSOR_LAT_BINS) {
+        bin = SENSOR_LAT_BINS - 1;
+    }
+
+    atomic_fetch_add_explicit(&stats->transactions, 1, memory_order_relaxed);
+    if (status == SENSOR_STATUS_OK) {
+        // 寄存器地址字节 + 数据字节
+        atomic_fetch_add_explicit(&stats->bytes, 2, memory_order_relaxed);
+    }
+    atomic_fetch_add_explicit(&stats->latency_hist[bin], 1, memory_order_relaxed);
+
+    return status;
+}
+
+/**
+ * @brief 探测指定地址并读取芯片ID
+ * @param addr 候选从设备地址
+ * @param id   读取的芯片ID指针
+ * @return 传感器状态，地址无应答时返回SENSOR_STATUS_ERROR
+ * @note   地址阶段收到NACK立即返回，不重试、不等待I2C_TIMEOUT_MS，
+ *         使各候选地址的探测可以背靠背发出
+ */
+static sensor_status_t sensor_probe_id(uint8_t addr, uint8_t *id) {
+#ifdef SENSOR_SIM_POSIX
+    return sensor_sim_probe(addr, id);
+#else
+    // 发送START + 地址，检查ACK后读取SENSOR_REG_ID
+    // 这里省略具体的I2C探测代码
+    (void)addr;
+    *id = SENSOR_CHIP_ID;
     return SENSOR_STATUS_OK;
+#endif
+}
+
+/**
+ * @brief 获取微秒时间戳
+ * @return 当前时间（微秒）
+ * @note   可由DWT->CYCCNT或硬件定时器换算，用于统计枚举耗时
+ */
+static uint32_t sensor_get_time_us(void) {
+#ifdef SENSOR_SIM_POSIX
+    return (uint32_t)(sensor_sim.now_ns / 1000U);
+#else
+    // 这里省略具体的计时器读取代码
+    return 0;
+#endif
+}
+
+/**
+ * @brief 按芯片ID查找驱动
+ * @param chip_id 芯片ID
+ * @return 驱动描述指针，未匹配返回NULL
+ */
+static const sensor_driver_t *sensor_match_driver(uint8_t chip_id) {
+    uint8_t i;
+
+    for (i = 0; i < SENSOR_DRIVER_NUM; i++) {
+        if (sensor_driver_table[i]->chip_id == chip_id) {
+            return sensor_driver_table[i];
+        }
+    }
+    return NULL;
 }
 
 /**
@@ -150,12 +477,255 @@ static sensor_status_t sensor_get_data(uint16_t *data) {
     return SENSOR_STATUS_OK;
 }
 
+/**
+ * @brief 设置后续寄存器操作的目标
+ * @param bus_id   总线编号
+ * @param slv_addr 从设备地址
+ * @param stats    总线统计（可为NULL）
+ */
+static void sensor_select_target(uint8_t bus_id, uint8_t slv_addr, sensor_bus_stats_t *stats) {
+    sensor_bus_ctx_t *ctx = sensor_current_ctx();
+
+    ctx->bus_id = bus_id;
+    ctx->slv_addr = slv_addr;
+    ctx->stats = stats;
+}
+
+/**
+ * @brief 获取调用方的总线访问上下文
+ * @return 上下文指针，钩子未设置或返回NULL时为默认上下文
+ */
+static sensor_bus_ctx_t *sensor_current_ctx(void) {
+    sensor_bus_ctx_t *ctx = (sensor_ctx_hook != NULL) ? sensor_ctx_hook() : NULL;
+
+    return (ctx != NULL) ? ctx : &sensor_default_ctx;
+}
+
+/**
+ * @brief 读取总线统计快照
+ * @param stats    总线统计指针
+ * @param snapshot 快照输出指针
+ * @note   各计数器逐个原子读取，快照内各字段之间不保证严格一致
+ */
+static void sensor_stats_snapshot(sensor_bus_stats_t *stats, sensor_bus_snapshot_t *snapshot) {
+    uint8_t i;
+
+    snapshot->transactions = atomic_load_explicit(&stats->transactions, memory_order_relaxed);
+    snapshot->bytes = atomic_load_explicit(&stats->bytes, memory_order_relaxed);
+    snapshot->retries = atomic_load_explicit(&stats->retries, memory_order_relaxed);
+    snapshot->nacks = atomic_load_explicit(&stats->nacks, memory_order_relaxed);
+    snapshot->timeouts = atomic_load_explicit(&stats->timeouts, memory_order_relaxed);
+    for (i = 0; i < SENSOR_LAT_BINS; i++) {
+        snapshot->latency_hist[i] = atomic_load_explicit(&stats->latency_hist[i],
+                                                         memory_order_relaxed);
+    }
+}
+
 /* ==================== 公共函数实现 ==================== */
 
+/**
+ * @brief 选中传感器作为后续寄存器操作的目标
+ * @param sensor 传感器结构体指针
+ * @note   多个传感器共用本驱动时，调用其函数指针前需先选中；
+ *         多任务环境下改用sensor_bus_begin/sensor_bus_end，并设置sensor_set_ctx_hook
+ */
+void sensor_select(sensor_t *sensor) {
+    if (sensor == NULL) {
+        return;
+    }
+
+    sensor_select_target(sensor->bus_id, sensor->slv_addr, &sensor->bus_stats);
+}
+
+/**
+ * @brief 选中设备表中的设备作为后续寄存器操作的目标
+ * @param id 设备编号
+ * @note   地址与驱动取自sensor_device_table，统计计入sensor_dev_states[id]；
+ *         选中后通过sensor_device_table[id].driver调用驱动函数
+ */
+void sensor_dev_select(sensor_device_id_t id) {
+    if (id >= SENSOR_DEV_NUM) {
+        return;
+    }
+
+    sensor_select_target(sensor_device_table[id].bus_id, sensor_device_table[id].slv_addr,
+                         &sensor_dev_states[id].bus_stats);
+}
+
+/**
+ * @brief 设置总线加锁/解锁钩子
+ * @param lock   加锁钩子（如优先级仲裁器的acquire），NULL表示不加锁
+ * @param unlock 解锁钩子
+ */
+void sensor_set_bus_lock(sensor_bus_lock_fn lock, sensor_bus_lock_fn unlock) {
+    sensor_bus_lock = lock;
+    sensor_bus_unlock = unlock;
+}
+
+/**
+ * @brief 设置获取当前任务总线访问上下文的钩子
+ * @param get_ctx 钩子，NULL表示所有调用方共用默认上下文
+ * @note   多任务访问不同总线时必须设置：选中目标与统计归属按任务保存，
+ *         不同总线上的事务并行进行时各自计入正确的设备
+ */
+void sensor_set_ctx_hook(sensor_ctx_fn get_ctx) {
+    sensor_ctx_hook = get_ctx;
+}
+
+/**
+ * @brief 获取传感器所在总线并选中传感器
+ * @param sensor    传感器结构体指针
+ * @param requester 调用方请求句柄，原样传给加锁钩子
+ * @note   多任务共用总线时，begin/end之间的寄存器操作构成一次不可分割的事务，
+ *         事务之间由仲裁器决定下一个持有者
+ */
+void sensor_bus_begin(sensor_t *sensor, void *requester) {
+    if (sensor == NULL) {
+        return;
+    }
+
+    if (sensor_bus_lock != NULL) {
+        sensor_bus_lock(sensor->bus_id, requester);
+    }
+    sensor_select(sensor);
+}
+
+/**
+ * @brief 释放传感器所在总线
+ * @param sensor    传感器结构体指针
+ * @param requester 调用方请求句柄
+ */
+void sensor_bus_end(sensor_t *sensor, void *requester) {
+    if (sensor == NULL) {
+        return;
+    }
+
+    if (sensor_bus_unlock != NULL) {
+        sensor_bus_unlock(sensor->bus_id, requester);
+    }
+}
+
+/**
+ * @brief 获取设备表中设备所在总线并选中设备
+ * @param id        设备编号
+ * @param requester 调用方请求句柄，原样传给加锁钩子
+ */
+void sensor_dev_bus_begin(sensor_device_id_t id, void *requester) {
+    if (id >= SENSOR_DEV_NUM) {
+        return;
+    }
+
+    if (sensor_bus_lock != NULL) {
+        sensor_bus_lock(sensor_device_table[id].bus_id, requester);
+    }
+    sensor_dev_select(id);
+}
+
+/**
+ * @brief 释放设备表中设备所在总线
+ * @param id        设备编号
+ * @param requester 调用方请求句柄
+ */
+void sensor_dev_bus_end(sensor_device_id_t id, void *requester) {
+    if (id >= SENSOR_DEV_NUM) {
+        return;
+    }
+
+    if (sensor_bus_unlock != NULL) {
+        sensor_bus_unlock(sensor_device_table[id].bus_id, requester);
+    }
+}
+
+/**
+ * @brief 获取传感器总线事务统计快照
+ * @param sensor   传感器结构体指针
+ * @param snapshot 快照输出指针
+ * @return 获取状态，0表示成功，非0表示失败
+ * @note   各计数器逐个原子读取，快照内各字段之间不保证严格一致
+ */
+uint8_t sensor_get_bus_stats(sensor_t *sensor, sensor_bus_snapshot_t *snapshot) {
+    if (sensor == NULL || snapshot == NULL) {
+        return 1;
+    }
+
+    sensor_stats_snapshot(&sensor->bus_stats, snapshot);
+    return 0;
+}
+
+/**
+ * @brief 查找设备表中总线占用最高的设备
+ * @param snapshots 各设备快照输出数组（SENSOR_DEV_NUM个，可为NULL）
+ * @return 事务次数最多的设备编号
+ * @note   用于定位总线饱和的责任设备并调整其轮询频率
+ */
+sensor_device_id_t sensor_table_find_hot(sensor_bus_snapshot_t *snapshots) {
+    sensor_bus_snapshot_t snap;
+    sensor_device_id_t hot = (sensor_device_id_t)0;
+    uint32_t max_transactions = 0;
+    uint8_t i;
+
+    for (i = 0; i < SENSOR_DEV_NUM; i++) {
+        sensor_stats_snapshot(&sensor_dev_states[i].bus_stats, &snap);
+        if (snapshots != NULL) {
+            snapshots[i] = snap;
+        }
+        if (snap.transactions > max_transactions) {
+            max_transactions = snap.transactions;
+            hot = (sensor_device_id_t)i;
+        }
+    }
+
+    return hot;
+}
+
+/**
+ * @brief 传感器枚举函数
+ * @param sensor 传感器结构体指针
+ * @param result 枚举结果指针（可为NULL）
+ * @return 传感器状态，未找到匹配驱动时返回SENSOR_STATUS_ERROR
+ * @note   依次探测候选地址并读取SENSOR_REG_ID，按芯片ID绑定驱动
+ */
+sensor_status_t sensor_probe(sensor_t *sensor, sensor_probe_result_t *result) {
+    sensor_probe_result_t res = {0};
+    const sensor_driver_t *driver = NULL;
+    uint32_t start_us;
+    uint8_t id = 0;
+    uint8_t i;
+
+    // 检查指针有效性
+    if (sensor == NULL) {
+        return SENSOR_STATUS_ERROR;
+    }
+
+    start_us = sensor_get_time_us();
+
+    // 背靠背探测候选地址，无应答地址立即跳过
+    for (i = 0; i < SENSOR_PROBE_ADDR_NUM && driver == NULL; i++) {
+        res.probed++;
+        if (sensor_probe_id(sensor_probe_addrs[i], &id) != SENSOR_STATUS_OK) {
+            continue;
+        }
+        res.acked++;
+        driver = sensor_match_driver(id);
+        if (driver != NULL) {
+            sensor->slv_addr = sensor_probe_addrs[i];
+            sensor->chip_id = id;
+        }
+    }
+
+    res.probe_time_us = sensor_get_time_us() - start_us;
+    if (result != NULL) {
+        *result = res;
+    }
+
+    sensor->driver = driver;
+    return (driver != NULL) ? SENSOR_STATUS_OK : SENSOR_STATUS_ERROR;
+}
+
 /**
  * @brief 传感器初始化函数
  * @param sensor 传感器结构体指针
- * @return 初始化状态，0表示成功，非0表示失败
+ * @return 初始化状态，0表示成功，1表示参数错误，2表示未找到匹配的传感器
  */
 uint8_t sensor_init(sensor_t *sensor) {
     // 检查指针有效性
@@ -163,20 +733,28 @@ uint8_t sensor_init(sensor_t *sensor) {
         return 1;
     }
     
-    // 设置从设备地址
-    sensor->slv_addr = SENSOR_I2C_ADDR;
+    // 默认挂在0号总线，清零总线统计
+    sensor->bus_id = 0;
+    sensor->bus_stats = (sensor_bus_stats_t){0};
+    
+    // 枚举候选地址并匹配驱动
+    if (sensor_probe(sensor, NULL) != SENSOR_STATUS_OK) {
+        return 2;
+    }
+    sensor_select(sensor);
     
     // 绑定函数指针（面向对象核心）
-    sensor->reset = sensor_reset;
-    sensor->read_reg = sensor_read_reg;
-    sensor->write_reg = sensor_write_reg;
-    sensor->set_config = sensor_set_config;
-    sensor->get_data = sensor_get_data;
+    sensor->reset = sensor->driver->reset;
+    sensor->read_reg = sensor->driver->read_reg;
+    sensor->write_reg = sensor->driver->write_reg;
+    sensor->set_config = sensor->driver->set_config;
+    sensor->get_data = sensor->driver->get_data;
     
     // 初始化默认配置
     sensor->config.sample_rate = 10;
     sensor->config.resolution = 12;
     sensor->config.enable_interrupt = false;
+    sensor->calib = NULL;
     
     // 执行复位
     sensor->reset();
@@ -187,6 +765,46 @@ uint8_t sensor_init(sensor_t *sensor) {
     return 0;
 }
 
+/**
+ * @brief 启动静态设备表中的全部设备
+ * @param result 启动结果指针（可为NULL）
+ * @return 启动失败的设备数，0表示全部成功
+ * @note   地址与驱动直接使用sensor_device_table，无需逐个绑定；
+ *         此处只拷贝初始配置并执行复位与配置写入等硬件操作
+ */
+uint8_t sensor_table_start(sensor_table_result_t *result) {
+    sensor_table_result_t res = {0};
+    uint32_t start_us = sensor_get_time_us();
+    const sensor_device_desc_t *desc;
+    sensor_dev_state_t *state;
+    uint8_t i;
+
+    for (i = 0; i < SENSOR_DEV_NUM; i++) {
+        desc = &sensor_device_table[i];
+        state = &sensor_dev_states[i];
+        state->config = desc->config;
+        state->is_initialized = false;
+
+        // 选中设备所在总线与地址后执行硬件写入
+        sensor_dev_select((sensor_device_id_t)i);
+        desc->driver->reset();
+        if (desc->driver->set_config(&state->config) != SENSOR_STATUS_OK) {
+            res.failed++;
+            continue;
+        }
+
+        state->is_initialized = true;
+        res.started++;
+    }
+
+    res.boot_time_us = sensor_get_time_us() - start_us;
+    if (result != NULL) {
+        *result = res;
+    }
+
+    return res.failed;
+}
+
 /**
  * @brief 传感器去初始化函数
  * @param sensor 传感器结构体指针
@@ -202,6 +820,7 @@ uint8_t sensor_deinit(sensor_t *sensor) {
     sensor->is_initialized = false;
     
     // 清空函数指针
+    sensor->driver = NULL;
     sensor->reset = NULL;
     sensor->read_reg = NULL;
     sensor->write_reg = NULL;
@@ -211,6 +830,128 @@ uint8_t sensor_deinit(sensor_t *sensor) {
     return 0;
 }
 
+/* ==================== 主机仿真 ==================== */
+
+#ifdef SENSOR_SIM_POSIX
+
+#include <string.h>
+
+#define SENSOR_SIM_BIT_NS          2500U       // 总线位时间（纳秒，400kHz）
+#define SENSOR_SIM_NACK_BITS       11U         // 无应答探测：START + 地址字节 + STOP
+#define SENSOR_SIM_ID_BITS         39U         // 读ID：START + 写地址 + 寄存器 + RESTART + 读地址 + 数据 + STOP
+#define SENSOR_SIM_READ_BITS       39U         // 读寄存器：与读ID相同
+#define SENSOR_SIM_WRITE_BITS      29U         // 写寄存器：START + 写地址 + 寄存器 + 数据 + STOP
+#define SENSOR_SIM_VARIANTS        4           // 仿真的板卡变体数
+
+/**
+ * @brief 仿真结果结构体
+ * @note  变体依次为：芯片在首个候选地址、芯片在最后一个候选地址、
+ *        只有未知芯片、未贴装传感器
+ */
+typedef struct {
+    uint32_t probe_time_us[SENSOR_SIM_VARIANTS];           /**< 背靠背探测总耗时（微秒） */
+    uint32_t timeout_probe_time_us[SENSOR_SIM_VARIANTS];   /**< 无应答按超时重试时的总耗时（微秒） */
+    uint8_t probed[SENSOR_SIM_VARIANTS];                   /**< 探测的地址数 */
+    bool is_bound[SENSOR_SIM_VARIANTS];                    /**< 是否绑定到驱动 */
+    uint32_t table_boot_time_us;                           /**< 静态设备表启动耗时（微秒） */
+    uint8_t table_started;                                 /**< 静态设备表启动成功的设备数 */
+} sensor_sim_result_t;
+
+/**
+ * @brief 仿真探测：按线上位数推进虚拟时间
+ * @param addr 候选从设备地址
+ * @param id   读取的芯片ID指针
+ * @return 传感器状态
+ */
+static sensor_status_t sensor_sim_probe(uint8_t addr, uint8_t *id) {
+    uint8_t idx = (uint8_t)(addr - SENSOR_I2C_ADDR);
+    uint8_t attempt;
+
+    if (idx < SENSOR_PROBE_ADDR_NUM && sensor_sim.chip_at[idx] != 0) {
+        sensor_sim.now_ns += (uint64_t)SENSOR_SIM_ID_BITS * SENSOR_SIM_BIT_NS;
+        *id = sensor_sim.chip_at[idx];
+        return SENSOR_STATUS_OK;
+    }
+
+    if (sensor_sim.is_nack_timeout) {
+        // 对比基准：每次尝试都等满I2C_TIMEOUT_MS并重试MAX_RETRY_COUNT次
+        for (attempt = 0; attempt < MAX_RETRY_COUNT; attempt++) {
+            sensor_sim.now_ns += (uint64_t)I2C_TIMEOUT_MS * 1000000U;
+        }
+        return SENSOR_STATUS_TIMEOUT;
+    }
+    sensor_sim.now_ns += (uint64_t)SENSOR_SIM_NACK_BITS * SENSOR_SIM_BIT_NS;
+    return SENSOR_STATUS_ERROR;
+}
+
+/**
+ * @brief 仿真寄存器事务：按线上位数推进虚拟时间
+ * @param reg     寄存器地址
+ * @param data    数据指针
+ * @param is_read true为读，false为写
+ * @return 传感器状态（仿真设备总是应答）
+ */
+static sensor_status_t sensor_sim_transfer(uint8_t reg, uint8_t *data, bool is_read) {
+    (void)reg;
+    if (is_read) {
+        sensor_sim.now_ns += (uint64_t)SENSOR_SIM_READ_BITS * SENSOR_SIM_BIT_NS;
+        *data = 0;
+    } else {
+        sensor_sim.now_ns += (uint64_t)SENSOR_SIM_WRITE_BITS * SENSOR_SIM_BIT_NS;
+    }
+    return SENSOR_STATUS_OK;
+}
+
+/**
+ * @brief 上电枚举耗时仿真
+ * @param result 结果输出指针
+ * @return 状态，0表示成功，非0表示失败
+ * @note   对每种板卡变体运行sensor_probe，分别测量NACK立即返回与按超时重试两种方式的耗时；
+ *         另运行一次sensor_table_start，启动耗时由各设备复位与配置写入的总线事务累计
+ */
+uint8_t sensor_sim_run(sensor_sim_result_t *result) {
+    static const uint8_t variants[SENSOR_SIM_VARIANTS][SENSOR_PROBE_ADDR_NUM] = {
+        { SENSOR_CHIP_ID, 0, 0, 0 },
+        { 0, 0, 0, SENSOR_CHIP_ID },
+        { 0, 0x77, 0, 0 },
+        { 0, 0, 0, 0 },
+    };
+    sensor_probe_result_t probe;
+    sensor_table_result_t boot;
+    sensor_t sensor = {0};
+    uint8_t v, pass;
+
+    if (result == NULL) {
+        return 1;
+    }
+    *result = (sensor_sim_result_t){0};
+
+    for (v = 0; v < SENSOR_SIM_VARIANTS; v++) {
+        for (pass = 0; pass < 2; pass++) {
+            memcpy(sensor_sim.chip_at, variants[v], sizeof(sensor_sim.chip_at));
+            sensor_sim.is_nack_timeout = (pass == 1);
+            sensor_sim.now_ns = 0;
+
+            result->is_bound[v] = (sensor_probe(&sensor, &probe) == SENSOR_STATUS_OK);
+            if (pass == 0) {
+                result->probe_time_us[v] = probe.probe_time_us;
+                result->probed[v] = probe.probed;
+            } else {
+                result->timeout_probe_time_us[v] = probe.probe_time_us;
+            }
+        }
+    }
+
+    sensor_sim.now_ns = 0;
+    sensor_table_start(&boot);
+    result->table_boot_time_us = boot.boot_time_us;
+    result->table_started = boot.started;
+
+    return 0;
+}
+
+#endif /* SENSOR_SIM_POSIX */
+
 /* ==================== 使用示例 ==================== */
 
 /*
@@ -220,6 +961,12 @@ uint8_t sensor_deinit(sensor_t *sensor) {
  *     sensor_t my_sensor;
  *     uint16_t sensor_data;
  *     sensor_config_t config;
+ *     sensor_probe_result_t probe;
+ *     
+ *     // 枚举传感器并查看探测耗时（可选，sensor_init内部也会执行枚举）
+ *     if (sensor_probe(&my_sensor, &probe) == SENSOR_STATUS_OK) {
+ *         // probe.probe_time_us 为全部候选地址的探测总耗时
+ *     }
  *     
  *     // 初始化传感器
  *     if (sensor_init(&my_sensor) != 0) {
@@ -243,4 +990,43 @@ uint8_t sensor_deinit(sensor_t *sensor) {
  *     
  *     return 0;
  * }
+ *
+ * 静态设备表使用示例（适用于设备数量较多的板卡）：
+ *
+ * int main(void) {
+ *     sensor_table_result_t boot;
+ *     uint16_t imu_data;
+ *
+ *     // 设备描述已在编译期生成，启动时只做硬件写入
+ *     sensor_table_start(&boot);
+ *     // boot.boot_time_us 为全部设备的启动耗时
+ *
+ *     // 通过设备编号选中设备，经描述表中的驱动访问
+ *     sensor_dev_select(SENSOR_DEV_IMU_0);
+ *     sensor_device_table[SENSOR_DEV_IMU_0].driver->get_data(&imu_data);
+ *
+ *     // 总线饱和时查找占用最高的设备并查看其事务统计
+ *     sensor_bus_snapshot_t snaps[SENSOR_DEV_NUM];
+ *     sensor_device_id_t hot = sensor_table_find_hot(snaps);
+ *     // snaps[hot].nacks、snaps[hot].latency_hist 等用于调整轮询频率
+ *
+ *     // 多任务共用总线时，由仲裁器串行化（见sensor_bus_arbiter_template.c），
+ *     // 并按任务保存选中目标，事务统计计入各自的设备
+ *     sensor_set_bus_lock(bus_lock, bus_unlock);
+ *     sensor_set_ctx_hook(task_bus_ctx);   // 返回任务本地存储中的sensor_bus_ctx_t
+ *     sensor_dev_bus_begin(SENSOR_DEV_IMU_0, &imu_req);
+ *     sensor_device_table[SENSOR_DEV_IMU_0].driver->get_data(&imu_data);
+ *     sensor_dev_bus_end(SENSOR_DEV_IMU_0, &imu_req);
+ *
+ *     // 只读参数查描述表，运行状态查sensor_dev_states
+ *     uint16_t hz = sensor_device_table[SENSOR_DEV_IMU_0].poll_rate_hz;
+ *     bool is_up = sensor_dev_states[SENSOR_DEV_IMU_0].is_initialized;
+ *
+ *     return 0;
+ * }
+ *
+ * 主机仿真（Linux）：
+ *   gcc -std=c11 -O2 -DSENSOR_SIM_POSIX sensor_driver_template.c test_main.c
+ *   sensor_sim_result_t r;
+ *   sensor_sim_run(&r);       // r.probe_time_us[] / r.timeout_probe_time_us[] / r.table_boot_time_us
  */
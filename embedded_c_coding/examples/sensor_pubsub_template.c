@@ -0,0 +1,326 @@
+/**
+ * @file sensor_pubsub_template.c
+ * @brief 传感器发布/订阅模板文件
+ * @description 每个传感器每周期只读取一次总线，采样结果发布到共享环形缓冲区，
+ *              任意数量的订阅者通过各自的游标读取；读端无锁，
+ *              发布者覆盖未读数据时订阅者可检测并统计丢失
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+/* ==================== 宏定义 ==================== */
+
+#define SENSOR_TOPIC_DEPTH         16      // 共享环形缓冲区深度（2的幂）
+#define SENSOR_TOPIC_MASK          (SENSOR_TOPIC_DEPTH - 1)
+#define SENSOR_SUB_RETRY_MAX       4       // 读取被覆盖时的最大重试次数
+
+/* ==================== 类型定义 ==================== */
+
+/**
+ * @brief 传感器状态枚举（与sensor_driver_template.c保持一致）
+ */
+typedef enum {
+    SENSOR_STATUS_OK = 0,      // 正常
+    SENSOR_STATUS_ERROR,       // 错误
+    SENSOR_STATUS_TIMEOUT,     // 超时
+    SENSOR_STATUS_BUSY         // 忙碌
+} sensor_status_t;
+
+/**
+ * @brief 发布/订阅结果枚举
+ */
+typedef enum {
+    SENSOR_SUB_OK = 0,             /**< 读到新样本 */
+    SENSOR_SUB_EMPTY,              /**< 暂无新样本 */
+    SENSOR_SUB_ERROR_NULL_PTR      /**< 空指针错误 */
+} sensor_sub_result_t;
+
+/**
+ * @brief 带时间戳的采样结构体
+ */
+typedef struct {
+    uint32_t seq;                  /**< 发布序号（从1开始） */
+    uint32_t timestamp;            /**< 采样时间戳 */
+    uint16_t value;                /**< 采样值 */
+} sensor_sample_t;
+
+/**
+ * @brief 环形缓冲区槽位结构体
+ * @note  seq最后写入，读端通过前后两次比较seq判断槽位是否被覆盖
+ */
+typedef struct {
+    atomic_uint_least32_t seq;     /**< 槽位当前样本序号，0表示正在写入 */
+    uint32_t timestamp;            /**< 采样时间戳 */
+    uint16_t value;                /**< 采样值 */
+} sensor_topic_slot_t;
+
+/* === 前向声明 === */
+
+typedef struct sensor_topic_t sensor_topic_t;
+typedef struct sensor_sub_t sensor_sub_t;
+
+/* === 函数指针类型定义 === */
+
+/**
+ * @brief 传感器读取函数指针类型（与sensor_t.get_data签名一致）
+ */
+typedef sensor_status_t (*sensor_topic_read_fn)(uint16_t *data);
+
+/**
+ * @brief 周期轮询发布函数指针类型
+ */
+typedef sensor_status_t (*sensor_topic_poll_fn)(sensor_topic_t *topic, uint32_t timestamp);
+
+/**
+ * @brief 订阅者读取函数指针类型
+ */
+typedef sensor_sub_result_t (*sensor_sub_read_fn)(sensor_sub_t *sub, sensor_sample_t *sample);
+
+/**
+ * @brief 传感器主题结构体（单发布者）
+ */
+struct sensor_topic_t {
+    /* 硬件配置 */
+    sensor_topic_read_fn read;                  /**< 底层读取函数 */
+
+    /* 运行状态 */
+    sensor_topic_slot_t slots[SENSOR_TOPIC_DEPTH];  /**< 共享环形缓冲区 */
+    atomic_uint_least32_t last_seq;             /**< 最新已发布序号 */
+    uint32_t bus_reads;                         /**< 总线读取次数 */
+    uint32_t read_errors;                       /**< 读取失败次数 */
+
+    /* 函数指针 - 操作方法 */
+    sensor_topic_poll_fn poll;                  /**< 周期轮询并发布 */
+};
+
+/**
+ * @brief 订阅者结构体（每个消费任务一个）
+ */
+struct sensor_sub_t {
+    /* 运行状态 */
+    sensor_topic_t *topic;         /**< 订阅的主题 */
+    uint32_t next_seq;             /**< 下一个待读序号（游标） */
+    uint32_t received;             /**< 已读样本数 */
+    uint32_t dropped;              /**< 因被覆盖而丢失的样本数 */
+
+    /* 函数指针 - 操作方法 */
+    sensor_sub_read_fn read;       /**< 读取下一个样本 */
+};
+
+/* ==================== 静态函数声明 ==================== */
+
+static sensor_status_t sensor_topic_impl_poll(sensor_topic_t *topic, uint32_t timestamp);
+static sensor_sub_result_t sensor_sub_impl_read(sensor_sub_t *sub, sensor_sample_t *sample);
+
+/* ==================== 静态函数实现 ==================== */
+
+/**
+ * @brief 周期轮询并发布实现函数
+ * @param topic     主题结构体指针
+ * @param timestamp 采样时间戳
+ * @return 传感器状态
+ * @note   每周期由唯一的发布任务调用一次，无论订阅者数量多少只读一次总线
+ */
+static sensor_status_t sensor_topic_impl_poll(sensor_topic_t *topic, uint32_t timestamp) {
+    sensor_topic_slot_t *slot;
+    sensor_status_t status;
+    uint16_t value;
+    uint32_t seq;
+
+    if (topic == NULL) {
+        return SENSOR_STATUS_ERROR;
+    }
+
+    topic->bus_reads++;
+    status = topic->read(&value);
+    if (status != SENSOR_STATUS_OK) {
+        topic->read_errors++;
+        return status;
+    }
+
+    seq = atomic_load_explicit(&topic->last_seq, memory_order_relaxed) + 1U;
+    if (seq == 0) {
+        seq = 1;    // 跳过0，0保留为“正在写入”标记
+    }
+    slot = &topic->slots[seq & SENSOR_TOPIC_MASK];
+
+    // 先标记槽位正在写入，再写数据，最后发布序号
+    atomic_store_explicit(&slot->seq, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    slot->timestamp = timestamp;
+    slot->value = value;
+    atomic_store_explicit(&slot->seq, seq, memory_order_release);
+    atomic_store_explicit(&topic->last_seq, seq, memory_order_release);
+
+    return SENSOR_STATUS_OK;
+}
+
+/**
+ * @brief 订阅者读取实现函数
+ * @param sub    订阅者结构体指针
+ * @param sample 样本输出指针
+ * @return 读取结果
+ * @note   无锁读取：复制槽位前后两次校验序号，若被发布者覆盖则跳到最旧的有效样本
+ */
+static sensor_sub_result_t sensor_sub_impl_read(sensor_sub_t *sub, sensor_sample_t *sample) {
+    const sensor_topic_slot_t *slot;
+    uint32_t last;
+    uint32_t oldest;
+    uint32_t seq_before;
+    uint8_t retry;
+
+    if (sub == NULL || sample == NULL || sub->topic == NULL) {
+        return SENSOR_SUB_ERROR_NULL_PTR;
+    }
+
+    for (retry = 0; retry < SENSOR_SUB_RETRY_MAX; retry++) {
+        last = atomic_load_explicit(&sub->topic->last_seq, memory_order_acquire);
+        if ((int32_t)(last - sub->next_seq) < 0) {
+            return SENSOR_SUB_EMPTY;
+        }
+
+        // 游标落后超过缓冲区深度，说明未读样本已被覆盖
+        oldest = last - SENSOR_TOPIC_DEPTH + 1U;
+        if ((int32_t)(oldest - sub->next_seq) > 0) {
+            sub->dropped += oldest - sub->next_seq;
+            sub->next_seq = oldest;
+        }
+
+        slot = &sub->topic->slots[sub->next_seq & SENSOR_TOPIC_MASK];
+        seq_before = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        sample->timestamp = slot->timestamp;
+        sample->value = slot->value;
+        atomic_thread_fence(memory_order_acquire);
+
+        if (seq_before == sub->next_seq &&
+            atomic_load_explicit(&slot->seq, memory_order_relaxed) == seq_before) {
+            sample->seq = seq_before;
+            sub->next_seq++;
+            sub->received++;
+            return SENSOR_SUB_OK;
+        }
+        // 读取过程中槽位被覆盖，重新定位游标
+    }
+
+    return SENSOR_SUB_EMPTY;
+}
+
+/* ==================== 公共函数实现 ==================== */
+
+/**
+ * @brief 主题初始化函数
+ * @param topic 主题结构体指针
+ * @param read  底层读取函数（如sensor.get_data）
+ * @return 初始化状态，0表示成功，非0表示失败
+ */
+uint8_t sensor_topic_init(sensor_topic_t *topic, sensor_topic_read_fn read) {
+    uint8_t i;
+
+    // 检查指针有效性
+    if (topic == NULL || read == NULL) {
+        return 1;
+    }
+
+    topic->read = read;
+    for (i = 0; i < SENSOR_TOPIC_DEPTH; i++) {
+        atomic_init(&topic->slots[i].seq, 0);
+        topic->slots[i].timestamp = 0;
+        topic->slots[i].value = 0;
+    }
+    atomic_init(&topic->last_seq, 0);
+    topic->bus_reads = 0;
+    topic->read_errors = 0;
+
+    // 绑定函数指针（面向对象核心）
+    topic->poll = sensor_topic_impl_poll;
+
+    return 0;
+}
+
+/**
+ * @brief 订阅者初始化函数
+ * @param sub   订阅者结构体指针
+ * @param topic 订阅的主题
+ * @return 初始化状态，0表示成功，非0表示失败
+ * @note   订阅者从下一个发布的样本开始读取，不回放历史数据
+ */
+uint8_t sensor_sub_init(sensor_sub_t *sub, sensor_topic_t *topic) {
+    // 检查指针有效性
+    if (sub == NULL || topic == NULL) {
+        return 1;
+    }
+
+    sub->topic = topic;
+    sub->next_seq = atomic_load_explicit(&topic->last_seq, memory_order_acquire) + 1U;
+    sub->received = 0;
+    sub->dropped = 0;
+
+    // 绑定函数指针（面向对象核心）
+    sub->read = sensor_sub_impl_read;
+
+    return 0;
+}
+
+/**
+ * @brief 读取订阅者最新样本（跳过所有积压样本）
+ * @param sub    订阅者结构体指针
+ * @param sample 样本输出指针
+ * @return 读取结果
+ * @note   适用于只关心最新值的控制任务，跳过的样本不计入dropped
+ */
+sensor_sub_result_t sensor_sub_read_latest(sensor_sub_t *sub, sensor_sample_t *sample) {
+    uint32_t last;
+
+    if (sub == NULL || sample == NULL || sub->topic == NULL) {
+        return SENSOR_SUB_ERROR_NULL_PTR;
+    }
+
+    last = atomic_load_explicit(&sub->topic->last_seq, memory_order_acquire);
+    if ((int32_t)(last - sub->next_seq) > 0) {
+        sub->next_seq = last;
+    }
+    return sub->read(sub, sample);
+}
+
+/* ==================== 使用示例 ==================== */
+
+/*
+ * 使用示例：
+ *
+ * static sensor_t imu;
+ * static sensor_topic_t imu_topic;
+ * static sensor_sub_t ctrl_sub, log_sub, ui_sub;
+ *
+ * // 发布任务：每周期只读一次总线
+ * void sensor_poll_task(void) {
+ *     imu_topic.poll(&imu_topic, get_tick());
+ * }
+ *
+ * // 控制任务：只取最新值
+ * void control_task(void) {
+ *     sensor_sample_t s;
+ *     if (sensor_sub_read_latest(&ctrl_sub, &s) == SENSOR_SUB_OK) {
+ *         // 使用s.value
+ *     }
+ * }
+ *
+ * // 记录任务：按顺序读取全部样本
+ * void log_task(void) {
+ *     sensor_sample_t s;
+ *     while (log_sub.read(&log_sub, &s) == SENSOR_SUB_OK) {
+ *         // 写入日志
+ *     }
+ * }
+ *
+ * int main(void) {
+ *     sensor_init(&imu);
+ *     sensor_topic_init(&imu_topic, imu.get_data);
+ *     sensor_sub_init(&ctrl_sub, &imu_topic);
+ *     sensor_sub_init(&log_sub, &imu_topic);
+ *     sensor_sub_init(&ui_sub, &imu_topic);
+ *     // 三个订阅者共享一次总线读取：imu_topic.bus_reads等于轮询周期数
+ * }
+ */
@@ -0,0 +1,303 @@
+/**
+ * @file sensor_resampler_template.c
+ * @brief 多速率传感器流重采样模板文件
+ * @description 将采样率各异且存在漂移的带时间戳传感器流对齐到控制节拍，
+ *              每路流只保存两个相邻样本，按请求时间戳输出线性插值或保持值，
+ *              每次输出的均摊开销为O(1)，融合与控制代码无需扫描历史数据
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* ==================== 宏定义 ==================== */
+
+#define SENSOR_RESAMPLE_STREAM_MAX   8       // 最大流数量
+#define SENSOR_RESAMPLE_PULL_MAX     16      // 单次输出最多消耗的输入样本数（限制最坏耗时）
+
+/* ==================== 类型定义 ==================== */
+
+/**
+ * @brief 带时间戳的采样结构体（与sensor_pubsub_template.c保持一致）
+ */
+typedef struct {
+    uint32_t seq;                  /**< 发布序号 */
+    uint32_t timestamp;            /**< 采样时间戳 */
+    uint16_t value;                /**< 采样值 */
+} sensor_sample_t;
+
+/**
+ * @brief 重采样方式枚举
+ */
+typedef enum {
+    SENSOR_RESAMPLE_HOLD = 0,      /**< 零阶保持 */
+    SENSOR_RESAMPLE_LINEAR         /**< 线性插值，无后续样本时退化为保持 */
+} sensor_resample_mode_t;
+
+/**
+ * @brief 输出质量标志枚举
+ */
+typedef enum {
+    SENSOR_RESAMPLE_NO_DATA = 0,   /**< 尚无样本 */
+    SENSOR_RESAMPLE_INTERPOLATED,  /**< 由前后两个样本插值得到 */
+    SENSOR_RESAMPLE_HELD,          /**< 保持最近样本 */
+    SENSOR_RESAMPLE_STALE          /**< 最近样本已超过最大时效 */
+} sensor_resample_quality_t;
+
+/**
+ * @brief 重采样输出结构体
+ */
+typedef struct {
+    uint16_t value;                       /**< 输出值 */
+    uint32_t age;                         /**< 最近样本距请求时刻的时长 */
+    sensor_resample_quality_t quality;    /**< 输出质量 */
+} sensor_resample_out_t;
+
+/* === 前向声明 === */
+
+typedef struct sensor_resampler_t sensor_resampler_t;
+
+/* === 函数指针类型定义 === */
+
+/**
+ * @brief 拉取输入样本函数指针类型
+ * @note  通常绑定到订阅者读取函数，无新样本时返回false
+ */
+typedef bool (*sensor_resample_pull_fn)(void *ctx, sensor_sample_t *sample);
+
+/**
+ * @brief 单路流状态结构体
+ * @note  仅保存s0（不晚于请求时刻的最新样本）和s1（晚于请求时刻的首个样本）
+ */
+typedef struct {
+    sensor_resample_pull_fn pull;  /**< 输入拉取函数 */
+    void *ctx;                     /**< 拉取上下文 */
+    sensor_resample_mode_t mode;   /**< 重采样方式 */
+    uint32_t max_age;              /**< 最大时效，超过后输出标记为STALE */
+    sensor_sample_t s0;            /**< 前一样本 */
+    sensor_sample_t s1;            /**< 后一样本 */
+    bool has_s0;                   /**< s0有效 */
+    bool has_s1;                   /**< s1有效 */
+} sensor_resample_stream_t;
+
+/**
+ * @brief 获取对齐输出函数指针类型
+ */
+typedef sensor_resample_out_t (*sensor_resampler_sample_fn)(sensor_resampler_t *rs,
+                                                            uint8_t stream,
+                                                            uint32_t timestamp);
+
+/**
+ * @brief 重采样器结构体
+ */
+struct sensor_resampler_t {
+    /* 运行状态 */
+    sensor_resample_stream_t streams[SENSOR_RESAMPLE_STREAM_MAX];  /**< 流状态 */
+    uint8_t stream_num;                                            /**< 已注册流数量 */
+
+    /* 函数指针 - 操作方法 */
+    sensor_resampler_sample_fn sample;    /**< 获取指定时刻的对齐输出 */
+};
+
+/* ==================== 静态函数声明 ==================== */
+
+static sensor_resample_out_t sensor_resampler_impl_sample(sensor_resampler_t *rs,
+                                                          uint8_t stream,
+                                                          uint32_t timestamp);
+static void sensor_resample_advance(sensor_resample_stream_t *st, uint32_t timestamp);
+
+/* ==================== 静态函数实现 ==================== */
+
+/**
+ * @brief 推进流状态，使s0不晚于请求时刻、s1晚于请求时刻
+ * @param st        流状态指针
+ * @param timestamp 请求时间戳
+ * @note   每个输入样本只被消耗一次，输出速率与输入速率相当时均摊O(1)
+ */
+static void sensor_resample_advance(sensor_resample_stream_t *st, uint32_t timestamp) {
+    sensor_sample_t x;
+    uint8_t n;
+
+    // 上次的后一样本已不晚于请求时刻，转为前一样本
+    if (st->has_s1 && (int32_t)(st->s1.timestamp - timestamp) <= 0) {
+        st->s0 = st->s1;
+        st->has_s0 = true;
+        st->has_s1 = false;
+    }
+    if (st->has_s1) {
+        return;
+    }
+
+    for (n = 0; n < SENSOR_RESAMPLE_PULL_MAX; n++) {
+        if (!st->pull(st->ctx, &x)) {
+            break;
+        }
+        if ((int32_t)(x.timestamp - timestamp) <= 0) {
+            st->s0 = x;
+            st->has_s0 = true;
+        } else {
+            st->s1 = x;
+            st->has_s1 = true;
+            break;
+        }
+    }
+}
+
+/**
+ * @brief 获取对齐输出实现函数
+ * @param rs        重采样器结构体指针
+ * @param stream    流编号
+ * @param timestamp 请求时间戳（须单调不减）
+ * @return 对齐输出
+ */
+static sensor_resample_out_t sensor_resampler_impl_sample(sensor_resampler_t *rs,
+                                                          uint8_t stream,
+                                                          uint32_t timestamp) {
+    sensor_resample_out_t out = { 0, 0, SENSOR_RESAMPLE_NO_DATA };
+    sensor_resample_stream_t *st;
+    int32_t dv;
+    uint32_t dt;
+    uint32_t span;
+
+    if (rs == NULL || stream >= rs->stream_num) {
+        return out;
+    }
+
+    st = &rs->streams[stream];
+    sensor_resample_advance(st, timestamp);
+
+    if (!st->has_s0) {
+        // 只有晚于请求时刻的样本，无法插值，保持该样本
+        if (st->has_s1) {
+            out.value = st->s1.value;
+            out.quality = SENSOR_RESAMPLE_HELD;
+        }
+        return out;
+    }
+
+    out.age = timestamp - st->s0.timestamp;
+
+    if (st->mode == SENSOR_RESAMPLE_LINEAR && st->has_s1) {
+        // v = v0 + (v1 - v0) * (t - t0) / (t1 - t0)，定点整数运算
+        span = st->s1.timestamp - st->s0.timestamp;
+        dt = out.age;
+        dv = (int32_t)st->s1.value - (int32_t)st->s0.value;
+        out.value = (uint16_t)((int32_t)st->s0.value +
+                               (int32_t)(((int64_t)dv * dt) / (span ? span : 1U)));
+        out.quality = SENSOR_RESAMPLE_INTERPOLATED;
+    } else {
+        out.value = st->s0.value;
+        out.quality = SENSOR_RESAMPLE_HELD;
+    }
+
+    if (st->max_age != 0 && out.age > st->max_age) {
+        out.quality = SENSOR_RESAMPLE_STALE;
+    }
+
+    return out;
+}
+
+/* ==================== 公共函数实现 ==================== */
+
+/**
+ * @brief 重采样器初始化函数
+ * @param rs 重采样器结构体指针
+ * @return 初始化状态，0表示成功，非0表示失败
+ */
+uint8_t sensor_resampler_init(sensor_resampler_t *rs) {
+    // 检查指针有效性
+    if (rs == NULL) {
+        return 1;
+    }
+
+    rs->stream_num = 0;
+
+    // 绑定函数指针（面向对象核心）
+    rs->sample = sensor_resampler_impl_sample;
+
+    return 0;
+}
+
+/**
+ * @brief 注册一路输入流
+ * @param rs      重采样器结构体指针
+ * @param pull    输入拉取函数
+ * @param ctx     拉取上下文
+ * @param mode    重采样方式
+ * @param max_age 最大时效（0表示不检查）
+ * @return 流编号，注册失败返回0xFF
+ */
+uint8_t sensor_resampler_add_stream(sensor_resampler_t *rs, sensor_resample_pull_fn pull,
+                                    void *ctx, sensor_resample_mode_t mode, uint32_t max_age) {
+    sensor_resample_stream_t *st;
+
+    if (rs == NULL || pull == NULL || rs->stream_num >= SENSOR_RESAMPLE_STREAM_MAX) {
+        return 0xFF;
+    }
+
+    st = &rs->streams[rs->stream_num];
+    *st = (sensor_resample_stream_t){0};
+    st->pull = pull;
+    st->ctx = ctx;
+    st->mode = mode;
+    st->max_age = max_age;
+
+    return rs->stream_num++;
+}
+
+/**
+ * @brief 一次获取所有流在同一时刻的对齐输出
+ * @param rs        重采样器结构体指针
+ * @param timestamp 请求时间戳（控制节拍时刻）
+ * @param out       输出数组（至少stream_num个）
+ * @return 输出有效（非NO_DATA且非STALE）的流数量
+ */
+uint8_t sensor_resampler_sample_all(sensor_resampler_t *rs, uint32_t timestamp,
+                                    sensor_resample_out_t *out) {
+    uint8_t valid = 0;
+    uint8_t i;
+
+    if (rs == NULL || out == NULL) {
+        return 0;
+    }
+
+    for (i = 0; i < rs->stream_num; i++) {
+        out[i] = rs->sample(rs, i, timestamp);
+        if (out[i].quality == SENSOR_RESAMPLE_INTERPOLATED ||
+            out[i].quality == SENSOR_RESAMPLE_HELD) {
+            valid++;
+        }
+    }
+
+    return valid;
+}
+
+/* ==================== 使用示例 ==================== */
+
+/*
+ * 使用示例：
+ *
+ * static sensor_resampler_t resampler;
+ * static sensor_sub_t imu_sub, baro_sub;    // 见sensor_pubsub_template.c
+ *
+ * static bool sub_pull(void *ctx, sensor_sample_t *s) {
+ *     sensor_sub_t *sub = (sensor_sub_t *)ctx;
+ *     return sub->read(sub, s) == SENSOR_SUB_OK;
+ * }
+ *
+ * void control_tick(uint32_t now) {
+ *     sensor_resample_out_t out[2];
+ *
+ *     // 控制节拍时刻略滞后于当前时间，保证大多数情况下可插值
+ *     sensor_resampler_sample_all(&resampler, now - CONTROL_DELAY_TICKS, out);
+ *     if (out[0].quality != SENSOR_RESAMPLE_STALE) {
+ *         // 使用对齐后的out[0].value与out[1].value做融合
+ *     }
+ * }
+ *
+ * int main(void) {
+ *     sensor_resampler_init(&resampler);
+ *     sensor_resampler_add_stream(&resampler, sub_pull, &imu_sub, SENSOR_RESAMPLE_LINEAR, 20);
+ *     sensor_resampler_add_stream(&resampler, sub_pull, &baro_sub, SENSOR_RESAMPLE_HOLD, 200);
+ * }
+ */
@@ -0,0 +1,334 @@
+/**
+ * @file sensor_validator_template.c
+ * @brief 传感器数据流异常值剔除模板文件
+ * @description 对sensor_get_data输出的数据流做量程检查、变化率限制和
+ *              基于中位数的Hampel异常检测，用替代值取代异常样本并分类计数；
+ *              窗口长度固定，每个样本的处理开销为O(1)
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* ==================== 宏定义 ==================== */
+
+#define SENSOR_VALID_WINDOW        7       // Hampel窗口长度（奇数）
+#define SENSOR_VALID_MAD_SCALE_Q8  380     // 1.4826 * 256，MAD到标准差的换算系数
+
+/* ==================== 类型定义 ==================== */
+
+/**
+ * @brief 样本判定结果枚举
+ */
+typedef enum {
+    SENSOR_VALID_PASS = 0,         /**< 样本正常 */
+    SENSOR_VALID_REJECT_RANGE,     /**< 超出量程 */
+    SENSOR_VALID_REJECT_RATE,      /**< 变化率超限 */
+    SENSOR_VALID_REJECT_OUTLIER    /**< Hampel检测为异常值 */
+} sensor_valid_result_t;
+
+/**
+ * @brief 校验配置结构体
+ */
+typedef struct {
+    uint16_t min_value;            /**< 量程下限 */
+    uint16_t max_value;            /**< 量程上限 */
+    uint16_t max_delta;            /**< 相邻样本最大变化量，0表示不检查 */
+    uint16_t hampel_k_q8;          /**< Hampel阈值倍数（Q8），0表示不检查 */
+    uint16_t min_threshold;        /**< Hampel最小阈值，避免MAD为0时误判 */
+    uint8_t max_consecutive;       /**< 连续剔除达到该次数后强制接受（跟随真实阶跃） */
+} sensor_valid_config_t;
+
+/**
+ * @brief 剔除统计结构体
+ */
+typedef struct {
+    uint32_t total;                /**< 处理样本总数 */
+    uint32_t range_rejects;        /**< 量程剔除数 */
+    uint32_t rate_rejects;         /**< 变化率剔除数 */
+    uint32_t outlier_rejects;      /**< 异常值剔除数 */
+    uint32_t forced_accepts;       /**< 连续剔除后强制接受次数 */
+    uint8_t max_consecutive;       /**< 最长连续剔除次数 */
+} sensor_valid_stats_t;
+
+/* === 前向声明 === */
+
+typedef struct sensor_validator_t sensor_validator_t;
+
+/* === 函数指针类型定义 === */
+
+/**
+ * @brief 样本校验函数指针类型
+ * @param value 输入样本，判为异常时被替换为替代值
+ */
+typedef sensor_valid_result_t (*sensor_validator_filter_fn)(sensor_validator_t *validator,
+                                                            uint16_t *value);
+
+/**
+ * @brief 传感器数据校验器结构体
+ * @note  window为按时间顺序的环形窗口，sorted为同一组数据的有序副本，
+ *        新样本进入时增量维护有序副本，中位数直接取中间元素
+ */
+struct sensor_validator_t {
+    /* 配置 */
+    sensor_valid_config_t config;              /**< 校验配置 */
+
+    /* 运行状态 */
+    uint16_t window[SENSOR_VALID_WINDOW];      /**< 时间顺序窗口 */
+    uint16_t sorted[SENSOR_VALID_WINDOW];      /**< 有序窗口 */
+    uint8_t fill;                              /**< 窗口已填充数量 */
+    uint8_t pos;                               /**< 最旧样本位置 */
+    uint16_t last_good;                        /**< 最近一个被接受的样本 */
+    uint8_t consecutive;                       /**< 当前连续剔除次数 */
+    sensor_valid_stats_t stats;                /**< 剔除统计 */
+
+    /* 函数指针 - 操作方法 */
+    sensor_validator_filter_fn filter;         /**< 校验并替换样本 */
+};
+
+/* ==================== 静态函数声明 ==================== */
+
+static sensor_valid_result_t sensor_validator_impl_filter(sensor_validator_t *validator,
+                                                          uint16_t *value);
+static void sensor_validator_push(sensor_validator_t *validator, uint16_t value);
+static uint16_t sensor_validator_mad(const sensor_validator_t *validator, uint16_t median);
+
+/* ==================== 静态函数实现 ==================== */
+
+/**
+ * @brief 将样本推入窗口并维护有序副本
+ * @param validator 校验器结构体指针
+ * @param value     新样本
+ * @note   删除最旧样本并插入新样本，移动次数不超过窗口长度
+ */
+static void sensor_validator_push(sensor_validator_t *validator, uint16_t value) {
+    uint16_t *sorted = validator->sorted;
+    uint8_t n = validator->fill;
+    uint8_t i;
+
+    if (n == SENSOR_VALID_WINDOW) {
+        // 从有序副本中删除最旧样本
+        uint16_t old = validator->window[validator->pos];
+        for (i = 0; i < n && sorted[i] != old; i++) {
+        }
+        for (; i + 1 < n; i++) {
+            sorted[i] = sorted[i + 1];
+        }
+        n--;
+    }
+
+    // 插入排序位置
+    for (i = n; i > 0 && sorted[i - 1] > value; i--) {
+        sorted[i] = sorted[i - 1];
+    }
+    sorted[i] = value;
+
+    validator->window[validator->pos] = value;
+    validator->pos = (uint8_t)((validator->pos + 1U) % SENSOR_VALID_WINDOW);
+    if (validator->fill < SENSOR_VALID_WINDOW) {
+        validator->fill++;
+    }
+}
+
+/**
+ * @brief 计算中位数绝对偏差（MAD）
+ * @param validator 校验器结构体指针
+ * @param median    窗口中位数
+ * @return MAD
+ * @note   有序数组中各元素到中位数的偏差从中位数向两侧单调递增，
+ *         双指针归并即可按序得到偏差，无需再次排序
+ */
+static uint16_t sensor_validator_mad(const sensor_validator_t *validator, uint16_t median) {
+    const uint16_t *sorted = validator->sorted;
+    int8_t lo = (int8_t)(validator->fill / 2) - 1;
+    int8_t hi = (int8_t)(validator->fill / 2);
+    uint16_t dev = 0;
+    uint8_t k;
+
+    // 取第(fill/2)小的偏差
+    for (k = 0; k <= validator->fill / 2; k++) {
+        if (lo < 0) {
+            dev = (uint16_t)(sorted[hi++] - median);
+        } else if (hi >= (int8_t)validator->fill) {
+            dev = (uint16_t)(median - sorted[lo--]);
+        } else if ((uint16_t)(median - sorted[lo]) < (uint16_t)(sorted[hi] - median)) {
+            dev = (uint16_t)(median - sorted[lo--]);
+        } else {
+            dev = (uint16_t)(sorted[hi++] - median);
+        }
+    }
+
+    return dev;
+}
+
+/**
+ * @brief 样本校验实现函数
+ * @param validator 校验器结构体指针
+ * @param value     样本指针，异常时被替换
+ * @return 判定结果
+ * @note   判定顺序：量程 → 变化率 → Hampel；窗口始终记录量程内的原始样本，
+ *         使真实阶跃在半个窗口后被中位数跟随
+ */
+static sensor_valid_result_t sensor_validator_impl_filter(sensor_validator_t *validator,
+                                                          uint16_t *value) {
+    const sensor_valid_config_t *cfg;
+    sensor_valid_result_t result = SENSOR_VALID_PASS;
+    uint16_t x;
+    uint16_t median = 0;
+    uint64_t threshold;
+    uint16_t dev;
+
+    if (validator == NULL || value == NULL) {
+        return SENSOR_VALID_REJECT_RANGE;
+    }
+
+    cfg = &validator->config;
+    x = *value;
+    validator->stats.total++;
+
+    if (x < cfg->min_value || x > cfg->max_value) {
+        result = SENSOR_VALID_REJECT_RANGE;
+    } else {
+        if (validator->fill > 0) {
+            median = validator->sorted[validator->fill / 2];
+        }
+
+        dev = (x > validator->last_good) ? (uint16_t)(x - validator->last_good)
+                                         : (uint16_t)(validator->last_good - x);
+        if (cfg->max_delta != 0 && validator->fill > 0 && dev > cfg->max_delta) {
+            result = SENSOR_VALID_REJECT_RATE;
+        } else if (cfg->hampel_k_q8 != 0 && validator->fill == SENSOR_VALID_WINDOW) {
+            // MAD×比例×k最大约2^41，按64位计算并饱和到偏差可取的最大值
+            threshold = ((uint64_t)sensor_validator_mad(validator, median) *
+                         SENSOR_VALID_MAD_SCALE_Q8 * cfg->hampel_k_q8) >> 16;
+            if (threshold > UINT16_MAX) {
+                threshold = UINT16_MAX;
+            }
+            if (threshold < cfg->min_threshold) {
+                threshold = cfg->min_threshold;
+            }
+            dev = (x > median) ? (uint16_t)(x - median) : (uint16_t)(median - x);
+            if (dev > threshold) {
+                result = SENSOR_VALID_REJECT_OUTLIER;
+            }
+        }
+
+        sensor_validator_push(validator, x);
+    }
+
+    if (result == SENSOR_VALID_PASS) {
+        validator->consecutive = 0;
+        validator->last_good = x;
+        return result;
+    }
+
+    // 连续剔除过多时视为真实变化，强制接受
+    validator->consecutive++;
+    if (validator->consecutive > validator->stats.max_consecutive) {
+        validator->stats.max_consecutive = validator->consecutive;
+    }
+    if (result != SENSOR_VALID_REJECT_RANGE && cfg->max_consecutive != 0 &&
+        validator->consecutive >= cfg->max_consecutive) {
+        validator->stats.forced_accepts++;
+        validator->consecutive = 0;
+        validator->last_good = x;
+        return SENSOR_VALID_PASS;
+    }
+
+    switch (result) {
+    case SENSOR_VALID_REJECT_RANGE:   validator->stats.range_rejects++;   break;
+    case SENSOR_VALID_REJECT_RATE:    validator->stats.rate_rejects++;    break;
+    default:                          validator->stats.outlier_rejects++; break;
+    }
+
+    // 以窗口中位数替代异常样本，窗口为空时沿用最近有效值
+    *value = (validator->fill > 0) ? validator->sorted[validator->fill / 2] : validator->last_good;
+
+    return result;
+}
+
+/* ==================== 公共函数实现 ==================== */
+
+/**
+ * @brief 校验器初始化函数
+ * @param validator 校验器结构体指针
+ * @param config    校验配置指针
+ * @return 初始化状态，0表示成功，非0表示失败
+ */
+uint8_t sensor_validator_init(sensor_validator_t *validator, const sensor_valid_config_t *config) {
+    // 检查指针有效性
+    if (validator == NULL || config == NULL || config->min_value > config->max_value) {
+        return 1;
+    }
+
+    validator->config = *config;
+    validator->fill = 0;
+    validator->pos = 0;
+    validator->last_good = config->min_value;
+    validator->consecutive = 0;
+    validator->stats = (sensor_valid_stats_t){0};
+
+    // 绑定函数指针（面向对象核心）
+    validator->filter = sensor_validator_impl_filter;
+
+    return 0;
+}
+
+/**
+ * @brief 获取剔除统计
+ * @param validator 校验器结构体指针
+ * @param stats     统计输出指针
+ * @param is_clear  读取后是否清零
+ * @return 获取状态，0表示成功，非0表示失败
+ */
+uint8_t sensor_validator_get_stats(sensor_validator_t *validator, sensor_valid_stats_t *stats,
+                                   bool is_clear) {
+    if (validator == NULL || stats == NULL) {
+        return 1;
+    }
+
+    *stats = validator->stats;
+    if (is_clear) {
+        validator->stats = (sensor_valid_stats_t){0};
+    }
+
+    return 0;
+}
+
+/* ==================== 使用示例 ==================== */
+
+/*
+ * 使用示例：
+ *
+ * static sensor_t imu;
+ * static sensor_validator_t imu_validator;
+ *
+ * static const sensor_valid_config_t imu_valid_cfg = {
+ *     .min_value = 100,
+ *     .max_value = 4000,
+ *     .max_delta = 500,
+ *     .hampel_k_q8 = 3 * 256,     // 3倍标准差
+ *     .min_threshold = 8,
+ *     .max_consecutive = 4,
+ * };
+ *
+ * void control_task(void) {
+ *     uint16_t value;
+ *
+ *     if (imu.get_data(&value) == SENSOR_STATUS_OK) {
+ *         imu_validator.filter(&imu_validator, &value);
+ *         // value已是有效值或替代值，可直接进入控制
+ *     }
+ * }
+ *
+ * void diag_task(void) {
+ *     sensor_valid_stats_t stats;
+ *     sensor_validator_get_stats(&imu_validator, &stats, true);
+ *     // 上报各类剔除计数
+ * }
+ *
+ * int main(void) {
+ *     sensor_init(&imu);
+ *     sensor_validator_init(&imu_validator, &imu_valid_cfg);
+ * }
+ */
@@ -0,0 +1,441 @@
+/**
+ * @file static_memory_template.c
+ * @brief 静态内存区与定长块内存池模板文件
+ * @description 落实CHECKLIST.md 5.3“避免频繁的动态内存分配”：所有缓冲区在编译期定尺寸，
+ *              启动期从静态内存区按对齐要求一次性划分，运行期的对象由类型化定长块内存池分配；
+ *              内存池分配与释放为O(1)无锁操作，可在中断中使用，并记录使用高水位
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+/* ==================== 宏定义 ==================== */
+
+#define MEM_CACHE_LINE             32      // 缓存行大小（字节），DMA缓冲区按此对齐
+#define MEM_POOL_BLOCK_MAX         0xFFFEU // 单个内存池最大块数（16位索引，0xFFFF为链表结束）
+#define MEM_POOL_NIL               0xFFFFU // 空闲链表结束标记
+
+// 向上对齐到align（align须为2的幂）
+#define MEM_ROUND_UP(size, align)  (((size) + (align) - 1U) & ~((size_t)(align) - 1U))
+
+// 单个内存池占用的存储字节数，用于编译期汇总内存预算
+#define MEM_POOL_BYTES(type, count, align)  ((count) * MEM_ROUND_UP(sizeof(type), (align)))
+
+/**
+ * @brief 定义静态内存区
+ * @param var   内存区对象名
+ * @param size  容量（字节）
+ * @param align 起始地址对齐
+ */
+#define MEM_ARENA_DEFINE(var, size, align)                              \
+    static _Alignas(align) uint8_t var##_storage[(size)];               \
+    mem_arena_t var = { .base = var##_storage, .size = (size) }
+
+/**
+ * @brief 定义类型化定长块内存池
+ * @param var   内存池对象名
+ * @param type  块类型，块大小为sizeof(type)向上对齐到align
+ * @param count 块数量
+ * @param align 块对齐（DMA缓冲区可取MEM_CACHE_LINE）
+ */
+#define MEM_POOL_DEFINE(var, type, count, align)                        \
+    _Static_assert((count) > 0 && (count) <= MEM_POOL_BLOCK_MAX,        \
+                   #var " block count out of range");                   \
+    static _Alignas(align) uint8_t                                      \
+        var##_storage[MEM_POOL_BYTES(type, count, align)];              \
+    static atomic_uint_least16_t var##_next[(count)];                   \
+    static atomic_bool var##_allocated[(count)];                        \
+    mem_pool_t var = {                                                  \
+        .name = #var,                                                   \
+        .storage = var##_storage,                                       \
+        .next = var##_next,                                             \
+        .allocated = var##_allocated,                                   \
+        .block_size = MEM_ROUND_UP(sizeof(type), (align)),              \
+        .block_num = (count),                                           \
+    }
+
+// 类型化分配，返回值无需强制转换
+#define MEM_POOL_ALLOC(pool, type) ((type *)(pool).alloc(&(pool)))
+
+/* ==================== 类型定义 ==================== */
+
+/**
+ * @brief 内存池统计结构体
+ */
+typedef struct {
+    uint16_t block_num;            /**< 块总数 */
+    uint16_t in_use;               /**< 当前已分配块数 */
+    uint16_t high_water;           /**< 已分配块数峰值 */
+    uint32_t alloc_fails;          /**< 分配失败次数 */
+    uint32_t free_errors;          /**< 非法释放次数（含重复释放） */
+} mem_pool_stats_t;
+
+/* === 前向声明 === */
+
+typedef struct mem_arena_t mem_arena_t;
+typedef struct mem_pool_t mem_pool_t;
+
+/* === 函数指针类型定义 === */
+
+/**
+ * @brief 内存池分配函数指针类型
+ */
+typedef void *(*mem_pool_alloc_fn)(mem_pool_t *pool);
+
+/**
+ * @brief 内存池释放函数指针类型
+ */
+typedef uint8_t (*mem_pool_free_fn)(mem_pool_t *pool, void *block);
+
+/**
+ * @brief 静态内存区结构体
+ * @note  只分配不释放，用于启动期一次性划分环形缓冲区、跟踪缓冲区、查找表等
+ */
+struct mem_arena_t {
+    uint8_t *base;                 /**< 存储区起始地址 */
+    size_t size;                   /**< 容量（字节） */
+    atomic_size_t used;            /**< 已使用字节数（含对齐填充） */
+};
+
+/**
+ * @brief 定长块内存池结构体
+ * @note  空闲链表头为“16位标签 + 16位块索引”，每次修改标签加一，避免ABA问题；
+ *        链表指针与块分配标志保存在独立数组中，块内容不被内存池改写
+ */
+struct mem_pool_t {
+    /* 配置（由MEM_POOL_DEFINE在编译期填写） */
+    const char *name;                      /**< 内存池名称 */
+    uint8_t *storage;                      /**< 块存储区 */
+    atomic_uint_least16_t *next;           /**< 空闲链表指针数组 */
+    atomic_bool *allocated;                /**< 块分配标志数组（释放时以CAS清除，拦截重复释放） */
+    size_t block_size;                     /**< 块大小（已对齐） */
+    uint16_t block_num;                    /**< 块数量 */
+
+    /* 运行状态 */
+    atomic_uint_least32_t free_head;       /**< 空闲链表头（标签 << 16 | 索引） */
+    atomic_uint_least16_t in_use;          /**< 当前已分配块数 */
+    atomic_uint_least16_t high_water;      /**< 已分配块数峰值 */
+    atomic_uint_least32_t alloc_fails;     /**< 分配失败次数 */
+    atomic_uint_least32_t free_errors;     /**< 非法释放次数（含重复释放） */
+
+    /* 函数指针 - 操作方法 */
+    mem_pool_alloc_fn alloc;               /**< 分配一个块 */
+    mem_pool_free_fn free;                 /**< 释放一个块 */
+};
+
+/* ==================== 静态函数声明 ==================== */
+
+static void *mem_pool_impl_alloc(mem_pool_t *pool);
+static uint8_t mem_pool_impl_free(mem_pool_t *pool, void *block);
+
+/* ==================== 静态函数实现 ==================== */
+
+/**
+ * @brief 内存池分配实现函数
+ * @param pool 内存池结构体指针
+ * @return 块指针，内存池耗尽返回NULL
+ * @note   单次CAS弹出空闲链表头，无锁、可在中断中调用
+ */
+static void *mem_pool_impl_alloc(mem_pool_t *pool) {
+    uint32_t head;
+    uint32_t next_head;
+    uint16_t index;
+    uint16_t used;
+    uint16_t peak;
+
+    head = atomic_load_explicit(&pool->free_head, memory_order_acquire);
+    do {
+        index = (uint16_t)(head & 0xFFFFU);
+        if (index == MEM_POOL_NIL) {
+            atomic_fetch_add_explicit(&pool->alloc_fails, 1, memory_order_relaxed);
+            return NULL;
+        }
+        next_head = ((head + 0x10000UL) & 0xFFFF0000UL) |
+                    atomic_load_explicit(&pool->next[index], memory_order_relaxed);
+    } while (!atomic_compare_exchange_weak_explicit(&pool->free_head, &head, next_head,
+                                                    memory_order_acquire,
+                                                    memory_order_acquire));
+    atomic_store_explicit(&pool->allocated[index], true, memory_order_relaxed);
+
+    // 更新使用计数与高水位
+    used = (uint16_t)(atomic_fetch_add_explicit(&pool->in_use, 1, memory_order_relaxed) + 1U);
+    peak = atomic_load_explicit(&pool->high_water, memory_order_relaxed);
+    while (used > peak &&
+           !atomic_compare_exchange_weak_explicit(&pool->high_water, &peak, used,
+                                                  memory_order_relaxed,
+                                                  memory_order_relaxed)) {
+    }
+
+    return &pool->storage[(size_t)index * pool->block_size];
+}
+
+/**
+ * @brief 内存池释放实现函数
+ * @param pool  内存池结构体指针
+ * @param block 块指针
+ * @return 释放状态，0表示成功，非0表示指针不属于本内存池或块未处于已分配状态
+ * @note   先以CAS将块分配标志由true改为false，重复或并发释放时只有一方成功，
+ *         其余计入free_errors，块不会被两次压入空闲链表；随后单次CAS压入空闲链表头，
+ *         无锁、可在中断中调用
+ */
+static uint8_t mem_pool_impl_free(mem_pool_t *pool, void *block) {
+    uintptr_t offset;
+    uint32_t head;
+    uint32_t new_head;
+    uint16_t index;
+    bool expected = true;
+
+    offset = (uintptr_t)block - (uintptr_t)pool->storage;
+    if (block == NULL || (uintptr_t)block < (uintptr_t)pool->storage ||
+        offset >= (uintptr_t)pool->block_num * pool->block_size ||
+        offset % pool->block_size != 0) {
+        atomic_fetch_add_explicit(&pool->free_errors, 1, memory_order_relaxed);
+        return 1;
+    }
+    index = (uint16_t)(offset / pool->block_size);
+    if (!atomic_compare_exchange_strong_explicit(&pool->allocated[index], &expected, false,
+                                                 memory_order_relaxed, memory_order_relaxed)) {
+        atomic_fetch_add_explicit(&pool->free_errors, 1, memory_order_relaxed);
+        return 1;
+    }
+
+    head = atomic_load_explicit(&pool->free_head, memory_order_relaxed);
+    do {
+        atomic_store_explicit(&pool->next[index], (uint16_t)(head & 0xFFFFU),
+                              memory_order_relaxed);
+        new_head = ((head + 0x10000UL) & 0xFFFF0000UL) | index;
+    } while (!atomic_compare_exchange_weak_explicit(&pool->free_head, &head, new_head,
+                                                    memory_order_release,
+                                                    memory_order_relaxed));
+
+    atomic_fetch_sub_explicit(&pool->in_use, 1, memory_order_relaxed);
+    return 0;
+}
+
+/* ==================== 公共函数实现 ==================== */
+
+/**
+ * @brief 从静态内存区分配
+ * @param arena 内存区结构体指针
+ * @param size  字节数
+ * @param align 对齐（2的幂，DMA缓冲区取MEM_CACHE_LINE）
+ * @return 分配地址，容量不足返回NULL
+ * @note   CAS推进已用指针，无锁；内存区不支持单独释放
+ */
+void *mem_arena_alloc(mem_arena_t *arena, size_t size, size_t align) {
+    size_t used;
+    size_t start;
+    uintptr_t addr;
+
+    if (arena == NULL || size == 0 || align == 0 || (align & (align - 1U)) != 0) {
+        return NULL;
+    }
+
+    used = atomic_load_explicit(&arena->used, memory_order_relaxed);
+    do {
+        // 按实际地址对齐，与存储区自身的对齐无关
+        addr = MEM_ROUND_UP((uintptr_t)arena->base + used, align);
+        start = (size_t)(addr - (uintptr_t)arena->base);
+        if (start > arena->size || size > arena->size - start) {
+            return NULL;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&arena->used, &used, start + size,
+                                                    memory_order_relaxed,
+                                                    memory_order_relaxed));
+
+    return &arena->base[start];
+}
+
+/**
+ * @brief 获取静态内存区使用量
+ * @param arena 内存区结构体指针
+ * @return 已使用字节数（只增不减，即内存区高水位）
+ */
+size_t mem_arena_used(mem_arena_t *arena) {
+    if (arena == NULL) {
+        return 0;
+    }
+    return atomic_load_explicit(&arena->used, memory_order_relaxed);
+}
+
+/**
+ * @brief 内存池初始化函数
+ * @param pool 由MEM_POOL_DEFINE定义的内存池指针
+ * @return 初始化状态，0表示成功，非0表示失败
+ * @note   启动期调用一次，将全部块串入空闲链表
+ */
+uint8_t mem_pool_init(mem_pool_t *pool) {
+    uint16_t i;
+
+    // 检查指针有效性
+    if (pool == NULL || pool->storage == NULL || pool->next == NULL || pool->allocated == NULL ||
+        pool->block_num == 0) {
+        return 1;
+    }
+
+    for (i = 0; i < pool->block_num; i++) {
+        atomic_init(&pool->next[i], (uint16_t)((i + 1U < pool->block_num) ? i + 1U : MEM_POOL_NIL));
+        atomic_init(&pool->allocated[i], false);
+    }
+    atomic_init(&pool->free_head, 0);
+    atomic_init(&pool->in_use, 0);
+    atomic_init(&pool->high_water, 0);
+    atomic_init(&pool->alloc_fails, 0);
+    atomic_init(&pool->free_errors, 0);
+
+    // 绑定函数指针（面向对象核心）
+    pool->alloc = mem_pool_impl_alloc;
+    pool->free = mem_pool_impl_free;
+
+    return 0;
+}
+
+/**
+ * @brief 获取内存池统计
+ * @param pool  内存池结构体指针
+ * @param stats 统计输出指针
+ * @return 获取状态，0表示成功，非0表示失败
+ */
+uint8_t mem_pool_get_stats(mem_pool_t *pool, mem_pool_stats_t *stats) {
+    if (pool == NULL || stats == NULL) {
+        return 1;
+    }
+
+    stats->block_num = pool->block_num;
+    stats->in_use = atomic_load_explicit(&pool->in_use, memory_order_relaxed);
+    stats->high_water = atomic_load_explicit(&pool->high_water, memory_order_relaxed);
+    stats->alloc_fails = atomic_load_explicit(&pool->alloc_fails, memory_order_relaxed);
+    stats->free_errors = atomic_load_explicit(&pool->free_errors, memory_order_relaxed);
+
+    return 0;
+}
+
+/* ==================== 主机基准测试 ==================== */
+
+#ifdef MEM_BENCH_POSIX
+
+#include <stdlib.h>
+#include <time.h>
+
+#define MEM_BENCH_DEPTH            16      // 每轮同时持有的块数
+
+/**
+ * @brief 基准测试块类型（与电机命令大小相当）
+ */
+typedef struct {
+    uint32_t words[6];             /**< 负载 */
+} mem_bench_block_t;
+
+MEM_POOL_DEFINE(mem_bench_pool, mem_bench_block_t, MEM_BENCH_DEPTH, 8);
+
+/**
+ * @brief 基准测试结果结构体
+ */
+typedef struct {
+    double pool_ns;                /**< 内存池单次分配+释放耗时（纳秒） */
+    double malloc_ns;              /**< malloc单次分配+释放耗时（纳秒） */
+} mem_bench_result_t;
+
+/**
+ * @brief 计算两个时刻之间的纳秒数
+ */
+static double mem_bench_elapsed_ns(const struct timespec *t0, const struct timespec *t1) {
+    return (double)(t1->tv_sec - t0->tv_sec) * 1e9 + (double)(t1->tv_nsec - t0->tv_nsec);
+}
+
+/**
+ * @brief 内存池与malloc对比基准
+ * @param rounds 轮数，每轮分配MEM_BENCH_DEPTH个块后全部释放
+ * @return 两种方式单次分配+释放的平均耗时
+ */
+mem_bench_result_t mem_bench_run(uint32_t rounds) {
+    void *blocks[MEM_BENCH_DEPTH];
+    volatile uintptr_t sink = 0;
+    mem_bench_result_t result = {0};
+    struct timespec t0, t1;
+    uint32_t r;
+    uint8_t i;
+
+    if (rounds == 0 || mem_pool_init(&mem_bench_pool) != 0) {
+        return result;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (r = 0; r < rounds; r++) {
+        for (i = 0; i < MEM_BENCH_DEPTH; i++) {
+            blocks[i] = MEM_POOL_ALLOC(mem_bench_pool, mem_bench_block_t);
+            sink += (uintptr_t)blocks[i];
+        }
+        for (i = 0; i < MEM_BENCH_DEPTH; i++) {
+            mem_bench_pool.free(&mem_bench_pool, blocks[i]);
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    result.pool_ns = mem_bench_elapsed_ns(&t0, &t1) / ((double)rounds * MEM_BENCH_DEPTH);
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (r = 0; r < rounds; r++) {
+        for (i = 0; i < MEM_BENCH_DEPTH; i++) {
+            blocks[i] = malloc(sizeof(mem_bench_block_t));
+            sink += (uintptr_t)blocks[i];
+        }
+        for (i = 0; i < MEM_BENCH_DEPTH; i++) {
+            free(blocks[i]);
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    result.malloc_ns = mem_bench_elapsed_ns(&t0, &t1) / ((double)rounds * MEM_BENCH_DEPTH);
+
+    (void)sink;
+    return result;
+}
+
+#endif /* MEM_BENCH_POSIX */
+
+/* ==================== 使用示例 ==================== */
+
+/*
+ * 使用示例：
+ *
+ * // 板级内存预算：全部缓冲区在此集中定义，超出预算时编译失败
+ * #define MEM_BUDGET_BYTES  (24 * 1024)
+ *
+ * MEM_ARENA_DEFINE(board_arena, 16 * 1024, MEM_CACHE_LINE);          // 启动期划分
+ * MEM_POOL_DEFINE(cmd_pool, motor_cmd_t, 32, 8);                     // 运行期对象
+ * MEM_POOL_DEFINE(dma_pool, sensor_dma_frame_t, 8, MEM_CACHE_LINE);  // DMA帧
+ *
+ * _Static_assert(16 * 1024 +
+ *                MEM_POOL_BYTES(motor_cmd_t, 32, 8) +
+ *                MEM_POOL_BYTES(sensor_dma_frame_t, 8, MEM_CACHE_LINE) <= MEM_BUDGET_BYTES,
+ *                "static memory budget exceeded");
+ *
+ * int main(void) {
+ *     // 启动期：从内存区划分环形缓冲区与查找表
+ *     uint8_t *trace_buf = mem_arena_alloc(&board_arena, 4096, 4);
+ *     uint8_t *dma_rx = mem_arena_alloc(&board_arena, 512, MEM_CACHE_LINE);
+ *
+ *     mem_pool_init(&cmd_pool);
+ *     mem_pool_init(&dma_pool);
+ * }
+ *
+ * void DMA_IRQHandler(void) {
+ *     // 中断中O(1)无锁分配，耗尽时返回NULL
+ *     sensor_dma_frame_t *frame = MEM_POOL_ALLOC(dma_pool, sensor_dma_frame_t);
+ *     if (frame != NULL) {
+ *         // 填充后交给任务处理，任务处理完调用 dma_pool.free(&dma_pool, frame)
+ *     }
+ * }
+ *
+ * void diag_task(void) {
+ *     mem_pool_stats_t stats;
+ *     mem_pool_get_stats(&dma_pool, &stats);
+ *     // stats.high_water 用于回调MEM_POOL_DEFINE中的块数
+ *     // mem_arena_used(&board_arena) 用于回调内存区容量
+ * }
+ *
+ * 主机基准（Linux）：
+ *   gcc -DMEM_BENCH_POSIX -O2 -c static_memory_template.c
+ *   在测试程序中调用 mem_bench_run(1000000)，比较 pool_ns 与 malloc_ns
+ */
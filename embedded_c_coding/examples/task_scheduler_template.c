@@ -0,0 +1,503 @@
+/**
+ * @file task_scheduler_template.c
+ * @brief 协作式优先级任务调度器模板文件
+ * @description 为传感器轮询、遥测、校准与参数整定等后台工作提供无动态分配的调度器：
+ *              支持周期任务与事件触发任务、优先级调度（就绪位图O(1)选择）、
+ *              单任务时间预算与超时统计；定义SCHED_PORT_POSIX后可在Linux主机上运行测试与基准
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+/* ==================== 宏定义 ==================== */
+
+#define SCHED_PRIO_NUM             32      // 优先级数量，数值越大优先级越高
+#define SCHED_TASK_MAX             32      // 最大任务数（受事件位图宽度限制）
+
+/* ==================== 类型定义 ==================== */
+
+/**
+ * @brief 调度器错误码枚举
+ */
+typedef enum {
+    SCHED_OK = 0,                  /**< 成功 */
+    SCHED_ERROR_NULL_PTR,          /**< 空指针错误 */
+    SCHED_ERROR_INVALID_PARAM,     /**< 无效参数 */
+    SCHED_ERROR_FULL,              /**< 任务表已满 */
+    SCHED_ERROR_NOT_ADDED          /**< 任务未添加到调度器 */
+} sched_error_t;
+
+/**
+ * @brief 任务运行统计结构体
+ */
+typedef struct {
+    uint32_t runs;                 /**< 执行次数 */
+    uint32_t overruns;             /**< 超出时间预算次数 */
+    uint32_t missed_releases;      /**< 周期任务错过的释放次数 */
+    uint32_t exec_max_us;          /**< 最长执行时间（微秒） */
+    uint32_t exec_last_us;         /**< 最近一次执行时间（微秒） */
+    uint64_t exec_total_us;        /**< 累计执行时间（微秒） */
+} sched_task_stats_t;
+
+/* === 前向声明 === */
+
+typedef struct sched_task_t sched_task_t;
+typedef struct sched_t sched_t;
+
+/* === 函数指针类型定义 === */
+
+/**
+ * @brief 任务入口函数指针类型
+ */
+typedef void (*sched_task_fn)(sched_task_t *task, void *arg);
+
+/**
+ * @brief 获取微秒时间函数指针类型（平台移植接口）
+ */
+typedef uint32_t (*sched_port_get_time_us_fn)(void);
+
+/**
+ * @brief 空闲处理函数指针类型（平台移植接口，如WFI或主机休眠）
+ */
+typedef void (*sched_port_idle_fn)(uint32_t idle_us);
+
+/**
+ * @brief 添加任务函数指针类型
+ */
+typedef sched_error_t (*sched_add_fn)(sched_t *sched, sched_task_t *task);
+
+/**
+ * @brief 单步调度函数指针类型
+ */
+typedef bool (*sched_run_once_fn)(sched_t *sched);
+
+/**
+ * @brief 任务控制块结构体
+ * @note  由应用静态定义，调度器不做任何动态分配
+ */
+struct sched_task_t {
+    /* 任务配置 */
+    const char *name;              /**< 任务名称 */
+    sched_task_fn run;             /**< 任务入口 */
+    void *arg;                     /**< 任务参数 */
+    uint8_t prio;                  /**< 优先级（0~SCHED_PRIO_NUM-1） */
+    uint32_t period_us;            /**< 周期（微秒），0表示仅事件触发 */
+    uint32_t budget_us;            /**< 单次执行时间预算（微秒），0表示不检查 */
+
+    /* 运行状态 */
+    uint32_t next_release_us;      /**< 下次释放时刻 */
+    uint8_t index;                 /**< 在任务表中的位置 */
+    bool is_ready;                 /**< 已在就绪队列中 */
+    sched_task_t *next;            /**< 同优先级就绪链表 */
+    sched_task_stats_t stats;      /**< 运行统计 */
+};
+
+/**
+ * @brief 调度器结构体
+ */
+struct sched_t {
+    /* 平台移植接口 */
+    sched_port_get_time_us_fn get_time_us;  /**< 获取时间 */
+    sched_port_idle_fn idle;                /**< 空闲处理 */
+
+    /* 运行状态 */
+    sched_task_t *tasks[SCHED_TASK_MAX];    /**< 任务表 */
+    uint8_t task_num;                       /**< 任务数量 */
+    uint32_t ready_bitmap;                  /**< 就绪优先级位图 */
+    sched_task_t *ready_head[SCHED_PRIO_NUM];  /**< 各优先级就绪链表头 */
+    sched_task_t *ready_tail[SCHED_PRIO_NUM];  /**< 各优先级就绪链表尾 */
+    atomic_uint_least32_t signal_bitmap;    /**< 事件触发位图（按任务序号，中断中置位） */
+    uint32_t busy_us;                       /**< 累计任务执行时间 */
+    uint32_t idle_us;                       /**< 累计空闲时间 */
+
+    /* 函数指针 - 操作方法 */
+    sched_add_fn add;                       /**< 添加任务 */
+    sched_run_once_fn run_once;             /**< 单步调度 */
+};
+
+/* ==================== 静态函数声明 ==================== */
+
+static sched_error_t sched_impl_add(sched_t *sched, sched_task_t *task);
+static bool sched_impl_run_once(sched_t *sched);
+static void sched_make_ready(sched_t *sched, sched_task_t *task);
+static sched_task_t *sched_pop_highest(sched_t *sched);
+static void sched_release(sched_t *sched, uint32_t now);
+
+/* ==================== 静态函数实现 ==================== */
+
+/**
+ * @brief 将任务加入对应优先级的就绪链表尾部
+ * @param sched 调度器结构体指针
+ * @param task  任务指针
+ */
+static void sched_make_ready(sched_t *sched, sched_task_t *task) {
+    if (task->is_ready) {
+        return;
+    }
+
+    task->is_ready = true;
+    task->next = NULL;
+    if (sched->ready_tail[task->prio] == NULL) {
+        sched->ready_head[task->prio] = task;
+    } else {
+        sched->ready_tail[task->prio]->next = task;
+    }
+    sched->ready_tail[task->prio] = task;
+    sched->ready_bitmap |= 1UL << task->prio;
+}
+
+/**
+ * @brief 取出最高优先级的就绪任务
+ * @param sched 调度器结构体指针
+ * @return 任务指针，无就绪任务返回NULL
+ * @note   通过前导零计数直接定位最高优先级，与任务数量无关
+ */
+static sched_task_t *sched_pop_highest(sched_t *sched) {
+    sched_task_t *task;
+    uint8_t prio;
+
+    if (sched->ready_bitmap == 0) {
+        return NULL;
+    }
+
+    prio = (uint8_t)(31 - __builtin_clz(sched->ready_bitmap));
+    task = sched->ready_head[prio];
+    sched->ready_head[prio] = task->next;
+    if (task->next == NULL) {
+        sched->ready_tail[prio] = NULL;
+        sched->ready_bitmap &= ~(1UL << prio);
+    }
+
+    task->next = NULL;
+    task->is_ready = false;
+    return task;
+}
+
+/**
+ * @brief 释放到期的周期任务与已触发的事件任务
+ * @param sched 调度器结构体指针
+ * @param now   当前时间（微秒）
+ */
+static void sched_release(sched_t *sched, uint32_t now) {
+    sched_task_t *task;
+    uint32_t signals;
+    uint32_t late;
+    uint8_t i;
+
+    // 一次性取走中断中置位的事件
+    signals = atomic_exchange_explicit(&sched->signal_bitmap, 0, memory_order_acquire);
+    while (signals != 0) {
+        i = (uint8_t)__builtin_ctz(signals);
+        signals &= signals - 1U;
+        sched_make_ready(sched, sched->tasks[i]);
+    }
+
+    for (i = 0; i < sched->task_num; i++) {
+        task = sched->tasks[i];
+        if (task->period_us == 0 || (int32_t)(now - task->next_release_us) < 0) {
+            continue;
+        }
+
+        sched_make_ready(sched, task);
+
+        // 按固定节拍推进释放时刻，落后超过一个周期时重新对齐并计数
+        late = now - task->next_release_us;
+        if (late >= task->period_us) {
+            task->stats.missed_releases += late / task->period_us;
+            task->next_release_us = now + task->period_us;
+        } else {
+            task->next_release_us += task->period_us;
+        }
+    }
+}
+
+/**
+ * @brief 添加任务实现函数
+ * @param sched 调度器结构体指针
+ * @param task  任务指针
+ * @return 错误码
+ */
+static sched_error_t sched_impl_add(sched_t *sched, sched_task_t *task) {
+    if (sched == NULL || task == NULL || task->run == NULL) {
+        return SCHED_ERROR_NULL_PTR;
+    }
+    if (task->prio >= SCHED_PRIO_NUM) {
+        return SCHED_ERROR_INVALID_PARAM;
+    }
+    if (sched->task_num >= SCHED_TASK_MAX) {
+        return SCHED_ERROR_FULL;
+    }
+
+    task->index = sched->task_num;
+    task->is_ready = false;
+    task->next = NULL;
+    task->next_release_us = sched->get_time_us() + task->period_us;
+    task->stats = (sched_task_stats_t){0};
+    sched->tasks[sched->task_num++] = task;
+
+    return SCHED_OK;
+}
+
+/**
+ * @brief 单步调度实现函数
+ * @param sched 调度器结构体指针
+ * @return true执行了一个任务，false当前无就绪任务
+ * @note   协作式调度：任务运行至返回，随后统计执行时间并检查预算；
+ *         执行时间从释放与出队之后开始计，不含调度器自身开销
+ */
+static bool sched_impl_run_once(sched_t *sched) {
+    sched_task_t *task;
+    uint32_t start;
+    uint32_t exec;
+
+    sched_release(sched, sched->get_time_us());
+
+    task = sched_pop_highest(sched);
+    if (task == NULL) {
+        return false;
+    }
+
+    start = sched->get_time_us();
+    task->run(task, task->arg);
+    exec = sched->get_time_us() - start;
+
+    task->stats.runs++;
+    task->stats.exec_last_us = exec;
+    task->stats.exec_total_us += exec;
+    if (exec > task->stats.exec_max_us) {
+        task->stats.exec_max_us = exec;
+    }
+    if (task->budget_us != 0 && exec > task->budget_us) {
+        task->stats.overruns++;
+    }
+    sched->busy_us += exec;
+
+    return true;
+}
+
+/* ==================== 公共函数实现 ==================== */
+
+/**
+ * @brief 调度器初始化函数
+ * @param sched       调度器结构体指针
+ * @param get_time_us 获取微秒时间的平台函数
+ * @param idle        空闲处理平台函数（可为NULL）
+ * @return 错误码
+ */
+sched_error_t sched_init(sched_t *sched, sched_port_get_time_us_fn get_time_us,
+                         sched_port_idle_fn idle) {
+    uint8_t i;
+
+    // 检查指针有效性
+    if (sched == NULL || get_time_us == NULL) {
+        return SCHED_ERROR_NULL_PTR;
+    }
+
+    sched->get_time_us = get_time_us;
+    sched->idle = idle;
+    sched->task_num = 0;
+    sched->ready_bitmap = 0;
+    for (i = 0; i < SCHED_PRIO_NUM; i++) {
+        sched->ready_head[i] = NULL;
+        sched->ready_tail[i] = NULL;
+    }
+    atomic_init(&sched->signal_bitmap, 0);
+    sched->busy_us = 0;
+    sched->idle_us = 0;
+
+    // 绑定函数指针（面向对象核心）
+    sched->add = sched_impl_add;
+    sched->run_once = sched_impl_run_once;
+
+    return SCHED_OK;
+}
+
+/**
+ * @brief 触发事件任务
+ * @param sched 调度器结构体指针
+ * @param task  任务指针
+ * @return 错误码，任务未添加到该调度器时返回SCHED_ERROR_NOT_ADDED
+ * @note   单次原子或操作，可在中断中调用；任务在下次调度时进入就绪队列
+ */
+sched_error_t sched_signal(sched_t *sched, sched_task_t *task) {
+    if (sched == NULL || task == NULL) {
+        return SCHED_ERROR_NULL_PTR;
+    }
+    // 未添加的任务序号无效，置位会释放任务表中的其他任务或越界
+    if (task->index >= sched->task_num || sched->tasks[task->index] != task) {
+        return SCHED_ERROR_NOT_ADDED;
+    }
+    atomic_fetch_or_explicit(&sched->signal_bitmap, 1UL << task->index, memory_order_release);
+    return SCHED_OK;
+}
+
+/**
+ * @brief 计算距下一个周期释放的时间
+ * @param sched 调度器结构体指针
+ * @return 距下一次释放的微秒数，无周期任务时返回UINT32_MAX
+ */
+uint32_t sched_next_release_in(const sched_t *sched) {
+    uint32_t now;
+    uint32_t min = UINT32_MAX;
+    int32_t delta;
+    uint8_t i;
+
+    if (sched == NULL) {
+        return UINT32_MAX;
+    }
+
+    now = sched->get_time_us();
+    for (i = 0; i < sched->task_num; i++) {
+        if (sched->tasks[i]->period_us == 0) {
+            continue;
+        }
+        delta = (int32_t)(sched->tasks[i]->next_release_us - now);
+        if (delta <= 0) {
+            return 0;
+        }
+        if ((uint32_t)delta < min) {
+            min = (uint32_t)delta;
+        }
+    }
+    return min;
+}
+
+/**
+ * @brief 调度主循环（超级循环替代）
+ * @param sched 调度器结构体指针
+ * @note   不返回；无就绪任务时调用平台空闲函数
+ */
+void sched_run(sched_t *sched) {
+    uint32_t wait;
+    uint32_t t0;
+
+    if (sched == NULL) {
+        return;
+    }
+
+    while (1) {
+        if (sched->run_once(sched)) {
+            continue;
+        }
+        if (atomic_load_explicit(&sched->signal_bitmap, memory_order_relaxed) != 0) {
+            continue;
+        }
+        wait = sched_next_release_in(sched);
+        if (wait != 0 && sched->idle != NULL) {
+            t0 = sched->get_time_us();
+            sched->idle(wait);
+            sched->idle_us += sched->get_time_us() - t0;
+        }
+    }
+}
+
+/* ==================== 主机移植层（测试与基准） ==================== */
+
+#ifdef SCHED_PORT_POSIX
+
+#include <time.h>
+
+/**
+ * @brief 主机端获取微秒时间
+ * @return 单调时钟微秒数
+ */
+uint32_t sched_posix_get_time_us(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000U);
+}
+
+/**
+ * @brief 主机端空闲处理
+ * @param idle_us 可空闲的微秒数
+ * @note   限制单次休眠时长，使中断模拟线程置位的事件能及时被处理
+ */
+void sched_posix_idle(uint32_t idle_us) {
+    struct timespec ts;
+
+    if (idle_us > 1000U) {
+        idle_us = 1000U;
+    }
+    ts.tv_sec = 0;
+    ts.tv_nsec = (long)idle_us * 1000L;
+    nanosleep(&ts, NULL);
+}
+
+/**
+ * @brief 基准测试空任务
+ * @param task 任务指针
+ * @param arg  未使用
+ */
+static void sched_bench_task(sched_task_t *task, void *arg) {
+    (void)task;
+    (void)arg;
+}
+
+/**
+ * @brief 调度开销基准测试
+ * @param iterations 调度次数
+ * @return 每次“触发事件 + 选择 + 派发”的平均耗时（纳秒）
+ */
+double sched_posix_bench(uint32_t iterations) {
+    static sched_task_t tasks[SCHED_TASK_MAX];
+    sched_t sched;
+    struct timespec t0, t1;
+    uint32_t i;
+
+    sched_init(&sched, sched_posix_get_time_us, sched_posix_idle);
+    for (i = 0; i < SCHED_TASK_MAX; i++) {
+        tasks[i] = (sched_task_t){ .name = "bench", .run = sched_bench_task,
+                                   .prio = (uint8_t)(i % SCHED_PRIO_NUM) };
+        sched.add(&sched, &tasks[i]);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (i = 0; i < iterations; i++) {
+        sched_signal(&sched, &tasks[i % SCHED_TASK_MAX]);
+        sched.run_once(&sched);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    return ((double)(t1.tv_sec - t0.tv_sec) * 1e9 + (double)(t1.tv_nsec - t0.tv_nsec)) /
+           (double)iterations;
+}
+
+#endif /* SCHED_PORT_POSIX */
+
+/* ==================== 使用示例 ==================== */
+
+/*
+ * 使用示例：
+ *
+ * static sched_t sched;
+ *
+ * static void sensor_poll_run(sched_task_t *task, void *arg) { imu_topic.poll(&imu_topic, get_tick()); }
+ * static void telemetry_run(sched_task_t *task, void *arg)   { telemetry_send(); }
+ * static void calib_run(sched_task_t *task, void *arg)       { calib_update(); }
+ *
+ * static sched_task_t sensor_task = { .name = "sensor", .run = sensor_poll_run,
+ *                                     .prio = 20, .period_us = 1000, .budget_us = 200 };
+ * static sched_task_t telem_task  = { .name = "telem", .run = telemetry_run,
+ *                                     .prio = 5, .period_us = 100000, .budget_us = 2000 };
+ * static sched_task_t calib_task  = { .name = "calib", .run = calib_run,
+ *                                     .prio = 10, .budget_us = 500 };    // 事件触发
+ *
+ * void DMA_IRQHandler(void) {
+ *     sched_signal(&sched, &calib_task);
+ * }
+ *
+ * int main(void) {
+ *     sched_init(&sched, board_get_time_us, board_wfi);
+ *     sched.add(&sched, &sensor_task);
+ *     sched.add(&sched, &telem_task);
+ *     sched.add(&sched, &calib_task);
+ *     sched_run(&sched);    // 不返回；sensor_task.stats.overruns 记录超预算次数
+ * }
+ *
+ * 主机测试（Linux）：
+ *   gcc -DSCHED_PORT_POSIX -O2 -c task_scheduler_template.c
+ *   在测试程序中调用 sched_posix_bench(1000000) 获取单次调度开销
+ */
@@ -0,0 +1,515 @@
+/**
+ * @file thermal_model_template.c
+ * @brief 热模型与动态电流降额模板文件
+ * @description 绕组与功率级各用一个集总RC热网络（最多THERMAL_NODES_MAX个节点，首节点为热点，
+ *              末节点经热阻接参考温度：绕组接环境温度，功率级接散热器NTC实测温度）估计温升；
+ *              电流环每周期只累加一次电流平方，每THERMAL_WINDOW个周期发布一次窗口均值，
+ *              后台任务以窗口速率更新热网络：绕组按I²R（含铜电阻温度系数），
+ *              功率级按导通损耗与开关损耗；冷态允许峰值电流，热点接近限值时平滑降到持续电流，
+ *              持续电流由热网络稳态解出，保证长时间运行热点不超过限值；
+ *              通过motor_t.get_current_limit钩子接入电流环；
+ *              定义THERMAL_SIM_POSIX后提供周期负载仿真，对比固定持续电流限幅与动态降额
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include <math.h>
+
+/* ==================== 宏定义 ==================== */
+
+#define THERMAL_NODES_MAX          3       // 每个热网络最多节点数
+#define THERMAL_WINDOW             200     // 电流平方累加窗口（电流环周期数）
+#define THERMAL_T_REF_CU           25.0f   // 铜电阻参考温度（℃）
+
+// 快速RAM放置：定义USE_FAST_RAM并在链接脚本中包含fast_ram_sections.ld后，
+// 每周期调用的电流采样函数（热网络更新在后台任务，不放入）放入ITCM/CCM（段宏与fast_ram_template.c一致，启动拷贝见该文件）
+#ifndef FAST_RAM_CODE
+#ifdef USE_FAST_RAM
+#define FAST_RAM_CODE              __attribute__((section(".fast_text")))
+#else
+#define FAST_RAM_CODE
+#endif
+#endif
+
+/* ==================== 类型定义 ==================== */
+
+/**
+ * @brief 热模型错误码枚举
+ */
+typedef enum {
+    THERMAL_OK = 0,                /**< 成功 */
+    THERMAL_ERROR_NULL_PTR,        /**< 空指针错误 */
+    THERMAL_ERROR_INVALID_PARAM    /**< 无效参数（含更新步长超过最小时间常数的一半） */
+} thermal_error_t;
+
+/**
+ * @brief 热网络配置结构体
+ * @note  节点i经热阻r[i]连接节点i+1，末节点经r[node_num-1]连接参考温度；损耗注入节点0
+ */
+typedef struct {
+    uint8_t node_num;                      /**< 节点数（1~THERMAL_NODES_MAX） */
+    float c[THERMAL_NODES_MAX];            /**< 各节点热容（J/K） */
+    float r[THERMAL_NODES_MAX];            /**< 各节点到下一节点的热阻（K/W） */
+    float t_start;                         /**< 开始降额的热点温度（℃） */
+    float t_limit;                         /**< 热点温度限值（℃），达到时只允许持续电流 */
+} thermal_net_cfg_t;
+
+/**
+ * @brief 热网络结构体
+ */
+typedef struct {
+    thermal_net_cfg_t cfg;                 /**< 配置 */
+    float t[THERMAL_NODES_MAX];            /**< 各节点估计温度（℃） */
+    float r_total;                         /**< 热点到参考温度的总热阻（K/W） */
+    float power;                           /**< 最近一次窗口的损耗（W） */
+    float i_cont;                          /**< 按当前参考温度解出的持续电流（A） */
+    float i_limit;                         /**< 本网络允许的电流（A） */
+} thermal_net_t;
+
+/**
+ * @brief 热模型配置结构体
+ */
+typedef struct {
+    float fs;                              /**< 电流环频率（Hz） */
+    float i_peak;                          /**< 冷态峰值电流（A） */
+    float r_phase;                         /**< 相电阻（Ω，THERMAL_T_REF_CU时） */
+    float alpha_cu;                        /**< 铜电阻温度系数（1/K） */
+    float r_ds_on;                         /**< 功率管导通电阻（Ω，按结温上限取值） */
+    float e_sw;                            /**< 开关损耗系数（J/(V·A)，每PWM周期全桥合计） */
+    float f_pwm;                           /**< PWM频率（Hz） */
+    thermal_net_cfg_t winding;             /**< 绕组热网络 */
+    thermal_net_cfg_t stage;               /**< 功率级热网络 */
+} thermal_cfg_t;
+
+/**
+ * @brief 热模型统计结构体
+ */
+typedef struct {
+    uint32_t windows;                      /**< 已发布窗口数 */
+    uint32_t updates;                      /**< 后台更新次数 */
+    uint32_t missed;                       /**< 后台更新不及时跳过的窗口数 */
+} thermal_stats_t;
+
+/**
+ * @brief 热模型结构体
+ * @note  电流环写累加器并按窗口发布均值与序号，后台任务按序号差推进，两侧无锁
+ */
+typedef struct {
+    thermal_cfg_t cfg;                     /**< 配置 */
+    thermal_net_t winding;                 /**< 绕组热网络 */
+    thermal_net_t stage;                   /**< 功率级热网络 */
+    float dt;                              /**< 单个窗口时长（s） */
+
+    /* 电流环侧 */
+    float i_sq_acc;                        /**< 窗口内电流平方累加 */
+    uint16_t acc_count;                    /**< 窗口内已累加周期数 */
+    volatile float i_sq_mean;              /**< 最近一个窗口的电流平方均值（A²） */
+    atomic_uint_least32_t window_seq;      /**< 窗口发布序号 */
+
+    /* 后台任务侧 */
+    uint32_t seq_done;                     /**< 已处理的窗口序号 */
+    volatile float i_limit;                /**< 当前允许电流（A），电流环读取 */
+    thermal_stats_t stats;                 /**< 统计 */
+} thermal_model_t;
+
+/* ==================== 静态函数声明 ==================== */
+
+static thermal_error_t thermal_net_init(thermal_net_t *net, const thermal_net_cfg_t *cfg,
+                                        float t_init, float dt);
+static void thermal_net_step(thermal_net_t *net, float power, float t_ref, float dt);
+static void thermal_net_limit(thermal_net_t *net, float i_peak, float a, float b, float t_ref);
+
+/* ==================== 静态函数实现 ==================== */
+
+/**
+ * @brief 热网络初始化
+ * @param net    热网络指针
+ * @param cfg    配置
+ * @param t_init 初始温度（℃）
+ * @param dt     更新步长（s），须不超过最小节点时间常数的一半以保证显式积分稳定
+ * @return 错误码
+ */
+static thermal_error_t thermal_net_init(thermal_net_t *net, const thermal_net_cfg_t *cfg,
+                                        float t_init, float dt) {
+    uint8_t i;
+
+    if (cfg->node_num == 0 || cfg->node_num > THERMAL_NODES_MAX || cfg->t_limit <= cfg->t_start) {
+        return THERMAL_ERROR_INVALID_PARAM;
+    }
+
+    net->cfg = *cfg;
+    net->r_total = 0.0f;
+    for (i = 0; i < cfg->node_num; i++) {
+        if (cfg->c[i] <= 0.0f || cfg->r[i] <= 0.0f || dt > 0.5f * cfg->c[i] * cfg->r[i] ||
+            (i > 0 && dt > 0.5f * cfg->c[i] * cfg->r[i - 1])) {
+            return THERMAL_ERROR_INVALID_PARAM;
+        }
+        net->t[i] = t_init;
+        net->r_total += cfg->r[i];
+    }
+    net->power = 0.0f;
+    net->i_cont = 0.0f;
+    net->i_limit = 0.0f;
+
+    return THERMAL_OK;
+}
+
+/**
+ * @brief 热网络单步积分
+ * @param net   热网络指针
+ * @param power 注入热点的损耗（W）
+ * @param t_ref 参考温度（℃）
+ * @param dt    步长（s）
+ */
+static void thermal_net_step(thermal_net_t *net, float power, float t_ref, float dt) {
+    float q[THERMAL_NODES_MAX + 1];        // q[i]为流入节点i的热流
+    float t_next;
+    uint8_t n = net->cfg.node_num;
+    uint8_t i;
+
+    q[0] = power;
+    for (i = 0; i < n; i++) {
+        t_next = (i + 1 < n) ? net->t[i + 1] : t_ref;
+        q[i + 1] = (net->t[i] - t_next) / net->cfg.r[i];
+    }
+    for (i = 0; i < n; i++) {
+        net->t[i] += (q[i] - q[i + 1]) / net->cfg.c[i] * dt;
+    }
+    net->power = power;
+}
+
+/**
+ * @brief 计算热网络允许电流
+ * @param net    热网络指针
+ * @param i_peak 峰值电流（A）
+ * @param a      损耗二次项系数（W/A²，按限值温度取值）
+ * @param b      损耗一次项系数（W/A）
+ * @param t_ref  参考温度（℃）
+ * @note   持续电流由稳态a·I² + b·I = (t_limit - t_ref) / r_total解出；
+ *         热点在t_start以下允许峰值电流，t_start到t_limit之间线性降到持续电流
+ */
+static void thermal_net_limit(thermal_net_t *net, float i_peak, float a, float b, float t_ref) {
+    float p_max = (net->cfg.t_limit - t_ref) / net->r_total;
+    float x;
+
+    net->i_cont = (p_max > 0.0f) ? (sqrtf(b * b + 4.0f * a * p_max) - b) / (2.0f * a) : 0.0f;
+    if (net->i_cont > i_peak) {
+        net->i_cont = i_peak;
+    }
+
+    x = (net->cfg.t_limit - net->t[0]) / (net->cfg.t_limit - net->cfg.t_start);
+    if (x > 1.0f) x = 1.0f;
+    if (x < 0.0f) x = 0.0f;
+    net->i_limit = net->i_cont + (i_peak - net->i_cont) * x;
+}
+
+/* ==================== 公共函数实现 ==================== */
+
+/**
+ * @brief 热模型初始化函数
+ * @param tm     热模型指针
+ * @param cfg    配置
+ * @param t_init 全部节点的初始温度（℃），上电时取环境或散热器温度
+ * @return 错误码
+ */
+thermal_error_t thermal_model_init(thermal_model_t *tm, const thermal_cfg_t *cfg, float t_init) {
+    thermal_error_t ret;
+
+    // 检查指针有效性
+    if (tm == NULL || cfg == NULL) {
+        return THERMAL_ERROR_NULL_PTR;
+    }
+    if (cfg->fs <= 0.0f || cfg->i_peak <= 0.0f || cfg->r_phase <= 0.0f || cfg->r_ds_on <= 0.0f ||
+        cfg->alpha_cu <= 0.0f || cfg->e_sw <= 0.0f || cfg->f_pwm <= 0.0f) {
+        return THERMAL_ERROR_INVALID_PARAM;
+    }
+
+    tm->cfg = *cfg;
+    tm->dt = (float)THERMAL_WINDOW / cfg->fs;
+    ret = thermal_net_init(&tm->winding, &cfg->winding, t_init, tm->dt);
+    if (ret != THERMAL_OK) {
+        return ret;
+    }
+    ret = thermal_net_init(&tm->stage, &cfg->stage, t_init, tm->dt);
+    if (ret != THERMAL_OK) {
+        return ret;
+    }
+
+    tm->i_sq_acc = 0.0f;
+    tm->acc_count = 0;
+    tm->i_sq_mean = 0.0f;
+    atomic_store_explicit(&tm->window_seq, 0, memory_order_relaxed);
+    tm->seq_done = 0;
+    tm->i_limit = cfg->i_peak;
+    tm->stats = (thermal_stats_t){0};
+
+    return THERMAL_OK;
+}
+
+/**
+ * @brief 电流采样累加（电流环中断中调用）
+ * @param tm  热模型指针
+ * @param i_d 本周期D轴实测电流（A）
+ * @param i_q 本周期Q轴实测电流（A）
+ * @return 当前允许电流（A）
+ * @note   每周期一次乘加，每THERMAL_WINDOW个周期发布一次均值
+ */
+FAST_RAM_CODE
+float thermal_model_sample(thermal_model_t *tm, float i_d, float i_q) {
+    tm->i_sq_acc += i_d * i_d + i_q * i_q;
+    if (++tm->acc_count >= THERMAL_WINDOW) {
+        tm->i_sq_mean = tm->i_sq_acc * (1.0f / THERMAL_WINDOW);
+        tm->i_sq_acc = 0.0f;
+        tm->acc_count = 0;
+        atomic_fetch_add_explicit(&tm->window_seq, 1, memory_order_release);
+        tm->stats.windows++;
+    }
+    return tm->i_limit;
+}
+
+/**
+ * @brief 热模型更新（后台任务中周期调用，周期不长于一个窗口）
+ * @param tm         热模型指针
+ * @param v_bus      母线电压（V），用于开关损耗
+ * @param t_ambient  电机环境温度（℃），绕组热网络的参考温度
+ * @param t_heatsink 散热器实测温度（℃），功率级热网络的参考温度
+ * @return 更新后的允许电流（A）
+ * @note   调用不及时时按落后的窗口数补积分，电流取最近窗口均值；
+ *         绕组损耗1.5·R(T)·I²（I为DQ电流幅值），功率级损耗1.5·Rds·I² + e_sw·Vbus·I·f_pwm
+ */
+float thermal_model_update(thermal_model_t *tm, float v_bus, float t_ambient, float t_heatsink) {
+    const thermal_cfg_t *cfg = &tm->cfg;
+    uint32_t seq = atomic_load_explicit(&tm->window_seq, memory_order_acquire);
+    uint32_t n = seq - tm->seq_done;
+    float i_sq = tm->i_sq_mean;
+    float i_rms = sqrtf(i_sq);
+    float r_hot, p_w, p_s, b_s;
+
+    if (n == 0) {
+        return tm->i_limit;
+    }
+    if (n > 1) {
+        tm->stats.missed += n - 1;
+    }
+    tm->seq_done = seq;
+
+    b_s = cfg->e_sw * v_bus * cfg->f_pwm;
+    while (n-- > 0) {
+        r_hot = cfg->r_phase * (1.0f + cfg->alpha_cu * (tm->winding.t[0] - THERMAL_T_REF_CU));
+        p_w = 1.5f * r_hot * i_sq;
+        p_s = 1.5f * cfg->r_ds_on * i_sq + b_s * i_rms;
+        thermal_net_step(&tm->winding, p_w, t_ambient, tm->dt);
+        thermal_net_step(&tm->stage, p_s, t_heatsink, tm->dt);
+    }
+
+    // 持续电流按限值温度下的铜电阻计算
+    r_hot = cfg->r_phase * (1.0f + cfg->alpha_cu * (cfg->winding.t_limit - THERMAL_T_REF_CU));
+    thermal_net_limit(&tm->winding, cfg->i_peak, 1.5f * r_hot, 0.0f, t_ambient);
+    thermal_net_limit(&tm->stage, cfg->i_peak, 1.5f * cfg->r_ds_on, b_s, t_heatsink);
+
+    tm->i_limit = (tm->winding.i_limit < tm->stage.i_limit) ? tm->winding.i_limit : tm->stage.i_limit;
+    tm->stats.updates++;
+
+    return tm->i_limit;
+}
+
+/* ==================== 主机仿真 ==================== */
+
+#ifdef THERMAL_SIM_POSIX
+
+#define THERMAL_SIM_FS             20000.0f    // 电流环频率（Hz）
+#define THERMAL_SIM_T_AMB          40.0f       // 环境温度（℃）
+#define THERMAL_SIM_V_BUS          24.0f       // 母线电压（V）
+#define THERMAL_SIM_HS_C           60.0f       // 散热器热容（J/K）
+#define THERMAL_SIM_HS_R           6.0f        // 散热器到环境热阻（K/W）
+#define THERMAL_SIM_PLANT_MISMATCH 1.2f        // 失配工况下真实热阻相对模型的比例（模型偏乐观20%）
+#define THERMAL_SIM_SECONDS        1200        // 仿真时长（s）
+
+/**
+ * @brief 单次仿真结果结构体
+ */
+typedef struct {
+    float delivered;               /**< 实际输出电流积分与需求电流积分之比 */
+    float peak_ratio;              /**< 峰值需求段中实际电流达到需求95%的时间比例 */
+    float t_winding_max;           /**< 真实绕组热点最高温度（℃） */
+    float t_stage_max;             /**< 真实功率级结温最高值（℃） */
+    float winding_overshoot;       /**< 真实绕组热点最高温度超出限值的幅度（℃，负值表示未超出） */
+    float stage_overshoot;         /**< 真实功率级结温最高值超出限值的幅度（℃，负值表示未超出） */
+} thermal_sim_case_t;
+
+/**
+ * @brief 仿真结果结构体
+ */
+typedef struct {
+    float i_cont;                  /**< 模型解出的持续电流（A） */
+    thermal_sim_case_t fixed;      /**< 固定按持续电流限幅 */
+    thermal_sim_case_t dynamic;    /**< 热模型动态降额 */
+    thermal_sim_case_t mismatch;   /**< 热模型动态降额，真实热阻为模型的THERMAL_SIM_PLANT_MISMATCH倍 */
+} thermal_sim_result_t;
+
+/**
+ * @brief 负载需求：4秒峰值、6秒轻载循环，每5分钟穿插30秒重载
+ * @param t      时间（s）
+ * @param i_peak 峰值电流（A）
+ * @return 需求电流（A）
+ */
+static float thermal_sim_demand(float t, float i_peak) {
+    float phase = fmodf(t, 10.0f);
+    float slot = fmodf(t, 300.0f);
+
+    if (slot >= 200.0f && slot < 230.0f) {
+        return 0.9f * i_peak;
+    }
+    return (phase < 4.0f) ? i_peak : 0.2f * i_peak;
+}
+
+/**
+ * @brief 仿真一种限幅策略
+ * @param cfg       模型配置
+ * @param is_dynamic true使用热模型动态降额，false固定限幅为持续电流
+ * @param i_fixed   固定限幅值（A）
+ * @param plant_scale 真实热阻相对模型的比例（大于1表示模型偏乐观）
+ * @param out       结果输出
+ * @note   真实对象为热阻放大plant_scale倍的同构热网络，散热器为一阶节点；
+ *         电流环逐周期调用thermal_model_sample，后台任务每个窗口调用一次thermal_model_update
+ */
+static void thermal_sim_case(const thermal_cfg_t *cfg, bool is_dynamic, float i_fixed,
+                             float plant_scale, thermal_sim_case_t *out) {
+    static thermal_model_t tm;
+    thermal_net_cfg_t pw = cfg->winding, ps = cfg->stage;
+    thermal_net_t plant_w, plant_s;
+    float t_hs = THERMAL_SIM_T_AMB;
+    float i_lim = is_dynamic ? cfg->i_peak : i_fixed;
+    float demand, i, t, r_hot, p_s = 0.0f;
+    float sum_d = 0.0f, sum_i = 0.0f;
+    uint32_t peak_ticks = 0, peak_ok = 0;
+    uint32_t k, w;
+    uint32_t n = (uint32_t)(THERMAL_SIM_SECONDS * THERMAL_SIM_FS / THERMAL_WINDOW);
+    uint8_t j;
+
+    for (j = 0; j < THERMAL_NODES_MAX; j++) {
+        pw.r[j] *= plant_scale;
+        ps.r[j] *= plant_scale;
+    }
+    thermal_model_init(&tm, cfg, THERMAL_SIM_T_AMB);
+    thermal_net_init(&plant_w, &pw, THERMAL_SIM_T_AMB, tm.dt);
+    thermal_net_init(&plant_s, &ps, THERMAL_SIM_T_AMB, tm.dt);
+    *out = (thermal_sim_case_t){ .t_winding_max = THERMAL_SIM_T_AMB, .t_stage_max = THERMAL_SIM_T_AMB };
+
+    for (w = 0; w < n; w++) {
+        t = (float)w * tm.dt;
+        demand = thermal_sim_demand(t, cfg->i_peak);
+        i = (demand < i_lim) ? demand : i_lim;
+
+        // 电流环：窗口内电流恒定
+        for (k = 0; k < THERMAL_WINDOW; k++) {
+            i_lim = thermal_model_sample(&tm, 0.0f, i);
+        }
+        thermal_model_update(&tm, THERMAL_SIM_V_BUS, THERMAL_SIM_T_AMB, t_hs);
+        i_lim = is_dynamic ? tm.i_limit : i_fixed;
+
+        // 真实对象
+        r_hot = cfg->r_phase * (1.0f + cfg->alpha_cu * (plant_w.t[0] - THERMAL_T_REF_CU));
+        thermal_net_step(&plant_w, 1.5f * r_hot * i * i, THERMAL_SIM_T_AMB, tm.dt);
+        p_s = 1.5f * cfg->r_ds_on * i * i + cfg->e_sw * THERMAL_SIM_V_BUS * cfg->f_pwm * i;
+        thermal_net_step(&plant_s, p_s, t_hs, tm.dt);
+        t_hs += (p_s - (t_hs - THERMAL_SIM_T_AMB) / THERMAL_SIM_HS_R) / THERMAL_SIM_HS_C * tm.dt;
+
+        if (plant_w.t[0] > out->t_winding_max) out->t_winding_max = plant_w.t[0];
+        if (plant_s.t[0] > out->t_stage_max) out->t_stage_max = plant_s.t[0];
+        sum_d += demand;
+        sum_i += i;
+        if (demand >= cfg->i_peak) {
+            peak_ticks++;
+            if (i >= 0.95f * demand) {
+                peak_ok++;
+            }
+        }
+    }
+
+    out->delivered = sum_i / sum_d;
+    out->peak_ratio = (float)peak_ok / (float)peak_ticks;
+    out->winding_overshoot = out->t_winding_max - cfg->winding.t_limit;
+    out->stage_overshoot = out->t_stage_max - cfg->stage.t_limit;
+}
+
+/**
+ * @brief 热模型降额仿真
+ * @param result 结果输出指针
+ * @return 错误码
+ * @note   固定限幅取模型在环境温度下解出的持续电流，即不依赖热模型时可长期安全运行的保守值；
+ *         另以真实热阻为模型THERMAL_SIM_PLANT_MISMATCH倍的对象运行动态降额，
+ *         评估模型偏乐观时真实温度超出限值的幅度（默认参数下绕组热点约超出12℃，
+ *         热阻参数应按实测取保守值或下调t_limit留出余量）
+ */
+thermal_error_t thermal_sim_run(thermal_sim_result_t *result) {
+    static thermal_model_t probe;
+    const thermal_cfg_t cfg = {
+        .fs = THERMAL_SIM_FS, .i_peak = 10.0f,
+        .r_phase = 0.3f, .alpha_cu = 0.00393f,
+        .r_ds_on = 0.015f, .e_sw = 100.0e-9f, .f_pwm = 20000.0f,
+        .winding = { 3, { 15.0f, 150.0f, 400.0f }, { 1.0f, 1.5f, 0.5f }, 100.0f, 120.0f },
+        .stage = { 2, { 0.5f, 20.0f }, { 2.0f, 3.0f }, 105.0f, 125.0f },
+    };
+    uint16_t k;
+
+    if (result == NULL) {
+        return THERMAL_ERROR_NULL_PTR;
+    }
+    if (thermal_model_init(&probe, &cfg, THERMAL_SIM_T_AMB) != THERMAL_OK) {
+        return THERMAL_ERROR_INVALID_PARAM;
+    }
+
+    // 空载运行一个窗口，求出环境温度下的持续电流
+    for (k = 0; k < THERMAL_WINDOW; k++) {
+        thermal_model_sample(&probe, 0.0f, 0.0f);
+    }
+    thermal_model_update(&probe, THERMAL_SIM_V_BUS, THERMAL_SIM_T_AMB, THERMAL_SIM_T_AMB);
+    result->i_cont = (probe.winding.i_cont < probe.stage.i_cont) ? probe.winding.i_cont : probe.stage.i_cont;
+
+    thermal_sim_case(&cfg, false, result->i_cont, 1.0f, &result->fixed);
+    thermal_sim_case(&cfg, true, 0.0f, 1.0f, &result->dynamic);
+    thermal_sim_case(&cfg, true, 0.0f, THERMAL_SIM_PLANT_MISMATCH, &result->mismatch);
+
+    return THERMAL_OK;
+}
+
+#endif /* THERMAL_SIM_POSIX */
+
+/* ==================== 使用示例 ==================== */
+
+/*
+ * 使用示例：
+ *
+ * static thermal_model_t motor_thermal;
+ *
+ * // 电流环钩子：累加电流平方并返回当前允许电流
+ * static float motor_current_limit(float i_d, float i_q) {
+ *     return thermal_model_sample(&motor_thermal, i_d, i_q);
+ * }
+ *
+ * int main(void) {
+ *     const thermal_cfg_t cfg = {
+ *         .fs = 20000.0f, .i_peak = 10.0f, .r_phase = 0.3f, .alpha_cu = 0.00393f,
+ *         .r_ds_on = 0.015f, .e_sw = 100.0e-9f, .f_pwm = 20000.0f,
+ *         .winding = { 3, { 15.0f, 150.0f, 400.0f }, { 1.0f, 1.5f, 0.5f }, 100.0f, 120.0f },
+ *         .stage = { 2, { 0.5f, 20.0f }, { 2.0f, 3.0f }, 105.0f, 125.0f },
+ *     };
+ *     thermal_model_init(&motor_thermal, &cfg, foc_motor.get_temperature());
+ *     foc_motor.get_current_limit = motor_current_limit;
+ * }
+ *
+ * // 后台任务：每10ms（一个窗口）更新一次
+ * void thermal_task(void) {
+ *     thermal_model_update(&motor_thermal, foc_motor.get_bus_voltage(), 40.0f,
+ *                          foc_motor.get_temperature());
+ * }
+ *
+ * 主机仿真（Linux）：
+ *   gcc -std=c11 -O2 -DTHERMAL_SIM_POSIX thermal_model_template.c test_main.c -lm
+ *   thermal_sim_result_t r;
+ *   thermal_sim_run(&r);      // r.fixed.peak_ratio / r.dynamic.peak_ratio / r.dynamic.t_winding_max
+ *                             // r.mismatch.winding_overshoot：模型偏乐观20%时超出限值的温度
+ */
@@ -0,0 +1,342 @@
+/**
+ * @file vbus_limiter_template.c
+ * @brief 母线过压限制模板文件
+ * @description 减速时回馈能量使母线电压上升，驱动器无法向电源回灌时会触发过压跳闸；
+ *              本模块在电流环中对母线电压做PI调节，电压接近限值时先注入D轴电流
+ *              （只产生铜耗不产生转矩，在绕组中消耗回馈能量），仍不足时再按比例减小
+ *              回馈方向的Q轴电流，使电机以母线可承受的最大速率减速而不跳闸；
+ *              注入电流计入电流幅值预算，Q轴只使用√(i_max² - i_d²)，合成电流不超过i_max；
+ *              通过motor_t.limit_dq_ref钩子接入电流环；
+ *              定义VBUS_SIM_POSIX后提供减速仿真，对比不限制、仅限Q轴电流与D轴注入三种情况
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <math.h>
+
+/* ==================== 宏定义 ==================== */
+
+#define VBUS_LIMIT_INJECT_MAX      1.0f    // 调节量0~1对应D轴注入0~满幅
+#define VBUS_LIMIT_OUT_MAX         2.0f    // 调节量1~2对应回馈电流比例1~0
+
+// 快速RAM放置：定义USE_FAST_RAM并在链接脚本中包含fast_ram_sections.ld后，
+// 每周期调用的限制函数放入ITCM/CCM（段宏与fast_ram_template.c一致，启动拷贝见该文件）
+#ifndef FAST_RAM_CODE
+#ifdef USE_FAST_RAM
+#define FAST_RAM_CODE              __attribute__((section(".fast_text")))
+#else
+#define FAST_RAM_CODE
+#endif
+#endif
+
+/* ==================== 类型定义 ==================== */
+
+/**
+ * @brief 母线过压限制错误码枚举
+ */
+typedef enum {
+    VBUS_OK = 0,                   /**< 成功 */
+    VBUS_ERROR_NULL_PTR,           /**< 空指针错误 */
+    VBUS_ERROR_INVALID_PARAM       /**< 无效参数 */
+} vbus_error_t;
+
+/**
+ * @brief 母线过压限制配置结构体
+ */
+typedef struct {
+    float fs;                      /**< 调用频率（电流环频率，Hz） */
+    float v_ref;                   /**< 母线电压调节目标（V），应低于故障管理器的降额阈值 */
+    float kp;                      /**< 比例系数（每伏调节量） */
+    float ki;                      /**< 积分系数（每伏每秒调节量） */
+    float i_max;                   /**< 电流矢量幅值上限（A），与电机max_current一致 */
+    float i_d_inject;              /**< D轴注入电流幅值（A，不超过i_max），0表示仅限Q轴电流 */
+} vbus_limiter_cfg_t;
+
+/**
+ * @brief 母线过压限制统计结构体
+ */
+typedef struct {
+    uint32_t ticks;                /**< 调用次数 */
+    uint32_t limit_ticks;          /**< 限制生效的周期数 */
+    float v_peak;                  /**< 母线电压峰值（V） */
+} vbus_limiter_stats_t;
+
+/**
+ * @brief 母线过压限制结构体
+ */
+typedef struct {
+    vbus_limiter_cfg_t cfg;        /**< 配置 */
+    float integral;                /**< PI积分项 */
+    float out;                     /**< 调节量（0~VBUS_LIMIT_OUT_MAX） */
+    vbus_limiter_stats_t stats;    /**< 统计 */
+} vbus_limiter_t;
+
+/* ==================== 公共函数实现 ==================== */
+
+/**
+ * @brief 母线过压限制初始化函数
+ * @param lim 限制器指针
+ * @param cfg 配置
+ * @return 错误码
+ */
+vbus_error_t vbus_limiter_init(vbus_limiter_t *lim, const vbus_limiter_cfg_t *cfg) {
+    // 检查指针有效性
+    if (lim == NULL || cfg == NULL) {
+        return VBUS_ERROR_NULL_PTR;
+    }
+    if (cfg->fs <= 0.0f || cfg->v_ref <= 0.0f || cfg->kp < 0.0f || cfg->ki < 0.0f ||
+        cfg->i_max <= 0.0f || cfg->i_d_inject < 0.0f || cfg->i_d_inject > cfg->i_max) {
+        return VBUS_ERROR_INVALID_PARAM;
+    }
+
+    lim->cfg = *cfg;
+    lim->integral = 0.0f;
+    lim->out = 0.0f;
+    lim->stats = (vbus_limiter_stats_t){0};
+
+    return VBUS_OK;
+}
+
+/**
+ * @brief 母线过压限制（电流环中断中调用）
+ * @param lim     限制器指针
+ * @param v_bus   本周期母线电压（V）
+ * @param speed   转速（任意单位，仅用符号：与Q轴电流同号时为电动，异号时为回馈）
+ * @param i_d_ref D轴电流给定，输入输出
+ * @param i_q_ref Q轴电流给定，输入输出
+ * @return true表示本周期限制生效，速度环应暂停积分
+ * @note   调节量out由PI计算：0~1段D轴注入从0升到i_d_inject，1~2段回馈电流上限从剩余幅值降到0；
+ *         限制生效时D轴限幅到±i_max，Q轴限幅到√(i_max² - i_d²)，合成电流不超过i_max；
+ *         电压低于v_ref时积分回落，限制自动退出
+ */
+FAST_RAM_CODE
+bool vbus_limiter_apply(vbus_limiter_t *lim, float v_bus, float speed, float *i_d_ref,
+                        float *i_q_ref) {
+    float err = v_bus - lim->cfg.v_ref;
+    float i_max = lim->cfg.i_max;
+    float i_q_max;
+    float out;
+    bool is_regen = (*i_q_ref) * speed < 0.0f;
+
+    lim->stats.ticks++;
+    if (v_bus > lim->stats.v_peak) {
+        lim->stats.v_peak = v_bus;
+    }
+
+    // 积分限幅即输出范围，电压回落后积分直接退饱和
+    lim->integral += lim->cfg.ki * err / lim->cfg.fs;
+    if (lim->integral < 0.0f) lim->integral = 0.0f;
+    if (lim->integral > VBUS_LIMIT_OUT_MAX) lim->integral = VBUS_LIMIT_OUT_MAX;
+
+    out = lim->cfg.kp * err + lim->integral;
+    if (out < 0.0f) out = 0.0f;
+    if (out > VBUS_LIMIT_OUT_MAX) out = VBUS_LIMIT_OUT_MAX;
+    lim->out = out;
+
+    if (out <= 0.0f) {
+        return false;
+    }
+    lim->stats.limit_ticks++;
+
+    // 未配置注入时跳过注入段，直接限制回馈电流
+    if (lim->cfg.i_d_inject <= 0.0f) {
+        out += VBUS_LIMIT_INJECT_MAX;
+        if (out > VBUS_LIMIT_OUT_MAX) out = VBUS_LIMIT_OUT_MAX;
+    }
+
+    // D轴注入取负向（弱磁方向），不增加反电势
+    *i_d_ref -= ((out < VBUS_LIMIT_INJECT_MAX) ? out : VBUS_LIMIT_INJECT_MAX) * lim->cfg.i_d_inject;
+    if (*i_d_ref > i_max) *i_d_ref = i_max;
+    if (*i_d_ref < -i_max) *i_d_ref = -i_max;
+
+    // 注入电流计入幅值预算，Q轴只使用剩余部分；第二段再按比例收紧回馈方向
+    i_q_max = sqrtf(i_max * i_max - (*i_d_ref) * (*i_d_ref));
+    if (is_regen && out > VBUS_LIMIT_INJECT_MAX) {
+        i_q_max *= VBUS_LIMIT_OUT_MAX - out;
+    }
+    if (*i_q_ref > i_q_max) *i_q_ref = i_q_max;
+    if (*i_q_ref < -i_q_max) *i_q_ref = -i_q_max;
+
+    return true;
+}
+
+/* ==================== 主机仿真 ==================== */
+
+#ifdef VBUS_SIM_POSIX
+
+#define VBUS_SIM_FS                20000.0f    // 电流环频率（Hz）
+#define VBUS_SIM_SPEED_DIV         10          // 速度环分频
+#define VBUS_SIM_POLE_PAIRS        7.0f        // 极对数
+#define VBUS_SIM_FLUX              0.008f      // 永磁磁链（Wb）
+#define VBUS_SIM_RS                0.3f        // 相电阻（Ω）
+#define VBUS_SIM_J                 4.0e-4f     // 转动惯量（含负载，kg·m²）
+#define VBUS_SIM_B                 2.0e-5f     // 粘滞摩擦（N·m·s/rad）
+#define VBUS_SIM_I_MAX             10.0f       // 电流矢量幅值限幅（A），即max_current
+#define VBUS_SIM_I_OC_DERATE       13.5f       // 过流降额阈值（A），与故障管理器一致
+#define VBUS_SIM_I_OC_TRIP         15.0f       // 过流跳闸阈值（A），与故障管理器一致
+#define VBUS_SIM_CAP               1000.0e-6f  // 母线电容（F）
+#define VBUS_SIM_V_SUPPLY          24.0f       // 电源电压（V），电源只能输出不能吸收
+#define VBUS_SIM_R_SUPPLY          0.05f       // 电源内阻（Ω）
+#define VBUS_SIM_P_AUX             2.0f        // 母线上的辅助负载（W）
+#define VBUS_SIM_V_TRIP            30.0f       // 过压跳闸阈值（V），与故障管理器一致
+#define VBUS_SIM_W0                300.0f      // 初始机械转速（rad/s）
+#define VBUS_SIM_T_MAX             10.0f       // 单次仿真最长时间（s）
+
+/**
+ * @brief 单次减速结果结构体
+ */
+typedef struct {
+    float t_decel;                 /**< 转速降到初值1%以内的时间（s），跳闸或超时为负 */
+    float t_trip;                  /**< 过压或过流跳闸时刻（s），未跳闸为负 */
+    float v_peak;                  /**< 母线电压峰值（V） */
+    float i_peak;                  /**< 电流矢量幅值峰值（A） */
+    bool is_oc_derate;             /**< 电流幅值曾超过过流降额阈值 */
+} vbus_sim_case_t;
+
+/**
+ * @brief 仿真结果结构体
+ */
+typedef struct {
+    vbus_sim_case_t no_limit;      /**< 不限制 */
+    vbus_sim_case_t iq_only;       /**< 仅限回馈Q轴电流 */
+    vbus_sim_case_t inject;        /**< D轴注入 + 限回馈Q轴电流 */
+} vbus_sim_result_t;
+
+/**
+ * @brief 仿真一次全速急停
+ * @param lim 限制器指针，NULL表示不限制
+ * @param out 结果输出
+ * @note   理想电流环（电流等于给定），表贴电机；母线电容由电源经内阻充电，
+ *         电机电功率P = 1.5·(Rs·(i_d² + i_q²) + ω_e·ψ·i_q)，为负时回馈到母线；
+ *         给定经与电流环中断相同的矢量限幅，电流幅值按故障管理器的过流阈值判定降额与跳闸
+ */
+static void vbus_sim_decel(vbus_limiter_t *lim, vbus_sim_case_t *out) {
+    const float kt = 1.5f * VBUS_SIM_POLE_PAIRS * VBUS_SIM_FLUX;
+    const float kp_w = VBUS_SIM_J * 2.0f * 3.1415927f * 20.0f / kt;   // 速度环带宽20Hz
+    const float ki_w = kp_w * 2.0f * 3.1415927f * 5.0f;
+    const float dt = 1.0f / VBUS_SIM_FS;
+    float w = VBUS_SIM_W0, v_bus = VBUS_SIM_V_SUPPLY;
+    float integ = 0.0f, i_q_cmd = 0.0f;
+    float i_d, i_q, i_q_max, i_mag, err, p_motor, i_supply;
+    bool is_limited = false;
+    uint32_t k, n = (uint32_t)(VBUS_SIM_T_MAX * VBUS_SIM_FS);
+
+    *out = (vbus_sim_case_t){ .t_decel = -1.0f, .t_trip = -1.0f, .v_peak = v_bus };
+
+    for (k = 0; k < n; k++) {
+        // 速度环：目标转速0，限制生效时暂停积分
+        if (k % VBUS_SIM_SPEED_DIV == 0) {
+            err = 0.0f - w;
+            if (!is_limited) {
+                integ += ki_w * err * dt * VBUS_SIM_SPEED_DIV;
+                if (integ > VBUS_SIM_I_MAX) integ = VBUS_SIM_I_MAX;
+                if (integ < -VBUS_SIM_I_MAX) integ = -VBUS_SIM_I_MAX;
+            }
+            i_q_cmd = kp_w * err + integ;
+            if (i_q_cmd > VBUS_SIM_I_MAX) i_q_cmd = VBUS_SIM_I_MAX;
+            if (i_q_cmd < -VBUS_SIM_I_MAX) i_q_cmd = -VBUS_SIM_I_MAX;
+        }
+
+        // 电流环：母线电压限制
+        i_d = 0.0f;
+        i_q = i_q_cmd;
+        if (lim != NULL) {
+            is_limited = vbus_limiter_apply(lim, v_bus, w, &i_d, &i_q);
+        }
+        if (i_d > VBUS_SIM_I_MAX) i_d = VBUS_SIM_I_MAX;
+        if (i_d < -VBUS_SIM_I_MAX) i_d = -VBUS_SIM_I_MAX;
+        i_q_max = sqrtf(VBUS_SIM_I_MAX * VBUS_SIM_I_MAX - i_d * i_d);
+        if (i_q > i_q_max) i_q = i_q_max;
+        if (i_q < -i_q_max) i_q = -i_q_max;
+
+        // 机械与母线
+        p_motor = 1.5f * (VBUS_SIM_RS * (i_d * i_d + i_q * i_q) +
+                          VBUS_SIM_POLE_PAIRS * w * VBUS_SIM_FLUX * i_q);
+        i_supply = (VBUS_SIM_V_SUPPLY - v_bus) / VBUS_SIM_R_SUPPLY;
+        if (i_supply < 0.0f) i_supply = 0.0f;
+        v_bus += (i_supply - (p_motor + VBUS_SIM_P_AUX) / v_bus) / VBUS_SIM_CAP * dt;
+        w += (kt * i_q - VBUS_SIM_B * w) / VBUS_SIM_J * dt;
+
+        i_mag = sqrtf(i_d * i_d + i_q * i_q);
+        if (v_bus > out->v_peak) {
+            out->v_peak = v_bus;
+        }
+        if (i_mag > out->i_peak) {
+            out->i_peak = i_mag;
+        }
+        if (i_mag > VBUS_SIM_I_OC_DERATE) {
+            out->is_oc_derate = true;
+        }
+        if (v_bus > VBUS_SIM_V_TRIP || i_mag > VBUS_SIM_I_OC_TRIP) {
+            out->t_trip = (float)k * dt;
+            return;
+        }
+        if (fabsf(w) < 0.01f * VBUS_SIM_W0) {
+            out->t_decel = (float)k * dt;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief 母线过压限制仿真
+ * @param result 结果输出指针
+ * @return 错误码
+ * @note   300rad/s全速急停：不限制时回馈功率远超电容吸收能力，数毫秒内过压跳闸；
+ *         仅限Q轴电流时只能以铜耗和摩擦吸收能量，减速缓慢；
+ *         注入D轴电流后在绕组中额外消耗能量，回馈电流可以更大，减速时间显著缩短
+ */
+vbus_error_t vbus_sim_run(vbus_sim_result_t *result) {
+    static vbus_limiter_t lim;
+    vbus_limiter_cfg_t cfg = {
+        .fs = VBUS_SIM_FS, .v_ref = 27.0f, .kp = 2.0f, .ki = 500.0f,
+        .i_max = VBUS_SIM_I_MAX, .i_d_inject = 0.0f,
+    };
+
+    if (result == NULL) {
+        return VBUS_ERROR_NULL_PTR;
+    }
+
+    vbus_sim_decel(NULL, &result->no_limit);
+
+    vbus_limiter_init(&lim, &cfg);
+    vbus_sim_decel(&lim, &result->iq_only);
+
+    cfg.i_d_inject = VBUS_SIM_I_MAX;
+    vbus_limiter_init(&lim, &cfg);
+    vbus_sim_decel(&lim, &result->inject);
+
+    return VBUS_OK;
+}
+
+#endif /* VBUS_SIM_POSIX */
+
+/* ==================== 使用示例 ==================== */
+
+/*
+ * 使用示例：
+ *
+ * static vbus_limiter_t vbus_lim;
+ *
+ * // 电流环钩子：v_bus为驱动本周期的母线电压采样，speed为外环实测转速（RPM）；
+ * // 返回true时驱动暂停速度环积分
+ * static bool motor_limit_dq(float v_bus, float speed, float *i_d_ref, float *i_q_ref) {
+ *     return vbus_limiter_apply(&vbus_lim, v_bus, speed, i_d_ref, i_q_ref);
+ * }
+ *
+ * int main(void) {
+ *     const vbus_limiter_cfg_t cfg = {
+ *         .fs = 20000.0f, .v_ref = 27.0f, .kp = 2.0f, .ki = 500.0f,
+ *         .i_max = 10.0f, .i_d_inject = 10.0f,
+ *     };
+ *     vbus_limiter_init(&vbus_lim, &cfg);
+ *     motor_init(&foc_motor);
+ *     foc_motor.limit_dq_ref = motor_limit_dq;
+ * }
+ *
+ * 主机仿真（Linux）：
+ *   gcc -std=c11 -O2 -DVBUS_SIM_POSIX vbus_limiter_template.c test_main.c -lm
+ *   vbus_sim_result_t r;
+ *   vbus_sim_run(&r);         // r.no_limit.t_trip / r.iq_only.t_decel / r.inject.t_decel
+ */
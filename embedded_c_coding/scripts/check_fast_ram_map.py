@@ -0,0 +1,178 @@
+#!/usr/bin/env python3
+"""
+快速RAM放置检查工具
+解析GNU ld生成的map文件，确认电流环代码与查找表被放入ITCM/CCM/DTCM等快速RAM
+
+检查内容:
+  1. .fast_text 的运行地址位于代码快速RAM区域，加载地址位于该区域之外（需要启动拷贝）
+  2. .fast_data / .fast_bss 的运行地址位于数据快速RAM区域
+  3. 指定的热点函数符号位于 .fast_text 内
+
+用法:
+  python3 check_fast_ram_map.py build/firmware.map --code-region ITCMRAM --data-region DTCMRAM
+"""
+
+import argparse
+import re
+import sys
+from typing import Dict, List, Optional, Tuple
+
+# 默认要求放入快速RAM的全局符号（static函数不出现在map中，由段级检查覆盖）
+DEFAULT_SYMBOLS = [
+    "motor_current_loop_isr",
+    "motor_pwm_event_isr",
+    "motor_encoder_complete_isr",
+]
+
+FAST_CODE_SECTION = ".fast_text"
+FAST_DATA_SECTIONS = [".fast_data", ".fast_bss"]
+
+RE_REGION = re.compile(r"^(\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)")
+RE_OUTPUT = re.compile(r"^(\.\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)(?:\s+load address 0x([0-9a-fA-F]+))?")
+RE_OUTPUT_WRAP = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)(?:\s+load address 0x([0-9a-fA-F]+))?\s*$")
+RE_SYMBOL = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+([A-Za-z_][A-Za-z0-9_]*)\s*$")
+
+
+def parse_map(path: str) -> Tuple[Dict[str, Tuple[int, int]], Dict[str, Dict], Dict[str, Tuple[int, str]]]:
+    """
+    解析map文件
+
+    Returns:
+        (内存区域 {名称: (起始, 长度)},
+         输出段 {名称: {addr, size, lma}},
+         符号 {名称: (地址, 所在输出段)})
+    """
+    regions: Dict[str, Tuple[int, int]] = {}
+    sections: Dict[str, Dict] = {}
+    symbols: Dict[str, Tuple[int, str]] = {}
+
+    with open(path, "r", encoding="utf-8", errors="replace") as f:
+        lines = f.read().splitlines()
+
+    state = "start"
+    current: Optional[str] = None
+    pending: Optional[str] = None
+
+    for line in lines:
+        if line.startswith("Memory Configuration"):
+            state = "memory"
+            continue
+        if line.startswith("Linker script and memory map"):
+            state = "map"
+            continue
+
+        if state == "memory":
+            m = RE_REGION.match(line)
+            if m and m.group(1) not in ("Name", "*default*"):
+                regions[m.group(1)] = (int(m.group(2), 16), int(m.group(3), 16))
+            continue
+
+        if state != "map":
+            continue
+
+        # 输出段名过长时，地址与大小换行显示
+        if pending is not None:
+            m = RE_OUTPUT_WRAP.match(line)
+            if m:
+                addr, size = int(m.group(1), 16), int(m.group(2), 16)
+                lma = int(m.group(3), 16) if m.group(3) else addr
+                sections[pending] = {"addr": addr, "size": size, "lma": lma}
+                current = pending
+            pending = None
+            continue
+
+        if line.startswith("."):
+            m = RE_OUTPUT.match(line)
+            if m:
+                addr, size = int(m.group(2), 16), int(m.group(3), 16)
+                lma = int(m.group(4), 16) if m.group(4) else addr
+                sections[m.group(1)] = {"addr": addr, "size": size, "lma": lma}
+                current = m.group(1)
+            elif re.match(r"^\.\S+\s*$", line):
+                pending = line.strip()
+            continue
+
+        m = RE_SYMBOL.match(line)
+        if m and current is not None:
+            symbols.setdefault(m.group(2), (int(m.group(1), 16), current))
+
+    return regions, sections, symbols
+
+
+def in_region(addr: int, size: int, region: Tuple[int, int]) -> bool:
+    """判断 [addr, addr+size) 是否完全位于区域内"""
+    origin, length = region
+    return origin <= addr and addr + size <= origin + length
+
+
+def check(map_path: str, code_region: str, data_region: str, symbols: List[str],
+          allow_empty: bool) -> List[str]:
+    """执行全部检查，返回错误列表"""
+    regions, sections, syms = parse_map(map_path)
+    errors: List[str] = []
+
+    for name in (code_region, data_region):
+        if name not in regions:
+            errors.append(f"map文件中没有内存区域 {name}（现有: {', '.join(sorted(regions))}）")
+    if errors:
+        return errors
+
+    # 代码段
+    sec = sections.get(FAST_CODE_SECTION)
+    if sec is None:
+        errors.append(f"未找到输出段 {FAST_CODE_SECTION}，链接脚本是否包含 fast_ram_sections.ld")
+    else:
+        if sec["size"] == 0 and not allow_empty:
+            errors.append(f"{FAST_CODE_SECTION} 为空，是否定义了 USE_FAST_RAM")
+        if not in_region(sec["addr"], sec["size"], regions[code_region]):
+            errors.append(f"{FAST_CODE_SECTION} 运行地址 0x{sec['addr']:08x} 不在 {code_region} 内")
+        if in_region(sec["lma"], sec["size"], regions[code_region]):
+            errors.append(f"{FAST_CODE_SECTION} 加载地址 0x{sec['lma']:08x} 位于 {code_region} 内，掉电后内容丢失")
+
+    # 数据段
+    for name in FAST_DATA_SECTIONS:
+        sec = sections.get(name)
+        if sec is None:
+            errors.append(f"未找到输出段 {name}")
+        elif sec["size"] > 0 and not in_region(sec["addr"], sec["size"], regions[data_region]):
+            errors.append(f"{name} 运行地址 0x{sec['addr']:08x} 不在 {data_region} 内")
+
+    # 热点符号
+    for name in symbols:
+        if name not in syms:
+            errors.append(f"未找到符号 {name}")
+        elif syms[name][1] != FAST_CODE_SECTION:
+            errors.append(f"符号 {name} 位于 {syms[name][1]}（0x{syms[name][0]:08x}），应位于 {FAST_CODE_SECTION}")
+
+    return errors
+
+
+def main():
+    parser = argparse.ArgumentParser(description="快速RAM放置检查工具")
+    parser.add_argument("map", type=str, help="GNU ld map文件路径")
+    parser.add_argument("--code-region", type=str, default="ITCMRAM", help="代码快速RAM区域名")
+    parser.add_argument("--data-region", type=str, default="DTCMRAM", help="数据快速RAM区域名")
+    parser.add_argument("--symbol", type=str, action="append",
+                        help="要求位于 .fast_text 的符号（可重复，默认检查电流环中断入口）")
+    parser.add_argument("--allow-empty", action="store_true", help="允许 .fast_text 为空")
+
+    args = parser.parse_args()
+
+    symbols = args.symbol if args.symbol else DEFAULT_SYMBOLS
+    errors = check(args.map, args.code_region, args.data_region, symbols, args.allow_empty)
+
+    if errors:
+        print("快速RAM放置检查失败:")
+        for err in errors:
+            print(f"  - {err}")
+        sys.exit(1)
+
+    _, sections, _ = parse_map(args.map)
+    print("快速RAM放置检查通过:")
+    for name in [FAST_CODE_SECTION] + FAST_DATA_SECTIONS:
+        sec = sections[name]
+        print(f"  {name:<12} 0x{sec['addr']:08x}  {sec['size']:>6} 字节  加载地址 0x{sec['lma']:08x}")
+
+
+if __name__ == "__main__":
+    main()